@@ -23,6 +23,7 @@ public class MeshOperations : ModuleRules
                 "MeshDescription",
                 "StaticMeshDescription",
                 "MeshConversion",
+                "GeometryCore",
                 "ProceduralMeshComponent",
                 "GLTFExporter",
                 "UMG",
@@ -38,6 +39,7 @@ public class MeshOperations : ModuleRules
 				"Slate",
 				"SlateCore",
                 "UnrealEd",
+                "Json",
             });
 	}
 }
@@ -2,6 +2,20 @@
 
 #include "MeshOperationsBPLibrary.h"
 #include "MeshOperations.h"
+#include "MeshOps_BoundsCache.h"
+#include "MeshOps_TightBounds.h"
+#include "MeshOps_SpatialQueries.h"
+#include "MeshOps_SpatialIndex.h"
+#include "MeshOps_AssemblyCheck.h"
+#include "MeshOps_Instancing.h"
+#include "MeshOps_InstancedMeshComponent.h"
+#include "MeshOps_MeshBuilder.h"
+#include "MeshOps_MeshCache.h"
+#include "MeshOps_HierarchyOutline.h"
+#include "MeshOps_MeshMerge.h"
+#include "MeshOps_GLTFWriter.h"
+#include "MeshOps_ExportTask.h"
+#include "MeshOps_ImportTask.h"
 
 UMeshOperationsBPLibrary::UMeshOperationsBPLibrary(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -96,6 +110,11 @@ UStaticMeshComponent* UMeshOperationsBPLibrary::AddStaticMeshCompWithName(AActor
     StaticMeshComp->SetRelativeTransform(RelativeTransform);
     StaticMeshComp->RegisterComponent();
 
+    if (!Manual_Attachment)
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(StaticMeshComp->GetAttachParent());
+    }
+
     return StaticMeshComp;
 }
 
@@ -131,6 +150,12 @@ USceneComponent* UMeshOperationsBPLibrary::AddSceneCompWithName(AActor* Outer, F
     }
 
     SceneComp->SetRelativeTransform(RelativeTransform);
+
+    if (!Manual_Attachment)
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(SceneComp->GetAttachParent());
+    }
+
 	return SceneComp;
 }
 
@@ -170,6 +195,11 @@ UProceduralMeshComponent* UMeshOperationsBPLibrary::AddProcMeshCompWithName(AAct
     ProcMeshComp->SetRelativeTransform(Relative_Transform);
     ProcMeshComp->RegisterComponent();
 
+    if (!Manual_Attachment)
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(ProcMeshComp->GetAttachParent());
+    }
+
     return ProcMeshComp;
 }
 
@@ -330,7 +360,7 @@ bool UMeshOperationsBPLibrary::GenerateWave(bool bIsSin, double Amplitude, doubl
     return true;
 }
 
-UStaticMesh* UMeshOperationsBPLibrary::GSM_Description(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<int32>& TriangleMaterialSlots, int32 NumMaterialSlots, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing)
+UStaticMesh* UMeshOperationsBPLibrary::GSM_Description(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<int32>& TriangleMaterialSlots, int32 NumMaterialSlots, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing, bool bUseCache)
 {
     if (Vertices.IsEmpty())
     {
@@ -343,6 +373,18 @@ UStaticMesh* UMeshOperationsBPLibrary::GSM_Description(FName Mesh_Name, const TA
         return nullptr;
     }
 
+    uint64 CacheKey = 0;
+
+    if (bUseCache)
+    {
+        CacheKey = FMeshOps_MeshCache::MakeKey(TEXT("GSM_Description"), { FMeshOps_MeshCache::AsBytes(Vertices), FMeshOps_MeshCache::AsBytes(Indices), FMeshOps_MeshCache::AsBytes(TriangleMaterialSlots), TArrayView<const uint8>((const uint8*)&NumMaterialSlots, sizeof(int32)), FMeshOps_MeshCache::AsBytes(Normals), FMeshOps_MeshCache::AsBytes(Tangents), FMeshOps_MeshCache::AsBytes(UVs) });
+
+        if (UStaticMesh* CachedMesh = FMeshOps_MeshCache::Load(Mesh_Name, CacheKey, bSupportRayTracing))
+        {
+            return CachedMesh;
+        }
+    }
+
     const int32 NumTriangles = Indices.Num() / 3;
     const int32 EffectiveNumMaterialSlots = FMath::Max(NumMaterialSlots, 1);
 
@@ -384,7 +426,7 @@ UStaticMesh* UMeshOperationsBPLibrary::GSM_Description(FName Mesh_Name, const TA
 
     for (int32 MaterialSlotIndex = 0; MaterialSlotIndex < EffectiveNumMaterialSlots; ++MaterialSlotIndex)
     {
-        const FName MaterialSlotName(*FString::Printf(TEXT("MaterialSlot_%d"), MaterialSlotIndex));
+        const FName MaterialSlotName = FMeshOps_MeshBuilder::GetMaterialSlotName(MaterialSlotIndex);
 
         MaterialSlotNames.Add(MaterialSlotName);
         PolygonGroups.Add(MeshDescBuilder.AppendPolygonGroup(MaterialSlotName));
@@ -472,141 +514,84 @@ UStaticMesh* UMeshOperationsBPLibrary::GSM_Description(FName Mesh_Name, const TA
     StaticMesh->GetBodySetup()->InvalidatePhysicsData();
     StaticMesh->GetBodySetup()->CreatePhysicsMeshes();
 
+    if (bUseCache)
+    {
+        FMeshOps_MeshCache::Save(StaticMesh, CacheKey, FMeshOps_MeshBuilder::ECollisionType::ComplexAsSimple);
+    }
+
     return StaticMesh;
 }
 
-UStaticMesh* UMeshOperationsBPLibrary::GSM_RenderData(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing)
+UStaticMesh* UMeshOperationsBPLibrary::GSM_RenderData(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing, bool bUseCache)
 {
-    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(GetTransientPackage(), Mesh_Name.IsNone() ? NAME_None : Mesh_Name, RF_Public | RF_Standalone);
+    uint64 CacheKey = 0;
 
-    if (!StaticMesh)
+    if (bUseCache)
     {
-        return nullptr;
-    }
+        CacheKey = FMeshOps_MeshCache::MakeKey(TEXT("GSM_RenderData"), { FMeshOps_MeshCache::AsBytes(Vertices), FMeshOps_MeshCache::AsBytes(Indices), FMeshOps_MeshCache::AsBytes(Normals), FMeshOps_MeshCache::AsBytes(Tangents), FMeshOps_MeshCache::AsBytes(UVs) });
 
-    StaticMesh->bAllowCPUAccess = true;
-    StaticMesh->NeverStream = true;
-    StaticMesh->bSupportRayTracing = bSupportRayTracing;
-    StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, TEXT("DefaultMaterialSlot")));
-
-    StaticMesh->SetRenderData(MakeUnique<FStaticMeshRenderData>());
-    FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
-
-    if (!RenderData)
-    {
-        return nullptr;
+        if (UStaticMesh* CachedMesh = FMeshOps_MeshCache::Load(Mesh_Name, CacheKey, bSupportRayTracing))
+        {
+            return CachedMesh;
+        }
     }
 
-    const size_t NumElements = Indices.Num();
-	TArray<uint32> U_Indices;
-    U_Indices.SetNum(NumElements);
+    FMeshOps_MeshBuffers Buffers;
+    Buffers.Positions.SetNumUninitialized(Vertices.Num());
+    Buffers.Normals.SetNumUninitialized(Normals.Num());
+    Buffers.Tangents.SetNumUninitialized(Tangents.Num());
+    Buffers.UVs.SetNumUninitialized(UVs.Num());
+    Buffers.Indices.SetNumUninitialized(Indices.Num());
 
-    ParallelFor(NumElements, [&Indices, &U_Indices](int32 Index)
+    ParallelFor(Indices.Num(), [&Indices, &Buffers](int32 Index)
         {
-            U_Indices[Index] = static_cast<uint32>(Indices[Index]);
+            Buffers.Indices[Index] = static_cast<uint32>(Indices[Index]);
         }
     );
 
-    RenderData->AllocateLODResources(1);
-    FStaticMeshLODResources& LOD_Resource = RenderData->LODResources[0];
-
-	// This allows us to use more than 65535 vertices.
-    LOD_Resource.IndexBuffer.SetIndices(U_Indices, EIndexBufferStride::Force32Bit);
-
-    // --- POSITION VERTEX BUFFER ---
-  
-    const int32 NumPositions = Vertices.Num();
-    LOD_Resource.VertexBuffers.PositionVertexBuffer.Init(NumPositions);
-    
-    for (int32 PositionIndex = 0; PositionIndex < NumPositions; PositionIndex++)
+    for (int32 VertexIndex = 0; VertexIndex < Vertices.Num(); VertexIndex++)
     {
-        LOD_Resource.VertexBuffers.PositionVertexBuffer.VertexPosition(PositionIndex) = (FVector3f)Vertices[PositionIndex];
+        Buffers.Positions[VertexIndex] = (FVector3f)Vertices[VertexIndex];
     }
 
-	// --- COLOR VERTEX BUFFER ---
-    LOD_Resource.VertexBuffers.ColorVertexBuffer.InitFromSingleColor(FColor::White, NumPositions);
-
-    // --- STATIC MESH VERTEX BUFFER ---
-
-    uint32 NumVertices = Vertices.Num();
-    LOD_Resource.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
-    LOD_Resource.VertexBuffers.StaticMeshVertexBuffer.Init(NumVertices, 1);
-
-    for (uint32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+    for (int32 VertexIndex = 0; VertexIndex < Normals.Num(); VertexIndex++)
     {
-        // Use input tangents and normals.
-        FVector3f TangentF = (FVector3f)Tangents[VertexIndex];
-        FVector3f NormalF = (FVector3f)Normals[VertexIndex];
-        // Compute binormal (bitangent) from the cross product.
-        FVector3f BinormalF = (FVector3f)(FVector::CrossProduct(Normals[VertexIndex], Tangents[VertexIndex])).GetSafeNormal();
+        Buffers.Normals[VertexIndex] = (FVector3f)Normals[VertexIndex];
+    }
 
-        LOD_Resource.VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, TangentF, BinormalF, NormalF);
+    for (int32 VertexIndex = 0; VertexIndex < Tangents.Num(); VertexIndex++)
+    {
+        Buffers.Tangents[VertexIndex] = (FVector3f)Tangents[VertexIndex];
+    }
 
-        // Set the UV for channel 0.
-        LOD_Resource.VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(VertexIndex, 0, (FVector2f)UVs[VertexIndex]);
+    for (int32 VertexIndex = 0; VertexIndex < UVs.Num(); VertexIndex++)
+    {
+        Buffers.UVs[VertexIndex] = (FVector2f)UVs[VertexIndex];
     }
 
-    // --- MESH SECTIONS ---
-    
     // Create one section covering the entire mesh.
-    LOD_Resource.Sections.Empty();
-    FStaticMeshSection NewSection;
-    NewSection.FirstIndex = 0;
-    NewSection.NumTriangles = Indices.Num() / 3;
-    NewSection.MinVertexIndex = 0;
-    NewSection.MaxVertexIndex = Vertices.Num() - 1;
-    NewSection.MaterialIndex = 0;
-    LOD_Resource.Sections.Add(NewSection);
-
-    // --- BOUNDS ---
-    FBox BoundingBox(Vertices);
-    RenderData->Bounds = FBoxSphereBounds(BoundingBox);
-   
-#if RHI_RAYTRACING
-    if (StaticMesh->bSupportRayTracing)
+    Buffers.AddSingleSection();
+
+    UStaticMesh* StaticMesh = FMeshOps_MeshBuilder::BuildStaticMesh(Mesh_Name, MakeArrayView(&Buffers, 1), TArrayView<UMaterialInterface* const>(), FMeshOps_MeshBuilder::ECollisionType::BoxAndConvex, bSupportRayTracing);
+
+    if (bUseCache && StaticMesh)
     {
-        RenderData->InitializeRayTracingRepresentationFromRenderingLODs();
+        FMeshOps_MeshCache::Save(StaticMesh, CacheKey, FMeshOps_MeshBuilder::ECollisionType::BoxAndConvex);
     }
-#endif
-
-    // Finalize render data.
-    StaticMesh->InitResources();
-    StaticMesh->CalculateExtendedBounds();
-
-    // --- AGGREGATED COLLISION GEOMETRY (AggGeom) ---
-    UBodySetup* BodySetup = NewObject<UBodySetup>(StaticMesh, NAME_None, RF_Public | RF_Standalone);
-    StaticMesh->SetBodySetup(BodySetup);
-    BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
-	BodySetup->bHasCookedCollisionData = true;
-
-    // Clear any existing collision elements.
-    BodySetup->AggGeom.BoxElems.Empty();
-    BodySetup->AggGeom.SphereElems.Empty();
-    BodySetup->AggGeom.SphylElems.Empty();
-    BodySetup->AggGeom.ConvexElems.Empty();
-
-    // 1. Create a box collision element from the bounding box.
-    FKBoxElem BoxElem;
-    FVector BoxCenter = BoundingBox.GetCenter();
-    FVector BoxExtent = BoundingBox.GetExtent();
-    BoxElem.Center = BoxCenter;
-    BoxElem.X = BoxExtent.X * 2.0f;
-    BoxElem.Y = BoxExtent.Y * 2.0f;
-    BoxElem.Z = BoxExtent.Z * 2.0f;
-    BodySetup->AggGeom.BoxElems.Add(BoxElem);
-
-    // 2. Create a convex collision element using the input vertices.
-    FKConvexElem ConvexElem;
-    ConvexElem.VertexData = Vertices;
-    ConvexElem.UpdateElemBox();
-    BodySetup->AggGeom.ConvexElems.Add(ConvexElem);
-
-    BodySetup->InvalidatePhysicsData();
-    BodySetup->CreatePhysicsMeshes();
 
     return StaticMesh;
 }
 
+void UMeshOperationsBPLibrary::ResetGeneratedMeshCache()
+{
+    FMeshOps_MeshCache::Reset();
+}
+
+UStaticMesh* UMeshOperationsBPLibrary::MergeStaticMeshes(TArray<UStaticMeshComponent*>& Out_Merged, USceneComponent* AssetRoot, FName Mesh_Name, FMeshMergeOptionsStruct Options)
+{
+    return FMeshOps_MeshMerge::MergeSubtree(AssetRoot, Mesh_Name, Options, Out_Merged);
+}
+
 void UMeshOperationsBPLibrary::DeleteEmptyRoots(USceneComponent* AssetRoot)
 {
     // Initial while variable
@@ -649,6 +634,8 @@ void UMeshOperationsBPLibrary::DeleteEmptyRoots(USceneComponent* AssetRoot)
             ChildrenCount = AssetRoot->GetNumChildrenComponents();
         }
     }
+
+    UMeshOperationsBPLibrary::NotifyHierarchyChanged(AssetRoot);
 }
 
 void UMeshOperationsBPLibrary::DEP_LevelActors(AActor* TargetActor)
@@ -715,6 +702,7 @@ void UMeshOperationsBPLibrary::DEP_LevelActors(AActor* TargetActor)
             EachActor->AttachToActor(GrandParent, FAttachmentTransformRules::KeepWorldTransform);
             EachActor->SetActorLabel(NewMeshLabel);
             MiddleParentActor->Destroy();
+            UMeshOperationsBPLibrary::NotifyHierarchyChanged(GrandParent->GetRootComponent());
 
             TArray<AActor*> GrandParentChildren;
             GrandParent->GetAttachedActors(GrandParentChildren, true, false);
@@ -757,6 +745,7 @@ void UMeshOperationsBPLibrary::DEP_Components_Runtime(USceneComponent* AssetRoot
 
     bool IsProcessFinished = false;
     TMap<USceneComponent*, bool> AnyEmptyParentLeft;
+    TSet<USceneComponent*> Changed_Parents;
 
     while (!IsProcessFinished)
     {
@@ -784,6 +773,7 @@ void UMeshOperationsBPLibrary::DEP_Components_Runtime(USceneComponent* AssetRoot
             // Change target static mesh name.
             EachChild->AttachToComponent(GrandParent, FAttachmentTransformRules::KeepWorldTransform, NAME_None);
             EachChild->Rename(*New_SMC_Name, Owner);
+            Changed_Parents.Add(GrandParent);
 
             // Check if there is any empty parent left.
             if (EachChild->GetAttachParent()->GetNumChildrenComponents() == 1)
@@ -809,9 +799,38 @@ void UMeshOperationsBPLibrary::DEP_Components_Runtime(USceneComponent* AssetRoot
             IsProcessFinished = true;
         }
     }
+
+    for (USceneComponent* Each_Parent : Changed_Parents)
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(Each_Parent);
+    }
 }
 
-void UMeshOperationsBPLibrary::OptimizeCenter(USceneComponent* AssetRoot)
+bool UMeshOperationsBPLibrary::ExportHierarchyOutline(USceneComponent* AssetRoot, const FString& File_Path)
+{
+    FMeshOps_HierarchyOutline Outline;
+
+    if (!FMeshOps_HierarchyOutline::Build(AssetRoot, Outline))
+    {
+        return false;
+    }
+
+    return Outline.Save(File_Path);
+}
+
+FDelegateMeshOpsHierarchyChanged UMeshOperationsBPLibrary::OnHierarchyChanged;
+
+void UMeshOperationsBPLibrary::NotifyHierarchyChanged(USceneComponent* Changed_Parent)
+{
+    if (!IsValid(Changed_Parent))
+    {
+        return;
+    }
+
+    UMeshOperationsBPLibrary::OnHierarchyChanged.Broadcast(Changed_Parent);
+}
+
+void UMeshOperationsBPLibrary::OptimizeCenter(USceneComponent* AssetRoot, bool bUseTightBounds)
 {
     if (!IsValid(AssetRoot))
     {
@@ -819,7 +838,17 @@ void UMeshOperationsBPLibrary::OptimizeCenter(USceneComponent* AssetRoot)
     }
 
     FVector Origin, Extent;
-    AssetRoot->GetOwner()->GetActorBounds(true, Origin, Extent, true);
+
+    if (bUseTightBounds)
+    {
+        UMeshOperationsBPLibrary::GetSceneComponentTightBounds(Origin, Extent, AssetRoot);
+    }
+
+    else
+    {
+        AssetRoot->GetOwner()->GetActorBounds(true, Origin, Extent, true);
+    }
+
     const FVector ActorLocation = AssetRoot->GetOwner()->GetActorLocation();
     const FVector Offset = ActorLocation - Origin;
 
@@ -862,11 +891,20 @@ void UMeshOperationsBPLibrary::OptimizeCenter(USceneComponent* AssetRoot)
 #endif
 }
 
-void UMeshOperationsBPLibrary::OptimizeHeight(USceneComponent* AssetRoot, float Z_Offset)
+void UMeshOperationsBPLibrary::OptimizeHeight(USceneComponent* AssetRoot, float Z_Offset, bool bUseTightBounds)
 {
     FVector Origin;
     FVector BoxExtent;
-    AssetRoot->GetOwner()->GetActorBounds(false, Origin, BoxExtent, true);
+
+    if (bUseTightBounds)
+    {
+        UMeshOperationsBPLibrary::GetSceneComponentTightBounds(Origin, BoxExtent, AssetRoot);
+    }
+
+    else
+    {
+        AssetRoot->GetOwner()->GetActorBounds(false, Origin, BoxExtent, true);
+    }
 
     float NewHeight = BoxExtent.Z + Z_Offset;
     FVector NewLocation(0.f, 0.f, NewHeight);
@@ -914,26 +952,6 @@ bool UMeshOperationsBPLibrary::ExportLevelGLTF(FGLTFExportMessages& OutMessages,
         return false;
     }
 
-    TArray<FVector> Array_Locations;
-    TArray<FVector> Array_Scales;
-
-    for (AActor* Actor : TargetActors)
-    {
-		USceneComponent* RootComp = Actor->GetRootComponent();
-
-        if (Options.bResetLocation)
-        {
-            Array_Locations.Add(RootComp->GetComponentLocation());
-            RootComp->SetWorldLocation(FVector(0.0f), false, nullptr, ETeleportType::None);
-        }
-
-        if (Options.bResetScale)
-        {
-            Array_Scales.Add(RootComp->GetComponentScale());
-            RootComp->SetWorldScale3D(FVector(1.0f));
-        }
-    }
-
     UGLTFExportOptions* ExportOptions = NewObject<UGLTFExportOptions>();
     ExportOptions->ResetToDefault();
    
@@ -986,24 +1004,85 @@ bool UMeshOperationsBPLibrary::ExportLevelGLTF(FGLTFExportMessages& OutMessages,
     ExportOptions->bExportCameras = Options.bExportCameras;
     ExportOptions->ExportMaterialVariants = Options.ExportMaterialVariants;
 
-    const bool bIsExportSuccessful = UGLTFExporter::ExportToGLTF(CurrentWorld, ExportPath, ExportOptions, TargetActors, OutMessages);
+    if (!UGLTFExporter::ExportToGLTF(CurrentWorld, ExportPath, ExportOptions, TargetActors, OutMessages))
+    {
+        return false;
+    }
 
-    for (int32 ActorIndex = 0; ActorIndex < TargetActors.Num(); ActorIndex++)
+    // Reset location and scale are applied to root nodes of the written file, so actors aren't moved during export.
+    FString Error;
+
+    if (!FMeshOps_GLTFWriter::OverrideRootTransforms(ExportPath, Options.bResetLocation, Options.bResetScale, Error))
     {
-		USceneComponent* RootComp = TargetActors.Array()[ActorIndex]->GetRootComponent();
+        OutMessages.Errors.Add(Error);
+        return false;
+    }
 
-        if (Options.bResetLocation)
-        {
-            RootComp->SetWorldLocation(Array_Locations[ActorIndex], false, nullptr, ETeleportType::None);
-        }
+    return true;
+}
+
+UMeshOps_ExportTask* UMeshOperationsBPLibrary::ExportLevelGLTF_Async(FGLTFExportOptionsStruct Options, FString ExportPath, TSet<AActor*> TargetActors)
+{
+    FPaths::NormalizeFilename(ExportPath);
+
+    if (!FPaths::DirectoryExists(FPaths::GetPath(ExportPath)) || TargetActors.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    FGLTFExportJobStruct Job;
+    Job.Target_Actors = TargetActors.Array();
+    Job.Export_Path = ExportPath;
 
-        if (Options.bResetScale)
+    UMeshOps_ExportTask* ExportTask = NewObject<UMeshOps_ExportTask>();
+
+    if (!ExportTask->Start(MakeArrayView(&Job, 1), Options))
+    {
+        return nullptr;
+    }
+
+    return ExportTask;
+}
+
+UMeshOps_ExportTask* UMeshOperationsBPLibrary::ExportLevelGLTF_Batch(TArray<FGLTFExportJobStruct> Jobs, FGLTFExportOptionsStruct Options, int32 Max_Concurrent_Jobs)
+{
+    for (FGLTFExportJobStruct& Each_Job : Jobs)
+    {
+        FPaths::NormalizeFilename(Each_Job.Export_Path);
+
+        if (!FPaths::DirectoryExists(FPaths::GetPath(Each_Job.Export_Path)))
         {
-            RootComp->SetWorldScale3D(Array_Scales[ActorIndex]);
+            return nullptr;
         }
     }
 
-	return bIsExportSuccessful;
+    UMeshOps_ExportTask* ExportTask = NewObject<UMeshOps_ExportTask>();
+
+    if (!ExportTask->Start(Jobs, Options, Max_Concurrent_Jobs))
+    {
+        return nullptr;
+    }
+
+    return ExportTask;
+}
+
+UMeshOps_ImportTask* UMeshOperationsBPLibrary::ImportGLTF_Async(AActor* Target_Actor, FString ImportPath, FGLTFImportOptionsStruct Options)
+{
+    FPaths::NormalizeFilename(ImportPath);
+
+    if (!IsValid(Target_Actor) || !FPaths::FileExists(ImportPath))
+    {
+        return nullptr;
+    }
+
+    UMeshOps_ImportTask* ImportTask = NewObject<UMeshOps_ImportTask>();
+
+    if (!ImportTask->Start(Target_Actor, ImportPath, Options))
+    {
+        return nullptr;
+    }
+
+    return ImportTask;
 }
 
 bool UMeshOperationsBPLibrary::GetVerticesTransforms(TArray<FTransform>& Out_Transform, UStaticMeshComponent* In_SMC, int32 LOD_Index, bool bUseRelativeLocation)
@@ -1213,6 +1292,9 @@ bool UMeshOperationsBPLibrary::SetPivotLocation(UPARAM(ref) UStaticMeshComponent
 
 	In_SMC->SetStaticMesh(NewStaticMesh);
     In_SMC->AddWorldOffset(PivotLocation - In_SMC->Bounds.Origin);
+
+    // Offset doesn't update transform if pivot is already at the target location, but bounds changed with the new mesh anyway.
+    FMeshOps_BoundsCache::InvalidateContaining(In_SMC);
 	return true;
 }
 
@@ -1259,21 +1341,53 @@ void UMeshOperationsBPLibrary::GetSceneComponentBounds(FVector& Out_Origin, FVec
         return;
     }
 
-	TArray<USceneComponent*> Children;
-	SceneComponent->GetChildrenComponents(true, Children);
-
+    // Subtree boxes are cached per assembly and invalidated when components move, so repeated calls don't walk the hierarchy again.
     FBox TotalBox(ForceInit);
+    FMeshOps_BoundsCache::Get(SceneComponent)->GetDescendantsBounds(SceneComponent, TotalBox);
 
-    for (USceneComponent* Each_Child : Children)
+    Out_Origin = TotalBox.GetCenter();
+    Out_Extent = TotalBox.GetExtent();
+}
+
+void UMeshOperationsBPLibrary::GetSceneComponentTightBounds(FVector& Out_Origin, FVector& Out_Extent, USceneComponent* SceneComponent)
+{
+    FBox TightBox(ForceInit);
+
+    if (!FMeshOps_TightBounds::GetExactBounds(SceneComponent, TightBox))
     {
-        if (UPrimitiveComponent* Geometry = Cast<UPrimitiveComponent>(Each_Child))
-        {
-			TotalBox += Geometry->Bounds.GetBox();
-        }
+        Out_Extent = FVector::ZeroVector;
+        Out_Origin = FVector::ZeroVector;
+        return;
     }
 
-    Out_Origin = TotalBox.GetCenter();
-    Out_Extent = TotalBox.GetExtent();
+    Out_Origin = TightBox.GetCenter();
+    Out_Extent = TightBox.GetExtent();
+}
+
+bool UMeshOperationsBPLibrary::GetSceneComponentOrientedBounds(FOrientedBoxStruct& Out_Box, USceneComponent* SceneComponent)
+{
+    return FMeshOps_TightBounds::GetOrientedBounds(SceneComponent, Out_Box);
+}
+
+void UMeshOperationsBPLibrary::ResetMeshHullCache()
+{
+    FMeshOps_TightBounds::ResetCache();
+}
+
+void UMeshOperationsBPLibrary::ResetBoundsCache(USceneComponent* AssetRoot, bool bResetAll)
+{
+    if (bResetAll)
+    {
+        FMeshOps_BoundsCache::ResetAll();
+        return;
+    }
+
+    if (!IsValid(AssetRoot))
+    {
+        return;
+    }
+
+    FMeshOps_BoundsCache::Reset(AssetRoot);
 }
 
 bool UMeshOperationsBPLibrary::IsInBounds(USceneComponent* Target_Comp, FVector In_Origin, FVector In_Extent)
@@ -1289,64 +1403,217 @@ bool UMeshOperationsBPLibrary::IsInBounds(USceneComponent* Target_Comp, FVector
 	return MyBox.IsInside(ComponentLocation);
 }
 
+void UMeshOperationsBPLibrary::BulkIsInBounds(const TArray<FVector>& Points, FVector In_Origin, FVector In_Extent, TArray<int32>& Out_Inside, TArray<int32>& Out_Outside)
+{
+    TBitArray<> Inside;
+    FMeshOps_SpatialQueries::PointsInBox(Points, FBox::BuildAABB(In_Origin, In_Extent), Inside);
+    FMeshOps_SpatialQueries::BitsToIndices(Inside, true, Out_Inside);
+    FMeshOps_SpatialQueries::BitsToIndices(Inside, false, Out_Outside);
+}
+
+void UMeshOperationsBPLibrary::BulkIsInAnyBounds(const TArray<FVector>& Points, const TArray<FBox>& Bounds, TArray<int32>& Out_BoundsIndices)
+{
+    FMeshOps_SpatialQueries::PointsInBoxes(Points, Bounds, Out_BoundsIndices);
+}
+
+void UMeshOperationsBPLibrary::BulkBoxesInBounds(const TArray<FBox>& Boxes, FVector In_Origin, FVector In_Extent, bool bFullyInside, TArray<int32>& Out_Matching)
+{
+    TBitArray<> Matching;
+    FMeshOps_SpatialQueries::BoxesInBox(Boxes, FBox::BuildAABB(In_Origin, In_Extent), bFullyInside, Matching);
+    FMeshOps_SpatialQueries::BitsToIndices(Matching, true, Out_Matching);
+}
+
+void UMeshOperationsBPLibrary::BulkComponentsInBounds(const TArray<USceneComponent*>& Components, FVector In_Origin, FVector In_Extent, TArray<USceneComponent*>& Out_Inside, TArray<USceneComponent*>& Out_Outside)
+{
+    Out_Inside.Reset();
+    Out_Outside.Reset();
+
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(Components.Num());
+
+    for (int32 Index = 0; Index < Components.Num(); Index++)
+    {
+        Locations[Index] = IsValid(Components[Index]) ? Components[Index]->GetComponentLocation() : FVector::ZeroVector;
+    }
+
+    TBitArray<> Inside;
+    FMeshOps_SpatialQueries::PointsInBox(Locations, FBox::BuildAABB(In_Origin, In_Extent), Inside);
+
+    for (int32 Index = 0; Index < Components.Num(); Index++)
+    {
+        if (!IsValid(Components[Index]))
+        {
+            continue;
+        }
+
+        if (Inside[Index])
+        {
+            Out_Inside.Add(Components[Index]);
+        }
+
+        else
+        {
+            Out_Outside.Add(Components[Index]);
+        }
+    }
+}
+
+UMeshOps_SpatialIndex* UMeshOperationsBPLibrary::BuildSpatialIndex(USceneComponent* AssetRoot, bool bOnlyStaticMeshes, bool bAutoRefit)
+{
+    if (!IsValid(AssetRoot))
+    {
+        return nullptr;
+    }
+
+    UMeshOps_SpatialIndex* SpatialIndex = NewObject<UMeshOps_SpatialIndex>(AssetRoot);
+    SpatialIndex->Initialize(AssetRoot, bOnlyStaticMeshes, bAutoRefit);
+
+    return SpatialIndex;
+}
+
+int32 UMeshOperationsBPLibrary::ConvertToInstances(TArray<UMeshOps_InstancedMeshComponent*>& Out_Instanced, USceneComponent* AssetRoot, int32 MinInstances, bool bMatchGeometry)
+{
+    const int32 ReplacedCount = FMeshOps_Instancing::ConvertToInstances(AssetRoot, bMatchGeometry, MinInstances, Out_Instanced);
+
+    if (ReplacedCount > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Convert to Instances : %d components are replaced with %d instanced components."), ReplacedCount, Out_Instanced.Num());
+    }
+
+    return ReplacedCount;
+}
+
+void UMeshOperationsBPLibrary::ResetGeometryHashCache()
+{
+    FMeshOps_Instancing::ResetCache();
+}
+
 void UMeshOperationsBPLibrary::Check_Assembly(USceneComponent* Target_Root, bool bSpawnBillboardForOnlyProblems)
 {
+    TArray<FAssemblyCheckIssueStruct> Issues;
+    UMeshOperationsBPLibrary::Check_Assembly_Report(Issues, Target_Root, FAssemblyCheckOptionsStruct(), bSpawnBillboardForOnlyProblems);
+}
+
+void UMeshOperationsBPLibrary::Check_Assembly_Report(TArray<FAssemblyCheckIssueStruct>& Out_Issues, USceneComponent* Target_Root, FAssemblyCheckOptionsStruct Options, bool bSpawnBillboardForOnlyProblems)
+{
+    Out_Issues.Reset();
+
     if (!IsValid(Target_Root))
     {
         return;
     }
 
-	FVector Origin;
-	FVector Extent;
-    UMeshOperationsBPLibrary::GetSceneComponentBounds(Origin, Extent, Target_Root);
+    // Visualizers are reused, so calling check again doesn't stack components on the assembly. They are found by tag, because names are made unique in the owner.
+    const FName BoundsName = TEXT("Check_Assembly_Bounds");
+    const FName MarkersName = TEXT("Check_Assembly_Markers");
 
-	UBoxComponent* BoxComp = NewObject<UBoxComponent>(Target_Root->GetOuter());
-	BoxComp->SetMobility(EComponentMobility::Movable);
-	BoxComp->SetHiddenInGame(false);
-	BoxComp->SetLineThickness(10.0f);
-	BoxComp->SetWorldLocation(Origin);
-	BoxComp->SetBoxExtent(Extent);
-	BoxComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    BoxComp->AttachToComponent(Target_Root, FAttachmentTransformRules::KeepWorldTransform);
-	BoxComp->RegisterComponent();
+    UBoxComponent* BoxComp = nullptr;
+    UInstancedStaticMeshComponent* Markers = nullptr;
 
-	TArray<USceneComponent*> All_Components;
-	Target_Root->GetChildrenComponents(true, All_Components);
-	All_Components.Add(Target_Root);
+    for (USceneComponent* Each_Child : Target_Root->GetAttachChildren())
+    {
+        if (!IsValid(Each_Child))
+        {
+            continue;
+        }
 
-	auto BillboardCallback = [Target_Root](USceneComponent* Component, double Size = 0.25)
-		{
-            if (!IsValid(Component))
-            {
-                return;
-            }
+        if (!BoxComp && Each_Child->ComponentHasTag(BoundsName))
+        {
+            BoxComp = Cast<UBoxComponent>(Each_Child);
+        }
+
+        else if (!Markers && Each_Child->ComponentHasTag(MarkersName))
+        {
+            Markers = Cast<UInstancedStaticMeshComponent>(Each_Child);
+        }
+    }
 
-			UBillboardComponent* Billboard = NewObject<UBillboardComponent>(Component->GetOuter());
-			Billboard->SetMobility(EComponentMobility::Movable);
-			Billboard->SetHiddenInGame(false);
-			Billboard->SetWorldLocation(Component->GetComponentLocation());
-			Billboard->SetWorldScale3D(FVector(Size));
-			Billboard->AttachToComponent(Target_Root, FAttachmentTransformRules::KeepWorldTransform);
-			Billboard->RegisterComponent();
-		};
+    // Validators run in parallel on a snapshot, so they never touch live components.
+    USceneComponent* const Visualizers[] = { BoxComp, Markers };
 
-    for (USceneComponent* Each_Component : All_Components)
+    FMeshOps_AssemblyCheck::FSnapshot Snapshot;
+    FMeshOps_AssemblyCheck::MakeSnapshot(Target_Root, Visualizers, Snapshot);
+    FMeshOps_AssemblyCheck::Run(Snapshot, Options, Out_Issues);
+
+    const bool bIsVisualizerCreated = !BoxComp || !Markers;
+
+    if (!BoxComp)
     {
-		if (!UMeshOperationsBPLibrary::IsInBounds(Each_Component, Origin, Extent))
-        {
-			UE_LOG(LogTemp, Warning, TEXT("%s is out of bounds of the assembly."), *UMeshOperationsBPLibrary::GetObjectNameForPackage(Each_Component));
+        BoxComp = NewObject<UBoxComponent>(Target_Root->GetOuter(), MakeUniqueObjectName(Target_Root->GetOuter(), UBoxComponent::StaticClass(), BoundsName));
+        BoxComp->ComponentTags.Add(BoundsName);
+        BoxComp->SetMobility(EComponentMobility::Movable);
+        BoxComp->SetHiddenInGame(false);
+        BoxComp->SetLineThickness(10.0f);
+        BoxComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        BoxComp->AttachToComponent(Target_Root, FAttachmentTransformRules::KeepWorldTransform);
+        BoxComp->RegisterComponent();
+    }
 
-            if (bSpawnBillboardForOnlyProblems)
-            {
-                BillboardCallback(Each_Component, 2.0);
-            }
+	BoxComp->SetWorldLocation(Snapshot.Bounds.GetCenter());
+	BoxComp->SetBoxExtent(Snapshot.Bounds.GetExtent());
+
+    if (!Markers)
+    {
+        Markers = NewObject<UInstancedStaticMeshComponent>(Target_Root->GetOuter(), MakeUniqueObjectName(Target_Root->GetOuter(), UInstancedStaticMeshComponent::StaticClass(), MarkersName));
+        Markers->ComponentTags.Add(MarkersName);
+        Markers->SetMobility(EComponentMobility::Movable);
+        Markers->SetHiddenInGame(false);
+        Markers->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Markers->SetCastShadow(false);
+        Markers->SetCanEverAffectNavigation(false);
+        Markers->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere")));
+        Markers->AttachToComponent(Target_Root, FAttachmentTransformRules::KeepWorldTransform);
+        Markers->RegisterComponent();
+    }
+
+    if (bIsVisualizerCreated)
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(Target_Root);
+    }
+
+    Markers->ClearInstances();
+
+    // One instanced component draws all markers instead of registering a billboard per component.
+    TArray<FTransform> Marker_Transforms;
+    Marker_Transforms.Reserve(Out_Issues.Num() + (bSpawnBillboardForOnlyProblems ? 0 : Snapshot.Nodes.Num()));
+
+    TSet<USceneComponent*> Marked_Components;
+    TMap<EAssemblyCheckType, int32> Counts;
+
+    for (const FAssemblyCheckIssueStruct& Each_Issue : Out_Issues)
+    {
+        Counts.FindOrAdd(Each_Issue.Type)++;
+
+        const ELogVerbosity::Type Verbosity = Each_Issue.Severity == EAssemblyCheckSeverity::Info ? ELogVerbosity::Log : (Each_Issue.Severity == EAssemblyCheckSeverity::Warning ? ELogVerbosity::Warning : ELogVerbosity::Error);
+        GLog->Log(LogTemp.GetCategoryName(), Verbosity, FString::Printf(TEXT("%s : %s"), *FMeshOps_AssemblyCheck::GetCheckName(Each_Issue.Type), *Each_Issue.Message));
+
+        bool bIsAlreadyMarked = false;
+        Marked_Components.Add(Each_Issue.Component, &bIsAlreadyMarked);
+
+        if (!bIsAlreadyMarked)
+        {
+            Marker_Transforms.Add(FTransform(FQuat::Identity, Each_Issue.Location, FVector(2.0)));
         }
+    }
 
-        if (!bSpawnBillboardForOnlyProblems)
+    if (!bSpawnBillboardForOnlyProblems)
+    {
+        for (const FMeshOps_AssemblyCheck::FNode& Each_Node : Snapshot.Nodes)
         {
-			BillboardCallback(Each_Component);
+            Marker_Transforms.Add(FTransform(FQuat::Identity, Each_Node.Transform.GetLocation(), FVector(0.25)));
         }
     }
+
+    Markers->AddInstances(Marker_Transforms, false, true);
+
+    FString Summary;
+
+    for (const TPair<EAssemblyCheckType, int32>& Each_Count : Counts)
+    {
+        Summary += FString::Printf(TEXT(" %s = %d"), *FMeshOps_AssemblyCheck::GetCheckName(Each_Count.Key), Each_Count.Value);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Check Assembly : %d issues in %d components.%s"), Out_Issues.Num(), Snapshot.Nodes.Num(), *Summary);
 }
 
 bool UMeshOperationsBPLibrary::ChangeMaterialInstanceParent(UMaterialInstanceDynamic* MaterialInstance, UMaterialInterface* NewParent)
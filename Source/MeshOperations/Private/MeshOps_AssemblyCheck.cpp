@@ -0,0 +1,456 @@
+#include "MeshOps_AssemblyCheck.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_SpatialQueries.h"
+
+// Triangles with smaller squared cross product are counted as zero area.
+#define ASSEMBLY_CHECK_DEGENERATE_AREA 1.0e-12
+#define ASSEMBLY_CHECK_FLAT_EXTENT 0.0001
+
+namespace MeshOps_AssemblyCheck_Private
+{
+    typedef FMeshOps_AssemblyCheck::FNode FNode;
+    typedef FMeshOps_AssemblyCheck::FSnapshot FSnapshot;
+
+    struct FMeshInfo
+    {
+        bool bHasRenderData = false;
+        int32 NumTriangles = 0;
+        FBox LocalBounds = FBox(ForceInit);
+
+        // Negative if CPU index or vertex data isn't available.
+        double DegenerateRatio = -1;
+    };
+
+    static FAssemblyCheckIssueStruct MakeIssue(EAssemblyCheckType Type, EAssemblyCheckSeverity Severity, const FNode& Node, const FString& Detail)
+    {
+        FAssemblyCheckIssueStruct Issue;
+        Issue.Type = Type;
+        Issue.Severity = Severity;
+        Issue.Component = Node.Component;
+        Issue.Location = Node.Transform.GetLocation();
+        Issue.Message = Detail;
+
+        return Issue;
+    }
+
+    static FMeshInfo GetMeshInfo(const UStaticMesh* StaticMesh)
+    {
+        FMeshInfo MeshInfo;
+        const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+
+        if (!RenderData || RenderData->LODResources.IsEmpty())
+        {
+            return MeshInfo;
+        }
+
+        const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+
+        MeshInfo.bHasRenderData = true;
+        MeshInfo.NumTriangles = LOD.GetNumTriangles();
+        MeshInfo.LocalBounds = RenderData->Bounds.GetBox();
+
+        // Packaged builds discard CPU copies of mesh buffers unless mesh allows CPU access.
+        const bool bHasCPUData = WITH_EDITOR || StaticMesh->bAllowCPUAccess;
+        const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+
+        if (!bHasCPUData || !Positions.GetVertexData() || MeshInfo.NumTriangles == 0)
+        {
+            return MeshInfo;
+        }
+
+        const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+
+        if (Indices.Num() == 0)
+        {
+            return MeshInfo;
+        }
+
+        int32 NumChecked = 0;
+        int32 NumDegenerate = 0;
+
+        for (const FStaticMeshSection& Each_Section : LOD.Sections)
+        {
+            for (uint32 Triangle = 0; Triangle < Each_Section.NumTriangles; Triangle++)
+            {
+                const uint32 First = Each_Section.FirstIndex + Triangle * 3;
+
+                const FVector3f& A = Positions.VertexPosition(Indices[First]);
+                const FVector3f& B = Positions.VertexPosition(Indices[First + 1]);
+                const FVector3f& C = Positions.VertexPosition(Indices[First + 2]);
+
+                if (((B - A) ^ (C - A)).SizeSquared() < ASSEMBLY_CHECK_DEGENERATE_AREA)
+                {
+                    NumDegenerate++;
+                }
+
+                NumChecked++;
+            }
+        }
+
+        if (NumChecked > 0)
+        {
+            MeshInfo.DegenerateRatio = (double)NumDegenerate / NumChecked;
+        }
+
+        return MeshInfo;
+    }
+
+    static void Check_OutOfBounds(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        TArray<FVector> Locations;
+        Locations.SetNumUninitialized(Snapshot.Nodes.Num());
+
+        for (int32 Index = 0; Index < Snapshot.Nodes.Num(); Index++)
+        {
+            Locations[Index] = Snapshot.Nodes[Index].Transform.GetLocation();
+        }
+
+        TBitArray<> Inside;
+        FMeshOps_SpatialQueries::PointsInBox(Locations, Snapshot.Bounds, Inside);
+
+        for (int32 Index = 0; Index < Snapshot.Nodes.Num(); Index++)
+        {
+            if (!Inside[Index])
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::OutOfBounds, EAssemblyCheckSeverity::Warning, Snapshot.Nodes[Index], TEXT("is out of bounds of the assembly.")));
+            }
+        }
+    }
+
+    static void Check_ZeroScale(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        for (const FNode& Each_Node : Snapshot.Nodes)
+        {
+            const FVector Scale = Each_Node.Transform.GetScale3D();
+
+            if (Scale.GetAbsMin() <= Options.ZeroScaleTolerance)
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::ZeroScale, EAssemblyCheckSeverity::Error, Each_Node, FString::Printf(TEXT("has zero world scale %s."), *Scale.ToString())));
+            }
+        }
+    }
+
+    static void Check_Meshes(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        TMap<const UStaticMesh*, int32> MeshIndices;
+        TArray<const UStaticMesh*> UniqueMeshes;
+
+        for (const FNode& Each_Node : Snapshot.Nodes)
+        {
+            if (Each_Node.StaticMesh && !MeshIndices.Contains(Each_Node.StaticMesh))
+            {
+                MeshIndices.Add(Each_Node.StaticMesh, UniqueMeshes.Add(Each_Node.StaticMesh));
+            }
+        }
+
+        // Each unique mesh is inspected once, no matter how many components use it.
+        TArray<FMeshInfo> MeshInfos;
+        MeshInfos.SetNum(UniqueMeshes.Num());
+
+        ParallelFor(UniqueMeshes.Num(), [&UniqueMeshes, &MeshInfos](int32 MeshIndex)
+            {
+                MeshInfos[MeshIndex] = GetMeshInfo(UniqueMeshes[MeshIndex]);
+            });
+
+        for (const FNode& Each_Node : Snapshot.Nodes)
+        {
+            if (!Each_Node.bIsStaticMeshComponent)
+            {
+                continue;
+            }
+
+            if (!Each_Node.StaticMesh)
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::EmptyMesh, EAssemblyCheckSeverity::Error, Each_Node, TEXT("doesn't have a static mesh.")));
+                continue;
+            }
+
+            const FMeshInfo& MeshInfo = MeshInfos[MeshIndices[Each_Node.StaticMesh]];
+            const FString MeshName = Each_Node.StaticMesh->GetName();
+
+            if (!MeshInfo.bHasRenderData || MeshInfo.NumTriangles == 0)
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::EmptyMesh, EAssemblyCheckSeverity::Error, Each_Node, FString::Printf(TEXT("uses %s which doesn't have any triangles."), *MeshName)));
+                continue;
+            }
+
+            const FVector Extent = MeshInfo.LocalBounds.GetExtent();
+            const int32 NumFlatAxes = (Extent.X <= ASSEMBLY_CHECK_FLAT_EXTENT) + (Extent.Y <= ASSEMBLY_CHECK_FLAT_EXTENT) + (Extent.Z <= ASSEMBLY_CHECK_FLAT_EXTENT);
+
+            if (NumFlatAxes >= 2)
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::DegenerateMesh, EAssemblyCheckSeverity::Warning, Each_Node, FString::Printf(TEXT("uses %s which is flat in %d axes."), *MeshName, NumFlatAxes)));
+            }
+
+            else if (MeshInfo.DegenerateRatio >= Options.DegenerateTriangleRatio)
+            {
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::DegenerateMesh, EAssemblyCheckSeverity::Warning, Each_Node, FString::Printf(TEXT("uses %s which has %.0f%% zero area triangles."), *MeshName, MeshInfo.DegenerateRatio * 100)));
+            }
+        }
+    }
+
+    static void Check_Duplicates(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        // Components are hashed to a grid with tolerance sized cells per mesh, so each component is only compared with neighbour cells.
+        typedef TTuple<const UStaticMesh*, int64, int64, int64> FCellKey;
+
+        const double CellSize = FMath::Max(Options.DuplicateTolerance, UE_KINDA_SMALL_NUMBER);
+        TMap<FCellKey, TArray<int32>> Cells;
+
+        for (int32 Index = 0; Index < Snapshot.Nodes.Num(); Index++)
+        {
+            const FNode& Node = Snapshot.Nodes[Index];
+
+            if (!Node.StaticMesh)
+            {
+                continue;
+            }
+
+            const FVector Location = Node.Transform.GetLocation();
+            const int64 Cell_X = FMath::FloorToInt64(Location.X / CellSize);
+            const int64 Cell_Y = FMath::FloorToInt64(Location.Y / CellSize);
+            const int64 Cell_Z = FMath::FloorToInt64(Location.Z / CellSize);
+
+            int32 Original = INDEX_NONE;
+
+            for (int64 X = Cell_X - 1; X <= Cell_X + 1 && Original == INDEX_NONE; X++)
+            {
+                for (int64 Y = Cell_Y - 1; Y <= Cell_Y + 1 && Original == INDEX_NONE; Y++)
+                {
+                    for (int64 Z = Cell_Z - 1; Z <= Cell_Z + 1 && Original == INDEX_NONE; Z++)
+                    {
+                        const TArray<int32>* Candidates = Cells.Find(FCellKey(Node.StaticMesh, X, Y, Z));
+
+                        if (!Candidates)
+                        {
+                            continue;
+                        }
+
+                        for (const int32 Each_Candidate : *Candidates)
+                        {
+                            const FTransform& Other = Snapshot.Nodes[Each_Candidate].Transform;
+
+                            if (FVector::Dist(Location, Other.GetLocation()) <= Options.DuplicateTolerance && Node.Transform.GetRotation().Equals(Other.GetRotation(), UE_KINDA_SMALL_NUMBER) && Node.Transform.GetScale3D().Equals(Other.GetScale3D(), UE_KINDA_SMALL_NUMBER))
+                            {
+                                Original = Each_Candidate;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (Original == INDEX_NONE)
+            {
+                Cells.FindOrAdd(FCellKey(Node.StaticMesh, Cell_X, Cell_Y, Cell_Z)).Add(Index);
+                continue;
+            }
+
+            FAssemblyCheckIssueStruct Issue = MakeIssue(EAssemblyCheckType::DuplicateInstance, EAssemblyCheckSeverity::Warning, Node, FString::Printf(TEXT("overlaps another instance of %s with the same transform."), *Node.StaticMesh->GetName()));
+            Issue.Related_Component = Snapshot.Nodes[Original].Component;
+            Out_Issues.Add(Issue);
+        }
+    }
+
+    static void Check_MissingTags(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        // Root is usually created by user, not by importer.
+        for (int32 Index = 1; Index < Snapshot.Nodes.Num(); Index++)
+        {
+            const FNode& Node = Snapshot.Nodes[Index];
+            const bool bHasProduct = Node.Product_Tag.ToString().Contains(FIELD_PRODUCT);
+            const bool bHasInstance = Node.Instance_Tag.ToString().Contains(FIELD_INSTANCE);
+
+            if (!bHasProduct || !bHasInstance)
+            {
+                const FString Missing = !bHasProduct && !bHasInstance ? FString(TEXT("product and instance tags")) : (!bHasProduct ? FString(TEXT("product tag")) : FString(TEXT("instance tag")));
+                Out_Issues.Add(MakeIssue(EAssemblyCheckType::MissingTags, EAssemblyCheckSeverity::Warning, Node, FString::Printf(TEXT("doesn't have %s."), *Missing)));
+            }
+        }
+    }
+
+    static void Check_SingleChildChains(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+    {
+        // Children come after their parents, so reverse order visits each child before its parent.
+        TArray<int32> ChainLengths;
+        ChainLengths.SetNumZeroed(Snapshot.Nodes.Num());
+
+        for (int32 Index = Snapshot.Nodes.Num() - 1; Index >= 0; Index--)
+        {
+            const FNode& Node = Snapshot.Nodes[Index];
+
+            if (Node.OnlyChild != INDEX_NONE)
+            {
+                ChainLengths[Index] = 1 + ChainLengths[Node.OnlyChild];
+            }
+        }
+
+        for (int32 Index = 0; Index < Snapshot.Nodes.Num(); Index++)
+        {
+            const FNode& Node = Snapshot.Nodes[Index];
+            const bool bIsHead = Node.Parent == INDEX_NONE || Snapshot.Nodes[Node.Parent].OnlyChild == INDEX_NONE;
+
+            if (!bIsHead || ChainLengths[Index] <= Options.MaxSingleChildChain)
+            {
+                continue;
+            }
+
+            int32 Last = Index;
+
+            while (Snapshot.Nodes[Last].OnlyChild != INDEX_NONE)
+            {
+                Last = Snapshot.Nodes[Last].OnlyChild;
+            }
+
+            FAssemblyCheckIssueStruct Issue = MakeIssue(EAssemblyCheckType::SingleChildChain, EAssemblyCheckSeverity::Info, Node, FString::Printf(TEXT("starts a chain of %d components with a single child."), ChainLengths[Index]));
+            Issue.Related_Component = Snapshot.Nodes[Last].Component;
+            Out_Issues.Add(Issue);
+        }
+    }
+}
+
+void FMeshOps_AssemblyCheck::MakeSnapshot(USceneComponent* Target_Root, TArrayView<USceneComponent* const> Ignored, FSnapshot& Out_Snapshot)
+{
+    Out_Snapshot.Nodes.Reset();
+    Out_Snapshot.Bounds.Init();
+
+    if (!IsValid(Target_Root))
+    {
+        return;
+    }
+
+    FNode& Root = Out_Snapshot.Nodes.AddDefaulted_GetRef();
+    Root.Component = Target_Root;
+
+    for (int32 Index = 0; Index < Out_Snapshot.Nodes.Num(); Index++)
+    {
+        USceneComponent* Component = Out_Snapshot.Nodes[Index].Component;
+
+        {
+            FNode& Node = Out_Snapshot.Nodes[Index];
+            Node.Transform = Component->GetComponentTransform();
+
+            // Bounds are summed from visited nodes instead of the bounds cache, so ignored components like check visualizers don't grow them. Root itself isn't included, same as GetSceneComponentBounds.
+            if (Index > 0)
+            {
+                if (const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+                {
+                    Out_Snapshot.Bounds += Primitive->Bounds.GetBox();
+                }
+            }
+
+            if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+            {
+                Node.bIsStaticMeshComponent = true;
+                Node.StaticMesh = StaticMeshComp->GetStaticMesh();
+            }
+
+            if (Component->ComponentTags.Num() > 0)
+            {
+                Node.Product_Tag = Component->ComponentTags[0];
+            }
+
+            if (Component->ComponentTags.Num() > 1)
+            {
+                Node.Instance_Tag = Component->ComponentTags[1];
+            }
+        }
+
+        int32 NumChildren = 0;
+        int32 LastChild = INDEX_NONE;
+
+        for (USceneComponent* Each_Child : Component->GetAttachChildren())
+        {
+            if (!IsValid(Each_Child) || Ignored.Contains(Each_Child))
+            {
+                continue;
+            }
+
+            FNode& Child = Out_Snapshot.Nodes.AddDefaulted_GetRef();
+            Child.Component = Each_Child;
+            Child.Parent = Index;
+
+            LastChild = Out_Snapshot.Nodes.Num() - 1;
+            NumChildren++;
+        }
+
+        // Adding children can reallocate the array, so node is accessed again.
+        Out_Snapshot.Nodes[Index].NumChildren = NumChildren;
+        Out_Snapshot.Nodes[Index].OnlyChild = NumChildren == 1 ? LastChild : INDEX_NONE;
+    }
+}
+
+void FMeshOps_AssemblyCheck::Run(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues)
+{
+    using namespace MeshOps_AssemblyCheck_Private;
+
+    Out_Issues.Reset();
+
+    if (Snapshot.Nodes.IsEmpty())
+    {
+        return;
+    }
+
+    typedef void (*FValidator)(const FSnapshot&, const FAssemblyCheckOptionsStruct&, TArray<FAssemblyCheckIssueStruct>&);
+    TArray<FValidator> Validators;
+
+    if (Options.bCheckOutOfBounds)
+    {
+        Validators.Add(&Check_OutOfBounds);
+    }
+
+    if (Options.bCheckZeroScale)
+    {
+        Validators.Add(&Check_ZeroScale);
+    }
+
+    if (Options.bCheckMeshes)
+    {
+        Validators.Add(&Check_Meshes);
+    }
+
+    if (Options.bCheckDuplicates)
+    {
+        Validators.Add(&Check_Duplicates);
+    }
+
+    if (Options.bCheckMissingTags)
+    {
+        Validators.Add(&Check_MissingTags);
+    }
+
+    if (Options.bCheckSingleChildChains)
+    {
+        Validators.Add(&Check_SingleChildChains);
+    }
+
+    TArray<TArray<FAssemblyCheckIssueStruct>> Results;
+    Results.SetNum(Validators.Num());
+
+    ParallelFor(Validators.Num(), [&Validators, &Results, &Snapshot, &Options](int32 ValidatorIndex)
+        {
+            Validators[ValidatorIndex](Snapshot, Options, Results[ValidatorIndex]);
+        });
+
+    for (TArray<FAssemblyCheckIssueStruct>& Each_Result : Results)
+    {
+        Out_Issues.Append(MoveTemp(Each_Result));
+    }
+
+    // Validators only write details. Names are resolved here, because they are needed only for reported components.
+    for (FAssemblyCheckIssueStruct& Each_Issue : Out_Issues)
+    {
+        Each_Issue.Message = FString::Printf(TEXT("%s %s"), *UMeshOperationsBPLibrary::GetObjectNameForPackage(Each_Issue.Component), *Each_Issue.Message);
+    }
+}
+
+FString FMeshOps_AssemblyCheck::GetCheckName(EAssemblyCheckType Type)
+{
+    return StaticEnum<EAssemblyCheckType>()->GetDisplayNameTextByValue((int64)Type).ToString();
+}
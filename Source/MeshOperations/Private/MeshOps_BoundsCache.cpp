@@ -0,0 +1,340 @@
+#include "MeshOps_BoundsCache.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "MeshOperationsBPLibrary.h"
+
+// Levels smaller than this are not worth to dispatch to task graph.
+#define BOUNDS_CACHE_PARALLEL_THRESHOLD 512
+
+namespace MeshOps_BoundsCache_Private
+{
+    // Caches are only accessed from game thread.
+    static TMap<TWeakObjectPtr<USceneComponent>, TSharedPtr<FMeshOps_BoundsCache>>& GetRegistry()
+    {
+        static TMap<TWeakObjectPtr<USceneComponent>, TSharedPtr<FMeshOps_BoundsCache>> Registry;
+        return Registry;
+    }
+
+    static void PurgeStaleCaches()
+    {
+        for (auto It = GetRegistry().CreateIterator(); It; ++It)
+        {
+            if (!It.Key().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    static TSharedPtr<FMeshOps_BoundsCache> FindContainingCache(const USceneComponent* Target)
+    {
+        for (const USceneComponent* Each_Parent = Target; Each_Parent; Each_Parent = Each_Parent->GetAttachParent())
+        {
+            if (TSharedPtr<FMeshOps_BoundsCache>* FoundCache = GetRegistry().Find(const_cast<USceneComponent*>(Each_Parent)))
+            {
+                if ((*FoundCache)->Contains(Target))
+                {
+                    return *FoundCache;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    static FDelegateHandle Hierarchy_Changed_Handle;
+
+    // Children of the changed parent are attached, detached or destroyed. Caches which contain it only get marked, because plugin functions notify once per added component.
+    static void HandleHierarchyChanged(USceneComponent* Changed_Parent)
+    {
+        PurgeStaleCaches();
+
+        for (const TPair<TWeakObjectPtr<USceneComponent>, TSharedPtr<FMeshOps_BoundsCache>>& Each_Cache : GetRegistry())
+        {
+            Each_Cache.Value->MarkHierarchyChanged(Changed_Parent);
+        }
+    }
+}
+
+FMeshOps_BoundsCache::~FMeshOps_BoundsCache()
+{
+    this->Unbind();
+}
+
+TSharedRef<FMeshOps_BoundsCache> FMeshOps_BoundsCache::Get(USceneComponent* Target)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_BoundsCache_Private;
+
+    if (!Hierarchy_Changed_Handle.IsValid())
+    {
+        Hierarchy_Changed_Handle = UMeshOperationsBPLibrary::OnHierarchyChanged.AddStatic(&HandleHierarchyChanged);
+    }
+
+    PurgeStaleCaches();
+
+    if (TSharedPtr<FMeshOps_BoundsCache> FoundCache = FindContainingCache(Target))
+    {
+        return FoundCache.ToSharedRef();
+    }
+
+    TSharedRef<FMeshOps_BoundsCache> NewCache = MakeShared<FMeshOps_BoundsCache>();
+    NewCache->AssetRoot = Target;
+    NewCache->Collect();
+
+    GetRegistry().Add(Target, NewCache);
+    return NewCache;
+}
+
+void FMeshOps_BoundsCache::Reset(USceneComponent* Target)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_BoundsCache_Private;
+
+    if (TSharedPtr<FMeshOps_BoundsCache> FoundCache = FindContainingCache(Target))
+    {
+        GetRegistry().Remove(FoundCache->AssetRoot);
+    }
+
+    PurgeStaleCaches();
+}
+
+void FMeshOps_BoundsCache::InvalidateContaining(USceneComponent* Target)
+{
+    check(IsInGameThread());
+
+    if (TSharedPtr<FMeshOps_BoundsCache> FoundCache = MeshOps_BoundsCache_Private::FindContainingCache(Target))
+    {
+        FoundCache->Invalidate(Target);
+    }
+}
+
+void FMeshOps_BoundsCache::ResetAll()
+{
+    check(IsInGameThread());
+    MeshOps_BoundsCache_Private::GetRegistry().Empty();
+}
+
+bool FMeshOps_BoundsCache::GetDescendantsBounds(USceneComponent* Target, FBox& Out_Box)
+{
+    this->CollectIfChanged();
+    const int32* NodeIndex = this->NodeIndices.Find(Target);
+
+    if (!NodeIndex)
+    {
+        Out_Box = FBox(ForceInit);
+        return false;
+    }
+
+    this->Refresh();
+
+    Out_Box = this->Nodes[*NodeIndex].DescendantsBox;
+    return true;
+}
+
+bool FMeshOps_BoundsCache::GetSubtreeBounds(USceneComponent* Target, FBox& Out_Box)
+{
+    this->CollectIfChanged();
+    const int32* NodeIndex = this->NodeIndices.Find(Target);
+
+    if (!NodeIndex)
+    {
+        Out_Box = FBox(ForceInit);
+        return false;
+    }
+
+    this->Refresh();
+
+    const FBoundsNode& Node = this->Nodes[*NodeIndex];
+    Out_Box = Node.OwnBox + Node.DescendantsBox;
+    return true;
+}
+
+void FMeshOps_BoundsCache::Invalidate(USceneComponent* Target)
+{
+    // Next collection marks every node dirty anyway.
+    if (this->bIsHierarchyChanged)
+    {
+        return;
+    }
+
+    if (const int32* NodeIndex = this->NodeIndices.Find(Target))
+    {
+        this->MarkDirty(*NodeIndex);
+    }
+}
+
+void FMeshOps_BoundsCache::Rebuild()
+{
+    this->bIsHierarchyChanged = true;
+}
+
+void FMeshOps_BoundsCache::MarkHierarchyChanged(const USceneComponent* Changed_Parent)
+{
+    // Components attached since last collection aren't indexed yet, but then cache is already marked.
+    if (this->NodeIndices.Contains(Changed_Parent))
+    {
+        this->bIsHierarchyChanged = true;
+    }
+}
+
+bool FMeshOps_BoundsCache::Contains(const USceneComponent* Target)
+{
+    this->CollectIfChanged();
+    return this->NodeIndices.Contains(Target);
+}
+
+USceneComponent* FMeshOps_BoundsCache::GetRoot() const
+{
+    return this->AssetRoot.Get();
+}
+
+void FMeshOps_BoundsCache::CollectIfChanged()
+{
+    if (this->bIsHierarchyChanged)
+    {
+        this->Collect();
+    }
+}
+
+void FMeshOps_BoundsCache::Collect()
+{
+    this->Unbind();
+    this->bIsHierarchyChanged = false;
+
+    this->Nodes.Reset();
+    this->LevelStarts.Reset();
+    this->NodeIndices.Reset();
+    this->bAnyDirty = true;
+
+    USceneComponent* Root = this->AssetRoot.Get();
+
+    if (!IsValid(Root))
+    {
+        return;
+    }
+
+    FBoundsNode& RootNode = this->Nodes.AddDefaulted_GetRef();
+    RootNode.Component = Root;
+
+    this->LevelStarts.Add(0);
+    int32 LevelEnd = 1;
+
+    // Breadth first traversal. Children of each node are appended as a contiguous block.
+    for (int32 NodeIndex = 0; NodeIndex < this->Nodes.Num(); NodeIndex++)
+    {
+        if (NodeIndex == LevelEnd)
+        {
+            this->LevelStarts.Add(NodeIndex);
+            LevelEnd = this->Nodes.Num();
+        }
+
+        const TArray<TObjectPtr<USceneComponent>>& Children = this->Nodes[NodeIndex].Component->GetAttachChildren();
+
+        this->Nodes[NodeIndex].FirstChild = this->Nodes.Num();
+
+        for (USceneComponent* Each_Child : Children)
+        {
+            if (!IsValid(Each_Child))
+            {
+                continue;
+            }
+
+            FBoundsNode& ChildNode = this->Nodes.AddDefaulted_GetRef();
+            ChildNode.Component = Each_Child;
+            ChildNode.Parent = NodeIndex;
+        }
+
+        this->Nodes[NodeIndex].NumChildren = this->Nodes.Num() - this->Nodes[NodeIndex].FirstChild;
+    }
+
+    this->LevelStarts.Add(this->Nodes.Num());
+    this->NodeIndices.Reserve(this->Nodes.Num());
+
+    for (int32 NodeIndex = 0; NodeIndex < this->Nodes.Num(); NodeIndex++)
+    {
+        FBoundsNode& Each_Node = this->Nodes[NodeIndex];
+        USceneComponent* Component = Each_Node.Component.Get();
+
+        this->NodeIndices.Add(Component, NodeIndex);
+        Each_Node.TransformHandle = Component->TransformUpdated.AddSP(this, &FMeshOps_BoundsCache::OnTransformUpdated);
+    }
+}
+
+void FMeshOps_BoundsCache::Unbind()
+{
+    for (FBoundsNode& Each_Node : this->Nodes)
+    {
+        if (USceneComponent* Component = Each_Node.Component.Get())
+        {
+            Component->TransformUpdated.Remove(Each_Node.TransformHandle);
+        }
+
+        Each_Node.TransformHandle.Reset();
+    }
+}
+
+void FMeshOps_BoundsCache::Refresh()
+{
+    if (!this->bAnyDirty)
+    {
+        return;
+    }
+
+    // Deepest level first, so children are always up to date when their parent is processed.
+    for (int32 LevelIndex = this->LevelStarts.Num() - 2; LevelIndex >= 0; LevelIndex--)
+    {
+        const int32 LevelStart = this->LevelStarts[LevelIndex];
+        const int32 LevelCount = this->LevelStarts[LevelIndex + 1] - LevelStart;
+        const EParallelForFlags Flags = LevelCount < BOUNDS_CACHE_PARALLEL_THRESHOLD ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+        ParallelFor(LevelCount, [this, LevelStart](int32 Index)
+            {
+                FBoundsNode& Node = this->Nodes[LevelStart + Index];
+
+                if (!Node.bIsDirty)
+                {
+                    return;
+                }
+
+                Node.OwnBox = FBox(ForceInit);
+
+                if (const UPrimitiveComponent* Geometry = Cast<UPrimitiveComponent>(Node.Component.Get()))
+                {
+                    Node.OwnBox = Geometry->Bounds.GetBox();
+                }
+
+                Node.DescendantsBox = FBox(ForceInit);
+
+                for (int32 ChildIndex = Node.FirstChild; ChildIndex < Node.FirstChild + Node.NumChildren; ChildIndex++)
+                {
+                    const FBoundsNode& Child = this->Nodes[ChildIndex];
+                    Node.DescendantsBox += Child.OwnBox;
+                    Node.DescendantsBox += Child.DescendantsBox;
+                }
+
+                Node.bIsDirty = false;
+            }, Flags);
+    }
+
+    this->bAnyDirty = false;
+}
+
+void FMeshOps_BoundsCache::MarkDirty(int32 NodeIndex)
+{
+    // Walk stops at the first dirty ancestor, its chain is already dirty. So propagated updates of a big subtree cost O(n) in total.
+    while (NodeIndex != INDEX_NONE && !this->Nodes[NodeIndex].bIsDirty)
+    {
+        this->Nodes[NodeIndex].bIsDirty = true;
+        NodeIndex = this->Nodes[NodeIndex].Parent;
+    }
+
+    this->bAnyDirty = true;
+}
+
+void FMeshOps_BoundsCache::OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    this->Invalidate(UpdatedComponent);
+}
@@ -0,0 +1,212 @@
+#include "MeshOps_ExportTask.h"
+
+#include "Async/Async.h"
+#include "Engine/StaticMesh.h"
+
+// Progress changes smaller than this aren't posted to game thread.
+#define EXPORT_PROGRESS_STEP 0.01f
+
+bool UMeshOps_ExportTask::Start(TArrayView<const FGLTFExportJobStruct> In_Jobs, const FGLTFExportOptionsStruct& In_Options, int32 Max_Concurrent_Jobs)
+{
+    check(IsInGameThread());
+
+    if (this->bIsRunning || In_Jobs.IsEmpty())
+    {
+        return false;
+    }
+
+    this->Options = In_Options;
+
+    TArray<FString> Ignored_Options;
+    FMeshOps_GLTFWriter::GetIgnoredOptions(this->Options, Ignored_Options);
+
+    if (!Ignored_Options.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GLTF Export : Native writer only exports static meshes with constant material factors. These options are ignored : %s"), *FString::Join(Ignored_Options, TEXT(", ")));
+    }
+
+    this->Cache = MakeUnique<FMeshOps_GLTFCache>();
+    this->Jobs.Reset();
+    this->Results.Reset();
+    this->Used_Meshes.Reset();
+    this->Next_Job = 0;
+    this->bIsCancelRequested = false;
+    this->Posted_Progress = 0.f;
+
+    TSet<UStaticMesh*> Meshes;
+
+    for (const FGLTFExportJobStruct& Each_Job : In_Jobs)
+    {
+        TUniquePtr<FJob> Job = MakeUnique<FJob>();
+        Job->ExportPath = Each_Job.Export_Path;
+
+        const double StartTime = FPlatformTime::Seconds();
+        FMeshOps_GLTFWriter::MakeSnapshot(Each_Job.Target_Actors, this->Options, Job->Scene, this->Cache.Get());
+        Job->Snapshot_Time = FPlatformTime::Seconds() - StartTime;
+
+        for (const FMeshOps_ExportScene::FMesh& Each_Mesh : Job->Scene.Meshes)
+        {
+            Meshes.Add(const_cast<UStaticMesh*>(Each_Mesh.StaticMesh));
+        }
+
+        FGLTFExportJobResultStruct& Result = this->Results.AddDefaulted_GetRef();
+        Result.Export_Path = Job->ExportPath;
+        Result.Snapshot_Time = Job->Snapshot_Time;
+
+        this->Jobs.Add(MoveTemp(Job));
+    }
+
+    this->Used_Meshes = Meshes.Array();
+
+    // Task has to survive until completion even if caller doesn't keep a reference.
+    this->AddToRoot();
+    this->bIsRunning = true;
+
+    // Each worker writes one job at a time. Meshes of a job are still converted in parallel.
+    const int32 NumWorkers = FMath::Clamp(Max_Concurrent_Jobs, 1, this->Jobs.Num());
+    this->Running_Workers = NumWorkers;
+
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+    {
+        Async(EAsyncExecution::ThreadPool, [this]()
+            {
+                this->RunJobs();
+            });
+    }
+
+    return true;
+}
+
+void UMeshOps_ExportTask::RunJobs()
+{
+    for (int32 JobIndex = this->Next_Job++; JobIndex < this->Jobs.Num(); JobIndex = this->Next_Job++)
+    {
+        FJob& Job = *this->Jobs[JobIndex];
+        FGLTFExportJobResultStruct& Result = this->Results[JobIndex];
+
+        if (this->bIsCancelRequested)
+        {
+            Result.Message = TEXT("Export is canceled.");
+        }
+
+        else
+        {
+            Result.bIsSuccessful = FMeshOps_GLTFWriter::Write(Job.Scene, this->Options, Job.ExportPath, [this, JobIndex](float In_Progress) { return this->ReportProgress(JobIndex, In_Progress); }, Result.Stats, Result.Message, this->Cache.Get());
+        }
+
+        if (Result.bIsSuccessful)
+        {
+            UE_LOG(LogTemp, Log, TEXT("GLTF Export : %s is written. %d meshes (%d reused), %lld bytes, compression ratio %.2f, snapshot %.3f s, encode %.3f s, total %.3f s."), *Job.ExportPath, Result.Stats.Num_Meshes, Result.Stats.Num_Reused_Meshes, Result.Stats.Buffer_Size, Result.Stats.Compression_Ratio, Result.Snapshot_Time, Result.Stats.Encode_Time, Result.Stats.Total_Time);
+        }
+
+        // Scene isn't needed anymore. Big batches shouldn't keep all of them until the end.
+        Job.Scene = FMeshOps_ExportScene();
+        Job.Progress = 1.f;
+
+        AsyncTask(ENamedThreads::GameThread, [this, Result]()
+            {
+                this->OnJobCompleted.Broadcast(Result);
+            });
+    }
+
+    if (--this->Running_Workers == 0)
+    {
+        AsyncTask(ENamedThreads::GameThread, [this]()
+            {
+                this->Finish();
+            });
+    }
+}
+
+bool UMeshOps_ExportTask::ReportProgress(int32 JobIndex, float In_Progress)
+{
+    this->Jobs[JobIndex]->Progress = In_Progress;
+
+    const float Total = this->GetProgress();
+
+    if (Total - this->Posted_Progress >= EXPORT_PROGRESS_STEP)
+    {
+        this->Posted_Progress = Total;
+
+        AsyncTask(ENamedThreads::GameThread, [this, Total]()
+            {
+                if (this->bIsRunning)
+                {
+                    this->OnProgress.Broadcast(Total);
+                }
+            });
+    }
+
+    return !this->bIsCancelRequested;
+}
+
+void UMeshOps_ExportTask::Finish()
+{
+    check(IsInGameThread());
+
+    int32 NumFailed = 0;
+    FString Message;
+
+    for (const FGLTFExportJobResultStruct& Each_Result : this->Results)
+    {
+        if (!Each_Result.bIsSuccessful)
+        {
+            NumFailed++;
+            Message = Each_Result.Message;
+        }
+    }
+
+    if (this->Results.Num() == 1)
+    {
+        Message = NumFailed == 0 ? this->Results[0].Export_Path : Message;
+    }
+
+    else
+    {
+        Message = FString::Printf(TEXT("%d of %d jobs are exported.%s%s"), this->Results.Num() - NumFailed, this->Results.Num(), NumFailed > 0 ? TEXT(" Last error : ") : TEXT(""), *(NumFailed > 0 ? Message : FString()));
+    }
+
+    this->Cache.Reset();
+    this->Used_Meshes.Reset();
+    this->bIsRunning = false;
+
+    this->OnCompleted.Broadcast(NumFailed == 0, Message);
+    this->RemoveFromRoot();
+}
+
+void UMeshOps_ExportTask::Cancel()
+{
+    this->bIsCancelRequested = true;
+}
+
+float UMeshOps_ExportTask::GetProgress() const
+{
+    if (this->Jobs.IsEmpty())
+    {
+        return 0.f;
+    }
+
+    float Total = 0.f;
+
+    for (const TUniquePtr<FJob>& Each_Job : this->Jobs)
+    {
+        Total += Each_Job->Progress;
+    }
+
+    return Total / this->Jobs.Num();
+}
+
+bool UMeshOps_ExportTask::IsRunning() const
+{
+    return this->bIsRunning;
+}
+
+FGLTFExportStatsStruct UMeshOps_ExportTask::GetStats() const
+{
+    return this->Results.IsEmpty() ? FGLTFExportStatsStruct() : this->Results[0].Stats;
+}
+
+TArray<FGLTFExportJobResultStruct> UMeshOps_ExportTask::GetResults() const
+{
+    return this->Results;
+}
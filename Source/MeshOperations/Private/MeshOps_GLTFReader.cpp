@@ -0,0 +1,1139 @@
+#include "MeshOps_GLTFReader.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#define GLTF_BYTE 5120
+#define GLTF_UNSIGNED_BYTE 5121
+#define GLTF_SHORT 5122
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_FLOAT 5126
+#define GLTF_MODE_TRIANGLES 4
+
+#define GLB_MAGIC 0x46546C67
+#define GLB_CHUNK_JSON 0x4E4F534A
+#define GLB_CHUNK_BIN 0x004E4942
+#define GLB_HEADER_SIZE 12
+#define GLB_CHUNK_HEADER_SIZE 8
+
+namespace MeshOps_GLTFReader_Private
+{
+    typedef TArray<TSharedPtr<FJsonValue>> FJsonArray;
+
+    // Keeps a file mapped while its buffers are decoded. Platforms which can't map files load it instead.
+    struct FFileData
+    {
+        // Region has to be released before its handle, so order of these members matters.
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+        TArray64<uint8> Loaded;
+
+        const uint8* Data = nullptr;
+        int64 Size = 0;
+
+        bool Open(const FString& Path)
+        {
+            FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+
+            if (Result.HasValue())
+            {
+                this->Handle = Result.StealValue();
+                this->Region.Reset(this->Handle->MapRegion(0, this->Handle->GetFileSize()));
+            }
+
+            if (this->Region.IsValid())
+            {
+                this->Data = this->Region->GetMappedPtr();
+                this->Size = this->Region->GetMappedSize();
+                return true;
+            }
+
+            if (!FFileHelper::LoadFileToArray(this->Loaded, *Path))
+            {
+                return false;
+            }
+
+            this->Data = this->Loaded.GetData();
+            this->Size = this->Loaded.Num();
+            return true;
+        }
+    };
+
+    struct FBufferData
+    {
+        const uint8* Data = nullptr;
+        int64 Size = 0;
+
+        // EXT_meshopt_compression fallback buffer without storage. Views which point to it are only stored compressed.
+        bool bIsFallback = false;
+    };
+
+    struct FDocument
+    {
+        FString Path;
+        TSharedPtr<FJsonObject> Root;
+
+        // Mapped files and decoded data URIs which buffers point to.
+        TArray<TUniquePtr<FFileData>> Files;
+        TArray<TArray<uint8>> Decoded;
+
+        FBufferData BinaryChunk;
+        TArray<FBufferData> Buffers;
+
+        const FJsonArray* Accessors = nullptr;
+        const FJsonArray* BufferViews = nullptr;
+    };
+
+    struct FAccessor
+    {
+        const uint8* Data = nullptr;
+        int32 Count = 0;
+        int32 ComponentType = 0;
+        int32 NumComponents = 0;
+        int64 Stride = 0;
+        bool bIsNormalized = false;
+    };
+
+    static uint32 ReadUInt32(const uint8* Data)
+    {
+        uint32 Value;
+        FMemory::Memcpy(&Value, Data, sizeof(uint32));
+        return Value;
+    }
+
+    // Same conversion with writer. Swapping Y and Z is its own inverse.
+    static FVector3f ConvertVector(const FVector3f& Vector)
+    {
+        return FVector3f(Vector.X, Vector.Z, Vector.Y);
+    }
+
+    static int32 GetNumComponents(const FString& Type)
+    {
+        if (Type == TEXT("SCALAR"))
+        {
+            return 1;
+        }
+
+        if (Type == TEXT("VEC2"))
+        {
+            return 2;
+        }
+
+        if (Type == TEXT("VEC3"))
+        {
+            return 3;
+        }
+
+        if (Type == TEXT("VEC4"))
+        {
+            return 4;
+        }
+
+        return 0;
+    }
+
+    static int32 GetComponentSize(int32 ComponentType)
+    {
+        switch (ComponentType)
+        {
+            case GLTF_BYTE:
+            case GLTF_UNSIGNED_BYTE:
+                return 1;
+
+            case GLTF_SHORT:
+            case GLTF_UNSIGNED_SHORT:
+                return 2;
+
+            case GLTF_UNSIGNED_INT:
+            case GLTF_FLOAT:
+                return 4;
+
+            default:
+                return 0;
+        }
+    }
+
+    static float ReadComponent(const uint8* Data, int32 ComponentType, bool bIsNormalized)
+    {
+        switch (ComponentType)
+        {
+            case GLTF_FLOAT:
+            {
+                float Value;
+                FMemory::Memcpy(&Value, Data, sizeof(float));
+                return Value;
+            }
+
+            case GLTF_BYTE:
+            {
+                const int8 Value = *(const int8*)Data;
+                return bIsNormalized ? FMath::Max(Value / 127.f, -1.f) : Value;
+            }
+
+            case GLTF_UNSIGNED_BYTE:
+            {
+                return bIsNormalized ? *Data / 255.f : *Data;
+            }
+
+            case GLTF_SHORT:
+            {
+                int16 Value;
+                FMemory::Memcpy(&Value, Data, sizeof(int16));
+                return bIsNormalized ? FMath::Max(Value / 32767.f, -1.f) : Value;
+            }
+
+            case GLTF_UNSIGNED_SHORT:
+            {
+                uint16 Value;
+                FMemory::Memcpy(&Value, Data, sizeof(uint16));
+                return bIsNormalized ? Value / 65535.f : Value;
+            }
+
+            case GLTF_UNSIGNED_INT:
+            {
+                return (float)ReadUInt32(Data);
+            }
+
+            default:
+                return 0.f;
+        }
+    }
+
+    // AsObject logs an error and returns null for other value types, so elements of JSON arrays are checked with this.
+    static const FJsonObject* GetObject(const TSharedPtr<FJsonValue>& Value)
+    {
+        const TSharedPtr<FJsonObject>* Object = nullptr;
+
+        if (!Value.IsValid() || !Value->TryGetObject(Object) || !Object->IsValid())
+        {
+            return nullptr;
+        }
+
+        return Object->Get();
+    }
+
+    static bool ReadNumbers(const FJsonObject& Object, const TCHAR* Identifier, double* Out_Values, int32 NumValues)
+    {
+        const FJsonArray* Values = nullptr;
+
+        if (!Object.TryGetArrayField(Identifier, Values) || Values->Num() != NumValues)
+        {
+            return false;
+        }
+
+        for (int32 ValueIndex = 0; ValueIndex < NumValues; ValueIndex++)
+        {
+            if (!(*Values)[ValueIndex].IsValid() || !(*Values)[ValueIndex]->TryGetNumber(Out_Values[ValueIndex]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool GetAccessor(const FDocument& Document, int32 AccessorIndex, FAccessor& Out_Accessor, FString& Out_Error)
+    {
+        if (!Document.Accessors || !Document.Accessors->IsValidIndex(AccessorIndex))
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d doesn't exist."), AccessorIndex);
+            return false;
+        }
+
+        const FJsonObject* Accessor = GetObject((*Document.Accessors)[AccessorIndex]);
+
+        if (!Accessor || Accessor->HasField(TEXT("sparse")))
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d is sparse or invalid. Sparse accessors aren't supported."), AccessorIndex);
+            return false;
+        }
+
+        int64 Count = 0;
+        int32 ViewIndex = INDEX_NONE;
+        int64 AccessorOffset = 0;
+
+        Accessor->TryGetNumberField(TEXT("count"), Count);
+        Accessor->TryGetNumberField(TEXT("componentType"), Out_Accessor.ComponentType);
+        Accessor->TryGetNumberField(TEXT("byteOffset"), AccessorOffset);
+        Accessor->TryGetBoolField(TEXT("normalized"), Out_Accessor.bIsNormalized);
+        Out_Accessor.NumComponents = GetNumComponents(Accessor->GetStringField(TEXT("type")));
+
+        const int32 ComponentSize = GetComponentSize(Out_Accessor.ComponentType);
+
+        if (Count <= 0 || Count > MAX_int32 || ComponentSize == 0 || Out_Accessor.NumComponents == 0)
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d has unsupported type or count."), AccessorIndex);
+            return false;
+        }
+
+        // Accessors without views are all zeros. Exporters don't write them for mesh attributes.
+        if (!Accessor->TryGetNumberField(TEXT("bufferView"), ViewIndex) || !Document.BufferViews || !Document.BufferViews->IsValidIndex(ViewIndex))
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d has no buffer view."), AccessorIndex);
+            return false;
+        }
+
+        const FJsonObject* View = GetObject((*Document.BufferViews)[ViewIndex]);
+
+        if (!View)
+        {
+            Out_Error = FString::Printf(TEXT("Buffer view %d of accessor %d isn't an object."), ViewIndex, AccessorIndex);
+            return false;
+        }
+
+        int32 BufferIndex = INDEX_NONE;
+        int64 ViewOffset = 0;
+        int64 ViewLength = 0;
+        int64 ViewStride = 0;
+
+        View->TryGetNumberField(TEXT("buffer"), BufferIndex);
+        View->TryGetNumberField(TEXT("byteOffset"), ViewOffset);
+        View->TryGetNumberField(TEXT("byteLength"), ViewLength);
+        View->TryGetNumberField(TEXT("byteStride"), ViewStride);
+
+        const int64 ElementSize = (int64)ComponentSize * Out_Accessor.NumComponents;
+        Out_Accessor.Count = (int32)Count;
+        Out_Accessor.Stride = ViewStride > 0 ? ViewStride : ElementSize;
+
+        const int64 End = AccessorOffset + (Count - 1) * Out_Accessor.Stride + ElementSize;
+
+        if (Document.Buffers.IsValidIndex(BufferIndex) && Document.Buffers[BufferIndex].bIsFallback)
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d is only stored compressed with EXT_meshopt_compression, which isn't supported."), AccessorIndex);
+            return false;
+        }
+
+        if (!Document.Buffers.IsValidIndex(BufferIndex) || ViewOffset < 0 || AccessorOffset < 0 || End > ViewLength || ViewOffset + ViewLength > Document.Buffers[BufferIndex].Size)
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d is out of its buffer."), AccessorIndex);
+            return false;
+        }
+
+        Out_Accessor.Data = Document.Buffers[BufferIndex].Data + ViewOffset + AccessorOffset;
+        return true;
+    }
+
+    /*
+    * Decodes an accessor to the end of the given array. T is a float vector.
+    * Float data with the same layout is copied as one block, other types are converted element by element.
+    */
+    template<typename T>
+    static bool ReadVectors(const FDocument& Document, int32 AccessorIndex, int32 ExpectedCount, TArray<T>& Out_Values, FString& Out_Error)
+    {
+        constexpr int32 NumValues = sizeof(T) / sizeof(float);
+
+        FAccessor Accessor;
+
+        if (!GetAccessor(Document, AccessorIndex, Accessor, Out_Error))
+        {
+            return false;
+        }
+
+        if (Accessor.NumComponents < NumValues || (ExpectedCount != INDEX_NONE && Accessor.Count != ExpectedCount))
+        {
+            Out_Error = FString::Printf(TEXT("Accessor %d doesn't match its attribute."), AccessorIndex);
+            return false;
+        }
+
+        const int32 First = Out_Values.Num();
+        Out_Values.AddUninitialized(Accessor.Count);
+
+        if (Accessor.ComponentType == GLTF_FLOAT && Accessor.NumComponents == NumValues && Accessor.Stride == sizeof(T))
+        {
+            FMemory::Memcpy(Out_Values.GetData() + First, Accessor.Data, (int64)Accessor.Count * sizeof(T));
+            return true;
+        }
+
+        const int32 ComponentSize = GetComponentSize(Accessor.ComponentType);
+
+        for (int32 ElementIndex = 0; ElementIndex < Accessor.Count; ElementIndex++)
+        {
+            const uint8* Element = Accessor.Data + ElementIndex * Accessor.Stride;
+            float* Values = (float*)&Out_Values[First + ElementIndex];
+
+            for (int32 ValueIndex = 0; ValueIndex < NumValues; ValueIndex++)
+            {
+                Values[ValueIndex] = ReadComponent(Element + ValueIndex * ComponentSize, Accessor.ComponentType, Accessor.bIsNormalized);
+            }
+        }
+
+        return true;
+    }
+
+    static bool ReadIndices(const FDocument& Document, int32 AccessorIndex, uint32 BaseVertex, uint32 NumVertices, TArray<uint32>& Out_Indices, FString& Out_Error)
+    {
+        FAccessor Accessor;
+
+        if (!GetAccessor(Document, AccessorIndex, Accessor, Out_Error))
+        {
+            return false;
+        }
+
+        if (Accessor.NumComponents != 1 || Accessor.ComponentType == GLTF_FLOAT)
+        {
+            Out_Error = FString::Printf(TEXT("Index accessor %d has unsupported type."), AccessorIndex);
+            return false;
+        }
+
+        const int32 First = Out_Indices.Num();
+        Out_Indices.AddUninitialized(Accessor.Count);
+
+        for (int32 ElementIndex = 0; ElementIndex < Accessor.Count; ElementIndex++)
+        {
+            const uint8* Element = Accessor.Data + ElementIndex * Accessor.Stride;
+            uint32 Index = 0;
+
+            switch (Accessor.ComponentType)
+            {
+                case GLTF_UNSIGNED_BYTE:
+                    Index = *Element;
+                    break;
+
+                case GLTF_UNSIGNED_SHORT:
+                {
+                    uint16 Value;
+                    FMemory::Memcpy(&Value, Element, sizeof(uint16));
+                    Index = Value;
+                    break;
+                }
+
+                default:
+                    Index = ReadUInt32(Element);
+                    break;
+            }
+
+            if (Index >= NumVertices)
+            {
+                Out_Error = FString::Printf(TEXT("Index accessor %d points to a vertex which doesn't exist."), AccessorIndex);
+                return false;
+            }
+
+            Out_Indices[First + ElementIndex] = BaseVertex + Index;
+        }
+
+        return true;
+    }
+
+    // Area weighted normals of triangles starting at FirstIndex. Used for primitives without normals.
+    static void ComputeNormals(FMeshOps_MeshBuffers& Buffers, int32 FirstIndex)
+    {
+        for (int32 Index = FirstIndex; Index + 2 < Buffers.Indices.Num(); Index += 3)
+        {
+            const uint32 A = Buffers.Indices[Index];
+            const uint32 B = Buffers.Indices[Index + 1];
+            const uint32 C = Buffers.Indices[Index + 2];
+            const FVector3f FaceNormal = FVector3f::CrossProduct(Buffers.Positions[B] - Buffers.Positions[A], Buffers.Positions[C] - Buffers.Positions[A]);
+
+            Buffers.Normals[A] += FaceNormal;
+            Buffers.Normals[B] += FaceNormal;
+            Buffers.Normals[C] += FaceNormal;
+        }
+    }
+
+    static bool ReadMesh(const FDocument& Document, const FJsonObject& Mesh, float UniformScale, FMeshOps_ImportScene::FMesh& Out_Mesh, FString& Out_Error)
+    {
+        Mesh.TryGetStringField(TEXT("name"), Out_Mesh.Name);
+
+        const FJsonArray* Primitives = nullptr;
+
+        if (!Mesh.TryGetArrayField(TEXT("primitives"), Primitives))
+        {
+            return true;
+        }
+
+        FMeshOps_MeshBuffers& Buffers = Out_Mesh.Buffers;
+        bool bHasTangents = true;
+        bool bHasUVs = false;
+
+        for (const TSharedPtr<FJsonValue>& Each_Value : *Primitives)
+        {
+            const FJsonObject* Primitive = GetObject(Each_Value);
+            const TSharedPtr<FJsonObject>* Attributes = nullptr;
+            int32 Mode = GLTF_MODE_TRIANGLES;
+            int32 PositionAccessor = INDEX_NONE;
+
+            // Points, lines and strips can't be static mesh sections.
+            if (!Primitive || (Primitive->TryGetNumberField(TEXT("mode"), Mode) && Mode != GLTF_MODE_TRIANGLES) || !Primitive->TryGetObjectField(TEXT("attributes"), Attributes) || !(*Attributes)->TryGetNumberField(TEXT("POSITION"), PositionAccessor))
+            {
+                continue;
+            }
+
+            const int32 BaseVertex = Buffers.Positions.Num();
+            const int32 FirstIndex = Buffers.Indices.Num();
+
+            if (!ReadVectors(Document, PositionAccessor, INDEX_NONE, Buffers.Positions, Out_Error))
+            {
+                return false;
+            }
+
+            const int32 NumVertices = Buffers.Positions.Num() - BaseVertex;
+            int32 AccessorIndex = INDEX_NONE;
+
+            if (Primitive->TryGetNumberField(TEXT("indices"), AccessorIndex))
+            {
+                if (!ReadIndices(Document, AccessorIndex, BaseVertex, NumVertices, Buffers.Indices, Out_Error))
+                {
+                    return false;
+                }
+            }
+
+            else
+            {
+                for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+                {
+                    Buffers.Indices.Add(BaseVertex + VertexIndex);
+                }
+            }
+
+            // Incomplete triangle at the end is dropped.
+            Buffers.Indices.SetNum(FirstIndex + (Buffers.Indices.Num() - FirstIndex) / 3 * 3);
+
+            if ((*Attributes)->TryGetNumberField(TEXT("NORMAL"), AccessorIndex))
+            {
+                if (!ReadVectors(Document, AccessorIndex, NumVertices, Buffers.Normals, Out_Error))
+                {
+                    return false;
+                }
+            }
+
+            else
+            {
+                Buffers.Normals.AddZeroed(NumVertices);
+                ComputeNormals(Buffers, FirstIndex);
+            }
+
+            // Tangents are only kept if every primitive has them. Otherwise mesh builder generates them.
+            if (bHasTangents && (*Attributes)->TryGetNumberField(TEXT("TANGENT"), AccessorIndex))
+            {
+                TArray<FVector4f> Tangents;
+
+                if (!ReadVectors(Document, AccessorIndex, NumVertices, Tangents, Out_Error))
+                {
+                    return false;
+                }
+
+                // W is the bitangent sign of glTF tangents.
+                for (const FVector4f& Each_Tangent : Tangents)
+                {
+                    Buffers.Tangents.Add(FVector3f(Each_Tangent));
+                    Buffers.TangentSigns.Add(Each_Tangent.W < 0 ? -1.f : 1.f);
+                }
+            }
+
+            else
+            {
+                bHasTangents = false;
+            }
+
+            if ((*Attributes)->TryGetNumberField(TEXT("TEXCOORD_0"), AccessorIndex))
+            {
+                if (!ReadVectors(Document, AccessorIndex, NumVertices, Buffers.UVs, Out_Error))
+                {
+                    return false;
+                }
+
+                bHasUVs = true;
+            }
+
+            else
+            {
+                Buffers.UVs.AddZeroed(NumVertices);
+            }
+
+            int32 Material = INDEX_NONE;
+            Primitive->TryGetNumberField(TEXT("material"), Material);
+
+            FMeshOps_MeshBuffers::FSection& Section = Buffers.Sections.AddDefaulted_GetRef();
+            Section.MaterialIndex = Out_Mesh.Materials.Add(Material);
+            Section.FirstIndex = FirstIndex;
+            Section.NumTriangles = (Buffers.Indices.Num() - FirstIndex) / 3;
+            Section.MinVertexIndex = BaseVertex;
+            Section.MaxVertexIndex = BaseVertex + FMath::Max(NumVertices - 1, 0);
+        }
+
+        if (!bHasTangents)
+        {
+            Buffers.Tangents.Empty();
+            Buffers.TangentSigns.Empty();
+        }
+
+        if (!bHasUVs)
+        {
+            Buffers.UVs.Empty();
+        }
+
+        for (int32 VertexIndex = 0; VertexIndex < Buffers.Positions.Num(); VertexIndex++)
+        {
+            Buffers.Positions[VertexIndex] = ConvertVector(Buffers.Positions[VertexIndex] * UniformScale);
+            Buffers.Normals[VertexIndex] = ConvertVector(Buffers.Normals[VertexIndex]).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+        }
+
+        for (FVector3f& Each_Tangent : Buffers.Tangents)
+        {
+            Each_Tangent = ConvertVector(Each_Tangent).GetSafeNormal();
+        }
+
+        // Swapping Y and Z mirrors the basis, so cross product of converted normal and tangent points against the converted bitangent.
+        for (float& Each_Sign : Buffers.TangentSigns)
+        {
+            Each_Sign = -Each_Sign;
+        }
+
+        return true;
+    }
+
+    static FTransform ReadNodeTransform(const FJsonObject& Node, float UniformScale)
+    {
+        double Values[16];
+
+        if (ReadNumbers(Node, TEXT("matrix"), Values, 16))
+        {
+            // glTF matrices are column major and they transform column vectors. That is the same memory layout with Unreal row vector matrices.
+            // Swapping Y and Z on both sides converts the basis.
+            static const int32 Axes[4] = { 0, 2, 1, 3 };
+            FMatrix Matrix;
+
+            for (int32 Row = 0; Row < 4; Row++)
+            {
+                for (int32 Column = 0; Column < 4; Column++)
+                {
+                    Matrix.M[Row][Column] = Values[Axes[Row] * 4 + Axes[Column]];
+                }
+            }
+
+            Matrix.M[3][0] *= UniformScale;
+            Matrix.M[3][1] *= UniformScale;
+            Matrix.M[3][2] *= UniformScale;
+
+            return FTransform(Matrix);
+        }
+
+        FTransform Transform;
+
+        if (ReadNumbers(Node, TEXT("translation"), Values, 3))
+        {
+            Transform.SetLocation(FVector(Values[0], Values[2], Values[1]) * UniformScale);
+        }
+
+        if (ReadNumbers(Node, TEXT("rotation"), Values, 4))
+        {
+            Transform.SetRotation(FQuat(-Values[0], -Values[2], -Values[1], Values[3]).GetNormalized());
+        }
+
+        if (ReadNumbers(Node, TEXT("scale"), Values, 3))
+        {
+            Transform.SetScale3D(FVector(Values[0], Values[2], Values[1]));
+        }
+
+        return Transform;
+    }
+
+    // EXT_mesh_gpu_instancing. Each instance becomes a child node, because imported hierarchy only has static mesh components.
+    static bool AddInstanceNodes(const FDocument& Document, const FJsonObject& Node, int32 NodeIndex, float UniformScale, FMeshOps_ImportScene& Out_Scene, FString& Out_Error)
+    {
+        const TSharedPtr<FJsonObject>* Extensions = nullptr;
+        const TSharedPtr<FJsonObject>* Instancing = nullptr;
+        const TSharedPtr<FJsonObject>* Attributes = nullptr;
+
+        if (Out_Scene.Nodes[NodeIndex].Mesh == INDEX_NONE || !Node.TryGetObjectField(TEXT("extensions"), Extensions) || !(*Extensions)->TryGetObjectField(TEXT("EXT_mesh_gpu_instancing"), Instancing) || !(*Instancing)->TryGetObjectField(TEXT("attributes"), Attributes))
+        {
+            return true;
+        }
+
+        TArray<FVector3f> Translations;
+        TArray<FVector4f> Rotations;
+        TArray<FVector3f> Scales;
+        int32 AccessorIndex = INDEX_NONE;
+
+        if ((*Attributes)->TryGetNumberField(TEXT("TRANSLATION"), AccessorIndex) && !ReadVectors(Document, AccessorIndex, INDEX_NONE, Translations, Out_Error))
+        {
+            return false;
+        }
+
+        if ((*Attributes)->TryGetNumberField(TEXT("ROTATION"), AccessorIndex) && !ReadVectors(Document, AccessorIndex, INDEX_NONE, Rotations, Out_Error))
+        {
+            return false;
+        }
+
+        if ((*Attributes)->TryGetNumberField(TEXT("SCALE"), AccessorIndex) && !ReadVectors(Document, AccessorIndex, INDEX_NONE, Scales, Out_Error))
+        {
+            return false;
+        }
+
+        const int32 NumInstances = FMath::Max3(Translations.Num(), Rotations.Num(), Scales.Num());
+
+        if ((!Translations.IsEmpty() && Translations.Num() != NumInstances) || (!Rotations.IsEmpty() && Rotations.Num() != NumInstances) || (!Scales.IsEmpty() && Scales.Num() != NumInstances))
+        {
+            Out_Error = FString::Printf(TEXT("Instance attributes of node %d have different counts."), NodeIndex);
+            return false;
+        }
+
+        const int32 Mesh = Out_Scene.Nodes[NodeIndex].Mesh;
+        const FString BaseName = Out_Scene.Nodes[NodeIndex].Name;
+        Out_Scene.Nodes[NodeIndex].Mesh = INDEX_NONE;
+
+        for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+        {
+            FTransform Transform;
+
+            if (!Translations.IsEmpty())
+            {
+                Transform.SetLocation((FVector)ConvertVector(Translations[InstanceIndex] * UniformScale));
+            }
+
+            if (!Rotations.IsEmpty())
+            {
+                const FVector4f& Rotation = Rotations[InstanceIndex];
+                Transform.SetRotation(FQuat(-Rotation.X, -Rotation.Z, -Rotation.Y, Rotation.W).GetNormalized());
+            }
+
+            if (!Scales.IsEmpty())
+            {
+                Transform.SetScale3D((FVector)ConvertVector(Scales[InstanceIndex]));
+            }
+
+            const int32 InstanceNode = Out_Scene.Nodes.AddDefaulted();
+            Out_Scene.Nodes[InstanceNode].Name = FString::Printf(TEXT("%s_%d"), *BaseName, InstanceIndex);
+            Out_Scene.Nodes[InstanceNode].Parent = NodeIndex;
+            Out_Scene.Nodes[InstanceNode].Transform = Transform;
+            Out_Scene.Nodes[InstanceNode].Mesh = Mesh;
+            Out_Scene.Nodes[NodeIndex].Children.Add(InstanceNode);
+        }
+
+        return true;
+    }
+
+    static void ReadMaterial(const FJsonObject& Material, FMeshOps_ImportScene::FMaterial& Out_Material)
+    {
+        double Values[4];
+        FString AlphaMode;
+
+        Material.TryGetStringField(TEXT("name"), Out_Material.Name);
+        Material.TryGetBoolField(TEXT("doubleSided"), Out_Material.bIsTwoSided);
+
+        const TSharedPtr<FJsonObject>* PBR = nullptr;
+
+        if (Material.TryGetObjectField(TEXT("pbrMetallicRoughness"), PBR))
+        {
+            if (ReadNumbers(**PBR, TEXT("baseColorFactor"), Values, 4))
+            {
+                Out_Material.BaseColor = FLinearColor(Values[0], Values[1], Values[2], Values[3]);
+            }
+
+            (*PBR)->TryGetNumberField(TEXT("metallicFactor"), Out_Material.Metallic);
+            (*PBR)->TryGetNumberField(TEXT("roughnessFactor"), Out_Material.Roughness);
+        }
+
+        if (ReadNumbers(Material, TEXT("emissiveFactor"), Values, 3))
+        {
+            Out_Material.Emissive = FLinearColor(Values[0], Values[1], Values[2]);
+        }
+
+        if (Material.TryGetStringField(TEXT("alphaMode"), AlphaMode))
+        {
+            Out_Material.bIsTranslucent = AlphaMode == TEXT("BLEND");
+            Out_Material.bIsMasked = AlphaMode == TEXT("MASK");
+        }
+    }
+
+    static bool OpenDocument(const FString& ImportPath, FDocument& Out_Document, FString& Out_Error)
+    {
+        TUniquePtr<FFileData> File = MakeUnique<FFileData>();
+
+        if (!File->Open(ImportPath))
+        {
+            Out_Error = FString::Printf(TEXT("%s can't be opened."), *ImportPath);
+            return false;
+        }
+
+        const uint8* JsonData = File->Data;
+        int64 JsonLength = File->Size;
+
+        if (File->Size >= GLB_HEADER_SIZE && ReadUInt32(File->Data) == GLB_MAGIC)
+        {
+            const int64 Length = FMath::Min((int64)ReadUInt32(File->Data + 8), File->Size);
+            JsonData = nullptr;
+
+            if (ReadUInt32(File->Data + 4) != 2)
+            {
+                Out_Error = TEXT("Only glTF 2.0 binary files are supported.");
+                return false;
+            }
+
+            for (int64 Offset = GLB_HEADER_SIZE; Offset + GLB_CHUNK_HEADER_SIZE <= Length;)
+            {
+                const int64 ChunkLength = ReadUInt32(File->Data + Offset);
+                const uint32 ChunkType = ReadUInt32(File->Data + Offset + 4);
+                const uint8* ChunkData = File->Data + Offset + GLB_CHUNK_HEADER_SIZE;
+
+                if (Offset + GLB_CHUNK_HEADER_SIZE + ChunkLength > Length)
+                {
+                    Out_Error = TEXT("Binary file is truncated.");
+                    return false;
+                }
+
+                if (ChunkType == GLB_CHUNK_JSON && !JsonData)
+                {
+                    JsonData = ChunkData;
+                    JsonLength = ChunkLength;
+                }
+
+                else if (ChunkType == GLB_CHUNK_BIN && !Out_Document.BinaryChunk.Data)
+                {
+                    Out_Document.BinaryChunk.Data = ChunkData;
+                    Out_Document.BinaryChunk.Size = ChunkLength;
+                }
+
+                Offset += GLB_CHUNK_HEADER_SIZE + ChunkLength;
+            }
+
+            if (!JsonData)
+            {
+                Out_Error = TEXT("Binary file has no JSON chunk.");
+                return false;
+            }
+        }
+
+        // UTF-8 byte order mark isn't allowed by the specification, but some exporters write it.
+        if (JsonLength >= 3 && JsonData[0] == 0xEF && JsonData[1] == 0xBB && JsonData[2] == 0xBF)
+        {
+            JsonData += 3;
+            JsonLength -= 3;
+        }
+
+        const FUTF8ToTCHAR Converted((const ANSICHAR*)JsonData, (int32)JsonLength);
+        const FString Json(Converted.Length(), Converted.Get());
+        const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(Json);
+
+        if (!FJsonSerializer::Deserialize(Reader, Out_Document.Root) || !Out_Document.Root.IsValid())
+        {
+            Out_Error = FString::Printf(TEXT("JSON of %s can't be parsed."), *ImportPath);
+            return false;
+        }
+
+        Out_Document.Path = ImportPath;
+        Out_Document.Files.Add(MoveTemp(File));
+
+        return true;
+    }
+
+    static bool LoadBuffers(FDocument& Document, FString& Out_Error)
+    {
+        const FJsonArray* Buffers = nullptr;
+
+        if (!Document.Root->TryGetArrayField(TEXT("buffers"), Buffers))
+        {
+            return true;
+        }
+
+        for (int32 BufferIndex = 0; BufferIndex < Buffers->Num(); BufferIndex++)
+        {
+            const FJsonObject* Buffer = GetObject((*Buffers)[BufferIndex]);
+
+            if (!Buffer)
+            {
+                Out_Error = FString::Printf(TEXT("Buffer %d isn't an object."), BufferIndex);
+                return false;
+            }
+
+            FBufferData Data;
+            FString Uri;
+            int64 ByteLength = 0;
+
+            Buffer->TryGetNumberField(TEXT("byteLength"), ByteLength);
+
+            const TSharedPtr<FJsonObject>* Extensions = nullptr;
+            const TSharedPtr<FJsonObject>* Meshopt = nullptr;
+            bool bIsFallback = false;
+
+            if (!Buffer->TryGetStringField(TEXT("uri"), Uri) && Buffer->TryGetObjectField(TEXT("extensions"), Extensions) && (*Extensions)->TryGetObjectField(TEXT("EXT_meshopt_compression"), Meshopt) && (*Meshopt)->TryGetBoolField(TEXT("fallback"), bIsFallback) && bIsFallback)
+            {
+                Data.bIsFallback = true;
+                Document.Buffers.Add(Data);
+                continue;
+            }
+
+            if (Uri.IsEmpty())
+            {
+                // Only the first buffer of a binary file can refer to its binary chunk.
+                if (BufferIndex == 0)
+                {
+                    Data = Document.BinaryChunk;
+                }
+            }
+
+            else if (Uri.StartsWith(TEXT("data:")))
+            {
+                int32 Comma = INDEX_NONE;
+
+                if (!Uri.FindChar(TEXT(','), Comma) || !Uri.Left(Comma).EndsWith(TEXT(";base64")))
+                {
+                    Out_Error = FString::Printf(TEXT("Data URI of buffer %d isn't base64."), BufferIndex);
+                    return false;
+                }
+
+                TArray<uint8>& Decoded = Document.Decoded.AddDefaulted_GetRef();
+
+                if (!FBase64::Decode(Uri.Mid(Comma + 1), Decoded))
+                {
+                    Out_Error = FString::Printf(TEXT("Data URI of buffer %d can't be decoded."), BufferIndex);
+                    return false;
+                }
+
+                Data.Data = Decoded.GetData();
+                Data.Size = Decoded.Num();
+            }
+
+            else
+            {
+                const FString BufferPath = FPaths::Combine(FPaths::GetPath(Document.Path), Uri.Replace(TEXT("%20"), TEXT(" ")));
+                TUniquePtr<FFileData> File = MakeUnique<FFileData>();
+
+                if (!File->Open(BufferPath))
+                {
+                    Out_Error = FString::Printf(TEXT("Buffer file %s can't be opened."), *BufferPath);
+                    return false;
+                }
+
+                Data.Data = File->Data;
+                Data.Size = File->Size;
+                Document.Files.Add(MoveTemp(File));
+            }
+
+            if (!Data.Data || Data.Size < ByteLength)
+            {
+                Out_Error = FString::Printf(TEXT("Buffer %d is missing or shorter than its length."), BufferIndex);
+                return false;
+            }
+
+            Document.Buffers.Add(Data);
+        }
+
+        return true;
+    }
+}
+
+bool FMeshOps_GLTFReader::Read(const FString& ImportPath, float UniformScale, FMeshOps_ImportScene& Out_Scene, FString& Out_Error)
+{
+    using namespace MeshOps_GLTFReader_Private;
+
+    Out_Scene = FMeshOps_ImportScene();
+
+    FDocument Document;
+
+    if (!OpenDocument(ImportPath, Document, Out_Error))
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* Asset = nullptr;
+    FString Version;
+
+    if (!Document.Root->TryGetObjectField(TEXT("asset"), Asset) || !(*Asset)->TryGetStringField(TEXT("version"), Version) || !Version.StartsWith(TEXT("2")))
+    {
+        Out_Error = TEXT("Only glTF 2.0 files are supported.");
+        return false;
+    }
+
+    const FJsonArray* Required = nullptr;
+
+    if (Document.Root->TryGetArrayField(TEXT("extensionsRequired"), Required))
+    {
+        for (const TSharedPtr<FJsonValue>& Each_Extension : *Required)
+        {
+            // Quantized attributes are decoded by the generic accessor path. Instance attributes become child nodes.
+            FString Extension;
+
+            if (!Each_Extension.IsValid() || !Each_Extension->TryGetString(Extension))
+            {
+                Out_Error = TEXT("Required extensions have to be strings.");
+                return false;
+            }
+
+            if (Extension != TEXT("KHR_mesh_quantization") && Extension != TEXT("EXT_mesh_gpu_instancing"))
+            {
+                Out_Error = FString::Printf(TEXT("File requires %s extension which isn't supported."), *Extension);
+                return false;
+            }
+        }
+    }
+
+    if (!LoadBuffers(Document, Out_Error))
+    {
+        return false;
+    }
+
+    Document.Root->TryGetArrayField(TEXT("accessors"), Document.Accessors);
+    Document.Root->TryGetArrayField(TEXT("bufferViews"), Document.BufferViews);
+
+    const FJsonArray* Materials = nullptr;
+
+    if (Document.Root->TryGetArrayField(TEXT("materials"), Materials))
+    {
+        Out_Scene.Materials.SetNum(Materials->Num());
+
+        for (int32 MaterialIndex = 0; MaterialIndex < Materials->Num(); MaterialIndex++)
+        {
+            const FJsonObject* Material = GetObject((*Materials)[MaterialIndex]);
+
+            if (!Material)
+            {
+                Out_Error = FString::Printf(TEXT("Material %d isn't an object."), MaterialIndex);
+                return false;
+            }
+
+            ReadMaterial(*Material, Out_Scene.Materials[MaterialIndex]);
+        }
+    }
+
+    const FJsonArray* Meshes = nullptr;
+
+    if (Document.Root->TryGetArrayField(TEXT("meshes"), Meshes))
+    {
+        Out_Scene.Meshes.SetNum(Meshes->Num());
+
+        TArray<FString> Errors;
+        Errors.SetNum(Meshes->Num());
+
+        for (int32 MeshIndex = 0; MeshIndex < Meshes->Num(); MeshIndex++)
+        {
+            if (!GetObject((*Meshes)[MeshIndex]))
+            {
+                Out_Error = FString::Printf(TEXT("Mesh %d isn't an object."), MeshIndex);
+                return false;
+            }
+        }
+
+        // Meshes only read the mapped buffers, so they are decoded in parallel.
+        ParallelFor(Meshes->Num(), [&](int32 MeshIndex)
+            {
+                ReadMesh(Document, *GetObject((*Meshes)[MeshIndex]), UniformScale, Out_Scene.Meshes[MeshIndex], Errors[MeshIndex]);
+            });
+
+        for (int32 MeshIndex = 0; MeshIndex < Errors.Num(); MeshIndex++)
+        {
+            if (!Errors[MeshIndex].IsEmpty())
+            {
+                Out_Error = FString::Printf(TEXT("Mesh %d : %s"), MeshIndex, *Errors[MeshIndex]);
+                return false;
+            }
+
+            for (int32& Each_Material : Out_Scene.Meshes[MeshIndex].Materials)
+            {
+                Each_Material = Out_Scene.Materials.IsValidIndex(Each_Material) ? Each_Material : INDEX_NONE;
+            }
+
+            if (Out_Scene.Meshes[MeshIndex].Name.IsEmpty())
+            {
+                Out_Scene.Meshes[MeshIndex].Name = FString::Printf(TEXT("Mesh_%d"), MeshIndex);
+            }
+        }
+    }
+
+    const FJsonArray* Nodes = nullptr;
+
+    if (Document.Root->TryGetArrayField(TEXT("nodes"), Nodes))
+    {
+        const int32 NumNodes = Nodes->Num();
+        Out_Scene.Nodes.SetNum(NumNodes);
+
+        // Later passes only visit nodes which are checked here.
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+        {
+            if (!GetObject((*Nodes)[NodeIndex]))
+            {
+                Out_Error = FString::Printf(TEXT("Node %d isn't an object."), NodeIndex);
+                return false;
+            }
+
+            const FJsonObject& Node = *GetObject((*Nodes)[NodeIndex]);
+            FMeshOps_ImportScene::FNode& SceneNode = Out_Scene.Nodes[NodeIndex];
+
+            if (!Node.TryGetStringField(TEXT("name"), SceneNode.Name))
+            {
+                SceneNode.Name = FString::Printf(TEXT("Node_%d"), NodeIndex);
+            }
+
+            SceneNode.Transform = ReadNodeTransform(Node, UniformScale);
+
+            if (Node.TryGetNumberField(TEXT("mesh"), SceneNode.Mesh) && !Out_Scene.Meshes.IsValidIndex(SceneNode.Mesh))
+            {
+                SceneNode.Mesh = INDEX_NONE;
+            }
+        }
+
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+        {
+            const FJsonArray* Children = nullptr;
+
+            if (!GetObject((*Nodes)[NodeIndex])->TryGetArrayField(TEXT("children"), Children))
+            {
+                continue;
+            }
+
+            for (const TSharedPtr<FJsonValue>& Each_Child : *Children)
+            {
+                int32 ChildIndex = INDEX_NONE;
+
+                // Nodes with several parents can't be components.
+                if (!Each_Child.IsValid() || !Each_Child->TryGetNumber(ChildIndex) || !Out_Scene.Nodes.IsValidIndex(ChildIndex) || ChildIndex == NodeIndex || Out_Scene.Nodes[ChildIndex].Parent != INDEX_NONE)
+                {
+                    Out_Error = FString::Printf(TEXT("Node hierarchy isn't a tree at node %d."), NodeIndex);
+                    return false;
+                }
+
+                Out_Scene.Nodes[ChildIndex].Parent = NodeIndex;
+                Out_Scene.Nodes[NodeIndex].Children.Add(ChildIndex);
+            }
+        }
+
+        // Instance nodes are appended after file nodes, so indices of file nodes don't change.
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+        {
+            if (!AddInstanceNodes(Document, *GetObject((*Nodes)[NodeIndex]), NodeIndex, UniformScale, Out_Scene, Out_Error))
+            {
+                return false;
+            }
+        }
+
+        const FJsonArray* Scenes = nullptr;
+        const FJsonArray* SceneNodes = nullptr;
+        int32 SceneIndex = 0;
+        Document.Root->TryGetNumberField(TEXT("scene"), SceneIndex);
+
+        if (Document.Root->TryGetArrayField(TEXT("scenes"), Scenes) && Scenes->IsValidIndex(SceneIndex) && GetObject((*Scenes)[SceneIndex]) && GetObject((*Scenes)[SceneIndex])->TryGetArrayField(TEXT("nodes"), SceneNodes))
+        {
+            for (const TSharedPtr<FJsonValue>& Each_Root : *SceneNodes)
+            {
+                int32 RootIndex = INDEX_NONE;
+
+                if (Each_Root.IsValid() && Each_Root->TryGetNumber(RootIndex) && Out_Scene.Nodes.IsValidIndex(RootIndex) && Out_Scene.Nodes[RootIndex].Parent == INDEX_NONE)
+                {
+                    Out_Scene.RootNodes.AddUnique(RootIndex);
+                }
+            }
+        }
+
+        // Files without scenes show every node which has no parent.
+        else
+        {
+            for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+            {
+                if (Out_Scene.Nodes[NodeIndex].Parent == INDEX_NONE)
+                {
+                    Out_Scene.RootNodes.Add(NodeIndex);
+                }
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,1736 @@
+#include "MeshOps_GLTFWriter.h"
+
+#include "Algo/Count.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_Instancing.h"
+#include "MeshOps_MeshBuilder.h"
+#include "MeshOps_MeshCompression.h"
+
+#define GLTF_ARRAY_BUFFER 34962
+#define GLTF_ELEMENT_ARRAY_BUFFER 34963
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_FLOAT 5126
+
+#define GLB_MAGIC 0x46546C67
+#define GLB_CHUNK_JSON 0x4E4F534A
+#define GLB_CHUNK_BIN 0x004E4942
+
+// Binary chunk is copied with this block size when only JSON of a file changes.
+#define GLB_COPY_BLOCK_SIZE (4 * 1024 * 1024)
+
+// Meshes are converted and written in batches. Only one batch of converted data is in memory and progress and cancel are handled between batches.
+#define GLTF_CONVERT_BATCH_SIZE 32
+
+namespace MeshOps_GLTFWriter_Private
+{
+    typedef TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> FJsonWriterRef;
+
+    struct FMeshData
+    {
+        struct FPrimitive
+        {
+            uint32 FirstIndex = 0;
+            uint32 NumIndices = 0;
+
+            // Material slot of the static mesh. Scene material is resolved when the mesh is written, so converted data can be shared between scenes.
+            int32 Slot = 0;
+        };
+
+        TArray<FVector3f> Positions;
+        TArray<FVector3f> Normals;
+        TArray<FVector2f> UVs;
+        TArray<uint32> Indices;
+        TArray<FPrimitive> Primitives;
+
+        FVector3f Min = FVector3f(TNumericLimits<float>::Max());
+        FVector3f Max = FVector3f(TNumericLimits<float>::Lowest());
+
+        // EXT_meshopt_compression streams. Only filled if compression is enabled and every stream could be encoded.
+        TArray<uint8> Encoded_Positions;
+        TArray<uint8> Encoded_Normals;
+        TArray<uint8> Encoded_UVs;
+        TArray<TArray<uint8>> Encoded_Indices;
+        bool bIsCompressed = false;
+        double Encode_Time = 0;
+
+        bool bIsValid = false;
+
+        int64 GetAllocatedSize() const
+        {
+            int64 Size = this->Positions.GetAllocatedSize() + this->Normals.GetAllocatedSize() + this->UVs.GetAllocatedSize() + this->Indices.GetAllocatedSize();
+            Size += this->Encoded_Positions.GetAllocatedSize() + this->Encoded_Normals.GetAllocatedSize() + this->Encoded_UVs.GetAllocatedSize();
+
+            for (const TArray<uint8>& Each_Encoded : this->Encoded_Indices)
+            {
+                Size += Each_Encoded.GetAllocatedSize();
+            }
+
+            return Size;
+        }
+    };
+
+    // Static mesh, LOD, uniform scale and compression.
+    typedef TTuple<const UStaticMesh*, int32, float, bool> FMeshKey;
+
+    struct FBufferView
+    {
+        int32 Buffer = 0;
+        int64 ByteOffset = 0;
+        int64 ByteLength = 0;
+        int32 Target = 0;
+
+        // EXT_meshopt_compression. Buffer, offset and length above point to the fallback buffer which has no storage.
+        bool bIsCompressed = false;
+        int32 Compressed_Buffer = 0;
+        int64 Compressed_Offset = 0;
+        int64 Compressed_Length = 0;
+        int32 ByteStride = 0;
+        int32 Count = 0;
+    };
+
+    struct FAccessor
+    {
+        int32 BufferView = INDEX_NONE;
+        int32 ComponentType = GLTF_FLOAT;
+        int32 Count = 0;
+        const TCHAR* Type = TEXT("SCALAR");
+
+        bool bHasMinMax = false;
+        FVector3f Min = FVector3f::ZeroVector;
+        FVector3f Max = FVector3f::ZeroVector;
+    };
+
+    struct FMeshAccessors
+    {
+        int32 Position = INDEX_NONE;
+        int32 Normal = INDEX_NONE;
+        int32 UV = INDEX_NONE;
+
+        // Index accessor and material of each primitive.
+        TArray<int32> Indices;
+        TArray<int32> Materials;
+    };
+
+    // Leaf siblings with the same mesh, written as one EXT_mesh_gpu_instancing node.
+    struct FInstanceGroup
+    {
+        int32 Parent = INDEX_NONE;
+        int32 Mesh = INDEX_NONE;
+        TArray<int32> Nodes;
+
+        int32 Translation = INDEX_NONE;
+        int32 Rotation = INDEX_NONE;
+        int32 Scale = INDEX_NONE;
+    };
+
+    // glTF is right handed and Y up. Unreal is left handed and Z up. Swapping Y and Z converts between them and keeps triangle winding valid.
+    static FVector3f ConvertVector(const FVector3f& Vector)
+    {
+        return FVector3f(Vector.X, Vector.Z, Vector.Y);
+    }
+
+    static FQuat ConvertRotation(const FQuat& Rotation)
+    {
+        return FQuat(-Rotation.X, -Rotation.Z, -Rotation.Y, Rotation.W);
+    }
+
+    static void CompressMesh(FMeshData& Data)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        const bool bHasUVs = Data.UVs.Num() == Data.Positions.Num();
+
+        for (const FMeshData::FPrimitive& Each_Primitive : Data.Primitives)
+        {
+            FMeshOps_MeshCompression::OptimizeVertexCache(MakeArrayView(Data.Indices.GetData() + Each_Primitive.FirstIndex, Each_Primitive.NumIndices), Data.Positions.Num());
+        }
+
+        TArray<int32> NewToOld;
+        FMeshOps_MeshCompression::OptimizeVertexFetch(Data.Indices, Data.Positions.Num(), NewToOld);
+        FMeshOps_MeshCompression::RemapVertices(Data.Positions, NewToOld);
+        FMeshOps_MeshCompression::RemapVertices(Data.Normals, NewToOld);
+
+        if (bHasUVs)
+        {
+            FMeshOps_MeshCompression::RemapVertices(Data.UVs, NewToOld);
+        }
+
+        const int32 NumVertices = Data.Positions.Num();
+        bool bIsEncoded = FMeshOps_MeshCompression::EncodeVertexBuffer(Data.Positions.GetData(), NumVertices, sizeof(FVector3f), Data.Encoded_Positions);
+        bIsEncoded &= FMeshOps_MeshCompression::EncodeVertexBuffer(Data.Normals.GetData(), NumVertices, sizeof(FVector3f), Data.Encoded_Normals);
+        bIsEncoded &= !bHasUVs || FMeshOps_MeshCompression::EncodeVertexBuffer(Data.UVs.GetData(), NumVertices, sizeof(FVector2f), Data.Encoded_UVs);
+
+        Data.Encoded_Indices.SetNum(Data.Primitives.Num());
+
+        for (int32 PrimitiveIndex = 0; PrimitiveIndex < Data.Primitives.Num(); PrimitiveIndex++)
+        {
+            const FMeshData::FPrimitive& Primitive = Data.Primitives[PrimitiveIndex];
+            bIsEncoded &= FMeshOps_MeshCompression::EncodeIndexBuffer(MakeArrayView(Data.Indices.GetData() + Primitive.FirstIndex, Primitive.NumIndices), NumVertices, Data.Encoded_Indices[PrimitiveIndex]);
+        }
+
+        // Reordered geometry is still valid, so a failed stream only means this mesh is written raw.
+        Data.bIsCompressed = bIsEncoded;
+        Data.Encode_Time = FPlatformTime::Seconds() - StartTime;
+    }
+
+    static bool ConvertMesh(const FMeshOps_ExportScene::FMesh& Mesh, float UniformScale, bool bCompress, FMeshData& Out_Data)
+    {
+        FMeshOps_MeshBuffers Buffers;
+
+        // Requested LOD may not exist on every mesh.
+        if (!FMeshOps_MeshBuilder::ReadStaticMesh(Mesh.StaticMesh, Mesh.LOD_Index, Buffers) && (Mesh.LOD_Index == 0 || !FMeshOps_MeshBuilder::ReadStaticMesh(Mesh.StaticMesh, 0, Buffers)))
+        {
+            return false;
+        }
+
+        const int32 NumVertices = Buffers.GetNumVertices();
+        Out_Data.Positions.SetNumUninitialized(NumVertices);
+        Out_Data.Normals.SetNumUninitialized(NumVertices);
+        Out_Data.UVs = MoveTemp(Buffers.UVs);
+        Out_Data.Indices = MoveTemp(Buffers.Indices);
+
+        for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+        {
+            Out_Data.Positions[VertexIndex] = ConvertVector(Buffers.Positions[VertexIndex] * UniformScale);
+            Out_Data.Normals[VertexIndex] = ConvertVector(Buffers.Normals[VertexIndex]).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+        }
+
+        for (const FMeshOps_MeshBuffers::FSection& Each_Section : Buffers.Sections)
+        {
+            if (Each_Section.NumTriangles == 0)
+            {
+                continue;
+            }
+
+            FMeshData::FPrimitive& Primitive = Out_Data.Primitives.AddDefaulted_GetRef();
+            Primitive.FirstIndex = Each_Section.FirstIndex;
+            Primitive.NumIndices = Each_Section.NumTriangles * 3;
+            Primitive.Slot = Each_Section.MaterialIndex;
+        }
+
+        Out_Data.bIsValid = NumVertices > 0 && !Out_Data.Primitives.IsEmpty();
+
+        if (Out_Data.bIsValid && bCompress)
+        {
+            CompressMesh(Out_Data);
+        }
+
+        // Compression drops unused vertices, so bounds are computed afterwards.
+        for (const FVector3f& Each_Position : Out_Data.Positions)
+        {
+            Out_Data.Min = Out_Data.Min.ComponentMin(Each_Position);
+            Out_Data.Max = Out_Data.Max.ComponentMax(Each_Position);
+        }
+
+        return Out_Data.bIsValid;
+    }
+
+    /*
+    * Writes buffer views straight to disk as they are added. Only descriptions of views and accessors stay in memory.
+    * A new buffer file is started when current one would exceed max buffer size.
+    */
+    class FBinaryStream
+    {
+
+    public:
+
+        struct FBuffer
+        {
+            FString Path;
+            int64 ByteLength = 0;
+
+            // First buffer of a GLB is its BIN chunk. It is staged in a temp file until JSON is ready.
+            bool bIsEmbedded = false;
+        };
+
+        TArray<FBuffer> Buffers;
+        TArray<FBufferView> BufferViews;
+        TArray<FAccessor> Accessors;
+        bool bHasError = false;
+
+        // Size of views before compression and size of the virtual fallback buffer of compressed views.
+        int64 Raw_Size = 0;
+        int64 Fallback_Length = 0;
+
+    private:
+
+        TUniquePtr<FArchive> Writer;
+        FString ExportPath;
+        bool bIsBinary = false;
+        int64 MaxBufferSize = 0;
+
+        bool OpenBuffer()
+        {
+            this->Close();
+
+            const int32 BufferIndex = this->Buffers.Num();
+            FBuffer& Buffer = this->Buffers.AddDefaulted_GetRef();
+            Buffer.bIsEmbedded = this->bIsBinary && BufferIndex == 0;
+
+            if (Buffer.bIsEmbedded)
+            {
+                Buffer.Path = this->ExportPath + TEXT(".bin.tmp");
+            }
+
+            else if (BufferIndex == 0)
+            {
+                Buffer.Path = FPaths::ChangeExtension(this->ExportPath, TEXT("bin"));
+            }
+
+            else
+            {
+                Buffer.Path = FString::Printf(TEXT("%s_%d.bin"), *FPaths::GetBaseFilename(this->ExportPath, false), BufferIndex);
+            }
+
+            this->Writer.Reset(IFileManager::Get().CreateFileWriter(*Buffer.Path));
+            return this->Writer.IsValid();
+        }
+
+    public:
+
+        FBinaryStream(const FString& In_ExportPath, bool In_bIsBinary, int64 In_MaxBufferSize) : ExportPath(In_ExportPath), bIsBinary(In_bIsBinary), MaxBufferSize(In_MaxBufferSize)
+        {
+        }
+
+        ~FBinaryStream()
+        {
+            this->Close();
+        }
+
+        bool Close()
+        {
+            if (this->Writer)
+            {
+                this->bHasError |= !this->Writer->Close() || this->Writer->IsError();
+                this->Writer.Reset();
+            }
+
+            return !this->bHasError;
+        }
+
+        void DeleteFiles()
+        {
+            this->Close();
+
+            for (const FBuffer& Each_Buffer : this->Buffers)
+            {
+                IFileManager::Get().Delete(*Each_Buffer.Path, false, false, true);
+            }
+        }
+
+        bool WriteBytes(const void* Source, int64 ByteLength, int32& Out_Buffer, int64& Out_Offset)
+        {
+            const bool bIsFull = !this->Buffers.IsEmpty() && this->MaxBufferSize > 0 && this->Buffers.Last().ByteLength > 0 && Align(this->Buffers.Last().ByteLength, 4) + ByteLength > this->MaxBufferSize;
+
+            if ((this->Buffers.IsEmpty() || bIsFull) && !this->OpenBuffer())
+            {
+                this->bHasError = true;
+            }
+
+            if (this->bHasError)
+            {
+                return false;
+            }
+
+            // Every accessor type we write is 4 byte aligned, except 16 bit indices which need 2.
+            static const uint8 Padding[4] = { 0 };
+
+            FBuffer& Buffer = this->Buffers.Last();
+            Out_Buffer = this->Buffers.Num() - 1;
+            Out_Offset = Align(Buffer.ByteLength, 4);
+
+            this->Writer->Serialize(const_cast<uint8*>(Padding), Out_Offset - Buffer.ByteLength);
+            this->Writer->Serialize(const_cast<void*>(Source), ByteLength);
+            Buffer.ByteLength = Out_Offset + ByteLength;
+
+            return true;
+        }
+
+        int32 AddBufferView(const void* Source, int64 ByteLength, int32 Target)
+        {
+            FBufferView View;
+            View.ByteLength = ByteLength;
+            View.Target = Target;
+
+            if (!this->WriteBytes(Source, ByteLength, View.Buffer, View.ByteOffset))
+            {
+                return INDEX_NONE;
+            }
+
+            this->Raw_Size += ByteLength;
+            return this->BufferViews.Add(View);
+        }
+
+        int32 AddCompressedView(const TArray<uint8>& Encoded, int64 RawLength, int32 ByteStride, int32 Count, int32 Target)
+        {
+            FBufferView View;
+            View.bIsCompressed = true;
+            View.ByteStride = ByteStride;
+            View.Count = Count;
+            View.Target = Target;
+            View.Compressed_Length = Encoded.Num();
+
+            if (!this->WriteBytes(Encoded.GetData(), Encoded.Num(), View.Compressed_Buffer, View.Compressed_Offset))
+            {
+                return INDEX_NONE;
+            }
+
+            View.ByteOffset = Align(this->Fallback_Length, 4);
+            View.ByteLength = RawLength;
+            this->Fallback_Length = View.ByteOffset + RawLength;
+            this->Raw_Size += RawLength;
+
+            return this->BufferViews.Add(View);
+        }
+
+        int64 GetWrittenSize() const
+        {
+            int64 Size = 0;
+
+            for (const FBuffer& Each_Buffer : this->Buffers)
+            {
+                Size += Each_Buffer.ByteLength;
+            }
+
+            return Size;
+        }
+
+        int32 AddAccessor(int32 BufferView, int32 ComponentType, int32 Count, const TCHAR* Type)
+        {
+            FAccessor& Accessor = this->Accessors.AddDefaulted_GetRef();
+            Accessor.BufferView = BufferView;
+            Accessor.ComponentType = ComponentType;
+            Accessor.Count = Count;
+            Accessor.Type = Type;
+
+            return this->Accessors.Num() - 1;
+        }
+    };
+
+    static void AddMeshData(const FMeshOps_ExportScene::FMesh& Mesh, const FMeshData& MeshData, FBinaryStream& Buffer, FMeshAccessors& Out_Accessors)
+    {
+        const int32 NumVertices = MeshData.Positions.Num();
+        const bool bIsCompressed = MeshData.bIsCompressed;
+
+        auto AddVertexView = [&Buffer, NumVertices, bIsCompressed](const void* Source, int32 VertexSize, const TArray<uint8>& Encoded)
+            {
+                return bIsCompressed ? Buffer.AddCompressedView(Encoded, (int64)NumVertices * VertexSize, VertexSize, NumVertices, GLTF_ARRAY_BUFFER) : Buffer.AddBufferView(Source, (int64)NumVertices * VertexSize, GLTF_ARRAY_BUFFER);
+            };
+
+        Out_Accessors.Position = Buffer.AddAccessor(AddVertexView(MeshData.Positions.GetData(), sizeof(FVector3f), MeshData.Encoded_Positions), GLTF_FLOAT, NumVertices, TEXT("VEC3"));
+        Buffer.Accessors[Out_Accessors.Position].bHasMinMax = true;
+        Buffer.Accessors[Out_Accessors.Position].Min = MeshData.Min;
+        Buffer.Accessors[Out_Accessors.Position].Max = MeshData.Max;
+
+        Out_Accessors.Normal = Buffer.AddAccessor(AddVertexView(MeshData.Normals.GetData(), sizeof(FVector3f), MeshData.Encoded_Normals), GLTF_FLOAT, NumVertices, TEXT("VEC3"));
+
+        if (MeshData.UVs.Num() == NumVertices)
+        {
+            Out_Accessors.UV = Buffer.AddAccessor(AddVertexView(MeshData.UVs.GetData(), sizeof(FVector2f), MeshData.Encoded_UVs), GLTF_FLOAT, NumVertices, TEXT("VEC2"));
+        }
+
+        // Each primitive has its own index view, so small meshes use 16 bit indices.
+        const bool bUseShortIndices = NumVertices <= MAX_uint16;
+        const int32 IndexSize = bUseShortIndices ? sizeof(uint16) : sizeof(uint32);
+
+        for (int32 PrimitiveIndex = 0; PrimitiveIndex < MeshData.Primitives.Num(); PrimitiveIndex++)
+        {
+            const FMeshData::FPrimitive& Primitive = MeshData.Primitives[PrimitiveIndex];
+            const uint32* Source = MeshData.Indices.GetData() + Primitive.FirstIndex;
+            int32 View = INDEX_NONE;
+
+            // Index codec output is decoded to the byte stride of the view, so the same stream serves both index sizes.
+            if (bIsCompressed)
+            {
+                View = Buffer.AddCompressedView(MeshData.Encoded_Indices[PrimitiveIndex], (int64)Primitive.NumIndices * IndexSize, IndexSize, Primitive.NumIndices, GLTF_ELEMENT_ARRAY_BUFFER);
+            }
+
+            else if (bUseShortIndices)
+            {
+                TArray<uint16> ShortIndices;
+                ShortIndices.SetNumUninitialized(Primitive.NumIndices);
+
+                for (uint32 Index = 0; Index < Primitive.NumIndices; Index++)
+                {
+                    ShortIndices[Index] = (uint16)Source[Index];
+                }
+
+                View = Buffer.AddBufferView(ShortIndices.GetData(), ShortIndices.Num() * sizeof(uint16), GLTF_ELEMENT_ARRAY_BUFFER);
+            }
+
+            else
+            {
+                View = Buffer.AddBufferView(Source, Primitive.NumIndices * sizeof(uint32), GLTF_ELEMENT_ARRAY_BUFFER);
+            }
+
+            Out_Accessors.Indices.Add(Buffer.AddAccessor(View, bUseShortIndices ? GLTF_UNSIGNED_SHORT : GLTF_UNSIGNED_INT, Primitive.NumIndices, TEXT("SCALAR")));
+            Out_Accessors.Materials.Add(Mesh.Materials.IsValidIndex(Primitive.Slot) ? Mesh.Materials[Primitive.Slot] : INDEX_NONE);
+        }
+    }
+
+    static void AddInstanceGroups(const FMeshOps_ExportScene& Scene, const TArray<int32>& MeshMap, float UniformScale, FBinaryStream& Buffer, TArray<FInstanceGroup>& Out_Groups, TArray<int32>& Out_NodeMap)
+    {
+        TMap<TPair<int32, int32>, int32> GroupIndices;
+
+        for (int32 NodeIndex = 0; NodeIndex < Scene.Nodes.Num(); NodeIndex++)
+        {
+            const FMeshOps_ExportScene::FNode& Node = Scene.Nodes[NodeIndex];
+
+            // Root nodes keep their world transforms and nodes with children can't be flattened.
+            if (Node.Parent == INDEX_NONE || !Node.Children.IsEmpty() || !MeshMap.IsValidIndex(Node.Mesh) || MeshMap[Node.Mesh] == INDEX_NONE)
+            {
+                continue;
+            }
+
+            int32& GroupIndex = GroupIndices.FindOrAdd(TPair<int32, int32>(Node.Parent, Node.Mesh), INDEX_NONE);
+
+            if (GroupIndex == INDEX_NONE)
+            {
+                GroupIndex = Out_Groups.AddDefaulted();
+                Out_Groups[GroupIndex].Parent = Node.Parent;
+                Out_Groups[GroupIndex].Mesh = Node.Mesh;
+            }
+
+            Out_Groups[GroupIndex].Nodes.Add(NodeIndex);
+        }
+
+        Out_Groups.RemoveAll([](const FInstanceGroup& Each_Group) { return Each_Group.Nodes.Num() < 2; });
+
+        Out_NodeMap.SetNumUninitialized(Scene.Nodes.Num());
+
+        for (int32 NodeIndex = 0; NodeIndex < Scene.Nodes.Num(); NodeIndex++)
+        {
+            Out_NodeMap[NodeIndex] = NodeIndex;
+        }
+
+        for (const FInstanceGroup& Each_Group : Out_Groups)
+        {
+            for (const int32 Each_Node : Each_Group.Nodes)
+            {
+                Out_NodeMap[Each_Node] = INDEX_NONE;
+            }
+        }
+
+        int32 NumKept = 0;
+
+        for (int32& Each_Index : Out_NodeMap)
+        {
+            if (Each_Index != INDEX_NONE)
+            {
+                Each_Index = NumKept++;
+            }
+        }
+
+        for (FInstanceGroup& Each_Group : Out_Groups)
+        {
+            const int32 NumInstances = Each_Group.Nodes.Num();
+
+            TArray<FVector3f> Translations;
+            TArray<FVector4f> Rotations;
+            TArray<FVector3f> Scales;
+            Translations.Reserve(NumInstances);
+            Rotations.Reserve(NumInstances);
+            Scales.Reserve(NumInstances);
+
+            for (const int32 Each_Node : Each_Group.Nodes)
+            {
+                const FTransform& Transform = Scene.Nodes[Each_Node].Transform;
+                const FQuat Rotation = ConvertRotation(Transform.GetRotation().GetNormalized());
+
+                Translations.Add(ConvertVector((FVector3f)(Transform.GetLocation() * UniformScale)));
+                Rotations.Add(FVector4f(Rotation.X, Rotation.Y, Rotation.Z, Rotation.W));
+                Scales.Add(ConvertVector((FVector3f)Transform.GetScale3D()));
+            }
+
+            // Instance attributes aren't vertex data, so their views have no target.
+            Each_Group.Translation = Buffer.AddAccessor(Buffer.AddBufferView(Translations.GetData(), NumInstances * sizeof(FVector3f), 0), GLTF_FLOAT, NumInstances, TEXT("VEC3"));
+            Each_Group.Rotation = Buffer.AddAccessor(Buffer.AddBufferView(Rotations.GetData(), NumInstances * sizeof(FVector4f), 0), GLTF_FLOAT, NumInstances, TEXT("VEC4"));
+            Each_Group.Scale = Buffer.AddAccessor(Buffer.AddBufferView(Scales.GetData(), NumInstances * sizeof(FVector3f), 0), GLTF_FLOAT, NumInstances, TEXT("VEC3"));
+        }
+    }
+
+    static void WriteNumbers(FJsonWriterRef& Writer, const TCHAR* Identifier, std::initializer_list<double> Values)
+    {
+        Writer->WriteArrayStart(Identifier);
+
+        for (const double Each_Value : Values)
+        {
+            Writer->WriteValue(Each_Value);
+        }
+
+        Writer->WriteArrayEnd();
+    }
+
+    static void WriteNode(FJsonWriterRef& Writer, const FMeshOps_ExportScene::FNode& Node, TArrayView<const int32> Children, const TArray<int32>& MeshMap, float UniformScale, bool bSkipDefaults)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), Node.Name);
+
+        const FVector3f Translation = ConvertVector((FVector3f)(Node.Transform.GetLocation() * UniformScale));
+        const FQuat Rotation = ConvertRotation(Node.Transform.GetRotation().GetNormalized());
+        const FVector3f Scale = ConvertVector((FVector3f)Node.Transform.GetScale3D());
+
+        if (!bSkipDefaults || !Translation.IsNearlyZero())
+        {
+            WriteNumbers(Writer, TEXT("translation"), { Translation.X, Translation.Y, Translation.Z });
+        }
+
+        if (!bSkipDefaults || !Rotation.Equals(FQuat::Identity))
+        {
+            WriteNumbers(Writer, TEXT("rotation"), { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W });
+        }
+
+        if (!bSkipDefaults || !Scale.Equals(FVector3f::OneVector))
+        {
+            WriteNumbers(Writer, TEXT("scale"), { Scale.X, Scale.Y, Scale.Z });
+        }
+
+        if (MeshMap.IsValidIndex(Node.Mesh) && MeshMap[Node.Mesh] != INDEX_NONE)
+        {
+            Writer->WriteValue(TEXT("mesh"), MeshMap[Node.Mesh]);
+        }
+
+        if (!Children.IsEmpty())
+        {
+            Writer->WriteArrayStart(TEXT("children"));
+
+            for (const int32 Each_Child : Children)
+            {
+                Writer->WriteValue(Each_Child);
+            }
+
+            Writer->WriteArrayEnd();
+        }
+
+        Writer->WriteObjectEnd();
+    }
+
+    static void WriteMaterial(FJsonWriterRef& Writer, const FMeshOps_ExportScene::FMaterial& Material)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), Material.Name);
+
+        Writer->WriteObjectStart(TEXT("pbrMetallicRoughness"));
+        WriteNumbers(Writer, TEXT("baseColorFactor"), { Material.BaseColor.R, Material.BaseColor.G, Material.BaseColor.B, Material.bIsTranslucent ? FMath::Clamp(Material.BaseColor.A, 0.f, 1.f) : 1.0 });
+        Writer->WriteValue(TEXT("metallicFactor"), FMath::Clamp(Material.Metallic, 0.f, 1.f));
+        Writer->WriteValue(TEXT("roughnessFactor"), FMath::Clamp(Material.Roughness, 0.f, 1.f));
+        Writer->WriteObjectEnd();
+
+        if (!Material.Emissive.IsAlmostBlack())
+        {
+            WriteNumbers(Writer, TEXT("emissiveFactor"), { FMath::Clamp(Material.Emissive.R, 0.f, 1.f), FMath::Clamp(Material.Emissive.G, 0.f, 1.f), FMath::Clamp(Material.Emissive.B, 0.f, 1.f) });
+        }
+
+        if (Material.bIsTranslucent || Material.bIsMasked)
+        {
+            Writer->WriteValue(TEXT("alphaMode"), Material.bIsTranslucent ? TEXT("BLEND") : TEXT("MASK"));
+        }
+
+        if (Material.bIsTwoSided)
+        {
+            Writer->WriteValue(TEXT("doubleSided"), true);
+        }
+
+        Writer->WriteObjectEnd();
+    }
+
+    static FString MakeJson(const FMeshOps_ExportScene& Scene, const TArray<FMeshAccessors>& MeshAccessors, const TArray<int32>& MeshMap, const TArray<FInstanceGroup>& Groups, const TArray<int32>& NodeMap, const FBinaryStream& Buffer, float UniformScale, bool bSkipDefaults)
+    {
+        FString Json;
+        FJsonWriterRef Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+        Writer->WriteObjectStart();
+
+        Writer->WriteObjectStart(TEXT("asset"));
+        Writer->WriteValue(TEXT("version"), TEXT("2.0"));
+        Writer->WriteValue(TEXT("generator"), TEXT("Frozen Forest Mesh Operations"));
+        Writer->WriteObjectEnd();
+
+        // Instancing is required, because a viewer without it would show only one instance.
+        // Compressed views always have a fallback buffer, so loaders without meshopt can still open the file and skip its geometry.
+        TArray<const TCHAR*> Used_Extensions;
+        TArray<const TCHAR*> Required_Extensions;
+
+        if (Buffer.Fallback_Length > 0)
+        {
+            Used_Extensions.Add(TEXT("EXT_meshopt_compression"));
+        }
+
+        if (!Groups.IsEmpty())
+        {
+            Used_Extensions.Add(TEXT("EXT_mesh_gpu_instancing"));
+            Required_Extensions.Add(TEXT("EXT_mesh_gpu_instancing"));
+        }
+
+        for (const TPair<const TCHAR*, const TArray<const TCHAR*>*> Each_Field : { TPair<const TCHAR*, const TArray<const TCHAR*>*>(TEXT("extensionsUsed"), &Used_Extensions), TPair<const TCHAR*, const TArray<const TCHAR*>*>(TEXT("extensionsRequired"), &Required_Extensions) })
+        {
+            if (Each_Field.Value->IsEmpty())
+            {
+                continue;
+            }
+
+            Writer->WriteArrayStart(Each_Field.Key);
+
+            for (const TCHAR* Each_Extension : *Each_Field.Value)
+            {
+                Writer->WriteValue(Each_Extension);
+            }
+
+            Writer->WriteArrayEnd();
+        }
+
+        Writer->WriteValue(TEXT("scene"), 0);
+        Writer->WriteArrayStart(TEXT("scenes"));
+        Writer->WriteObjectStart();
+        Writer->WriteArrayStart(TEXT("nodes"));
+
+        for (const int32 Each_Root : Scene.RootNodes)
+        {
+            Writer->WriteValue(NodeMap[Each_Root]);
+        }
+
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->WriteArrayEnd();
+
+        Writer->WriteArrayStart(TEXT("nodes"));
+
+        // Instance group nodes come after kept nodes.
+        const int32 NumKept = Scene.Nodes.Num() - Algo::Count(NodeMap, INDEX_NONE);
+        TMultiMap<int32, int32> GroupsOfParent;
+
+        for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); GroupIndex++)
+        {
+            GroupsOfParent.Add(Groups[GroupIndex].Parent, NumKept + GroupIndex);
+        }
+
+        TArray<int32> Children;
+
+        for (int32 NodeIndex = 0; NodeIndex < Scene.Nodes.Num(); NodeIndex++)
+        {
+            if (NodeMap[NodeIndex] == INDEX_NONE)
+            {
+                continue;
+            }
+
+            Children.Reset();
+
+            for (const int32 Each_Child : Scene.Nodes[NodeIndex].Children)
+            {
+                if (NodeMap[Each_Child] != INDEX_NONE)
+                {
+                    Children.Add(NodeMap[Each_Child]);
+                }
+            }
+
+            GroupsOfParent.MultiFind(NodeIndex, Children, true);
+            WriteNode(Writer, Scene.Nodes[NodeIndex], Children, MeshMap, UniformScale, bSkipDefaults);
+        }
+
+        for (const FInstanceGroup& Each_Group : Groups)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("name"), FString::Printf(TEXT("%s_Instances"), *Scene.Meshes[Each_Group.Mesh].Name));
+            Writer->WriteValue(TEXT("mesh"), MeshMap[Each_Group.Mesh]);
+            Writer->WriteObjectStart(TEXT("extensions"));
+            Writer->WriteObjectStart(TEXT("EXT_mesh_gpu_instancing"));
+            Writer->WriteObjectStart(TEXT("attributes"));
+            Writer->WriteValue(TEXT("TRANSLATION"), Each_Group.Translation);
+            Writer->WriteValue(TEXT("ROTATION"), Each_Group.Rotation);
+            Writer->WriteValue(TEXT("SCALE"), Each_Group.Scale);
+            Writer->WriteObjectEnd();
+            Writer->WriteObjectEnd();
+            Writer->WriteObjectEnd();
+            Writer->WriteObjectEnd();
+        }
+
+        Writer->WriteArrayEnd();
+
+        if (!MeshAccessors.IsEmpty())
+        {
+            Writer->WriteArrayStart(TEXT("meshes"));
+
+            for (int32 MeshIndex = 0; MeshIndex < Scene.Meshes.Num(); MeshIndex++)
+            {
+                if (MeshMap[MeshIndex] == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const FMeshAccessors& Accessors = MeshAccessors[MeshMap[MeshIndex]];
+
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("name"), Scene.Meshes[MeshIndex].Name);
+                Writer->WriteArrayStart(TEXT("primitives"));
+
+                for (int32 PrimitiveIndex = 0; PrimitiveIndex < Accessors.Indices.Num(); PrimitiveIndex++)
+                {
+                    Writer->WriteObjectStart();
+                    Writer->WriteObjectStart(TEXT("attributes"));
+                    Writer->WriteValue(TEXT("POSITION"), Accessors.Position);
+                    Writer->WriteValue(TEXT("NORMAL"), Accessors.Normal);
+
+                    if (Accessors.UV != INDEX_NONE)
+                    {
+                        Writer->WriteValue(TEXT("TEXCOORD_0"), Accessors.UV);
+                    }
+
+                    Writer->WriteObjectEnd();
+                    Writer->WriteValue(TEXT("indices"), Accessors.Indices[PrimitiveIndex]);
+
+                    if (Accessors.Materials[PrimitiveIndex] != INDEX_NONE)
+                    {
+                        Writer->WriteValue(TEXT("material"), Accessors.Materials[PrimitiveIndex]);
+                    }
+
+                    Writer->WriteObjectEnd();
+                }
+
+                Writer->WriteArrayEnd();
+                Writer->WriteObjectEnd();
+            }
+
+            Writer->WriteArrayEnd();
+        }
+
+        if (!Scene.Materials.IsEmpty())
+        {
+            Writer->WriteArrayStart(TEXT("materials"));
+
+            for (const FMeshOps_ExportScene::FMaterial& Each_Material : Scene.Materials)
+            {
+                WriteMaterial(Writer, Each_Material);
+            }
+
+            Writer->WriteArrayEnd();
+        }
+
+        if (!Buffer.Buffers.IsEmpty())
+        {
+            Writer->WriteArrayStart(TEXT("accessors"));
+
+            for (const FAccessor& Each_Accessor : Buffer.Accessors)
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("bufferView"), Each_Accessor.BufferView);
+                Writer->WriteValue(TEXT("componentType"), Each_Accessor.ComponentType);
+                Writer->WriteValue(TEXT("count"), Each_Accessor.Count);
+                Writer->WriteValue(TEXT("type"), Each_Accessor.Type);
+
+                if (Each_Accessor.bHasMinMax)
+                {
+                    WriteNumbers(Writer, TEXT("min"), { Each_Accessor.Min.X, Each_Accessor.Min.Y, Each_Accessor.Min.Z });
+                    WriteNumbers(Writer, TEXT("max"), { Each_Accessor.Max.X, Each_Accessor.Max.Y, Each_Accessor.Max.Z });
+                }
+
+                Writer->WriteObjectEnd();
+            }
+
+            Writer->WriteArrayEnd();
+
+            Writer->WriteArrayStart(TEXT("bufferViews"));
+
+            for (const FBufferView& Each_View : Buffer.BufferViews)
+            {
+                // Fallback buffer is written after real buffers.
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("buffer"), Each_View.bIsCompressed ? Buffer.Buffers.Num() : Each_View.Buffer);
+                Writer->WriteValue(TEXT("byteOffset"), Each_View.ByteOffset);
+                Writer->WriteValue(TEXT("byteLength"), Each_View.ByteLength);
+
+                if (Each_View.Target != 0)
+                {
+                    Writer->WriteValue(TEXT("target"), Each_View.Target);
+                }
+
+                if (Each_View.bIsCompressed)
+                {
+                    const bool bIsIndices = Each_View.Target == GLTF_ELEMENT_ARRAY_BUFFER;
+
+                    if (!bIsIndices)
+                    {
+                        Writer->WriteValue(TEXT("byteStride"), Each_View.ByteStride);
+                    }
+
+                    Writer->WriteObjectStart(TEXT("extensions"));
+                    Writer->WriteObjectStart(TEXT("EXT_meshopt_compression"));
+                    Writer->WriteValue(TEXT("buffer"), Each_View.Compressed_Buffer);
+                    Writer->WriteValue(TEXT("byteOffset"), Each_View.Compressed_Offset);
+                    Writer->WriteValue(TEXT("byteLength"), Each_View.Compressed_Length);
+                    Writer->WriteValue(TEXT("byteStride"), Each_View.ByteStride);
+                    Writer->WriteValue(TEXT("mode"), bIsIndices ? TEXT("TRIANGLES") : TEXT("ATTRIBUTES"));
+                    Writer->WriteValue(TEXT("count"), Each_View.Count);
+                    Writer->WriteObjectEnd();
+                    Writer->WriteObjectEnd();
+                }
+
+                Writer->WriteObjectEnd();
+            }
+
+            Writer->WriteArrayEnd();
+
+            Writer->WriteArrayStart(TEXT("buffers"));
+
+            for (const FBinaryStream::FBuffer& Each_Buffer : Buffer.Buffers)
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("byteLength"), Each_Buffer.ByteLength);
+
+                if (!Each_Buffer.bIsEmbedded)
+                {
+                    Writer->WriteValue(TEXT("uri"), FPaths::GetCleanFilename(Each_Buffer.Path));
+                }
+
+                Writer->WriteObjectEnd();
+            }
+
+            if (Buffer.Fallback_Length > 0)
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("byteLength"), Buffer.Fallback_Length);
+                Writer->WriteObjectStart(TEXT("extensions"));
+                Writer->WriteObjectStart(TEXT("EXT_meshopt_compression"));
+                Writer->WriteValue(TEXT("fallback"), true);
+                Writer->WriteObjectEnd();
+                Writer->WriteObjectEnd();
+                Writer->WriteObjectEnd();
+            }
+
+            Writer->WriteArrayEnd();
+        }
+
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        return Json;
+    }
+
+    static void CopyBlocks(FArchive& Reader, FArchive& Writer, int64 Size)
+    {
+        TArray<uint8> Block;
+        Block.SetNumUninitialized((int32)FMath::Min<int64>(Size, GLB_COPY_BLOCK_SIZE));
+
+        for (int64 Copied = 0; Copied < Size; Copied += Block.Num())
+        {
+            const int32 BlockSize = (int32)FMath::Min<int64>(Size - Copied, Block.Num());
+            Reader.Serialize(Block.GetData(), BlockSize);
+            Writer.Serialize(Block.GetData(), BlockSize);
+        }
+    }
+
+    static void WriteJsonChunk(FArchive& Writer, const FTCHARToUTF8& JsonUTF8, uint32 JsonLength)
+    {
+        uint32 JsonHeader[2] = { JsonLength, GLB_CHUNK_JSON };
+        Writer.Serialize(JsonHeader, sizeof(JsonHeader));
+        Writer.Serialize((void*)JsonUTF8.Get(), JsonUTF8.Length());
+
+        // Chunks are 4 byte aligned. JSON is padded with spaces and binary with zeros.
+        for (uint32 Padding = JsonUTF8.Length(); Padding < JsonLength; Padding++)
+        {
+            uint8 Space = ' ';
+            Writer.Serialize(&Space, 1);
+        }
+    }
+
+    // Binary chunk is copied from the staged buffer file, so it is never fully loaded.
+    static bool WriteGLB(const FString& ExportPath, const FString& Json, const FBinaryStream::FBuffer* Embedded)
+    {
+        const FTCHARToUTF8 JsonUTF8(*Json);
+
+        const uint32 JsonLength = Align((uint32)JsonUTF8.Length(), 4);
+        const int64 BinarySize = Embedded ? Embedded->ByteLength : 0;
+        const int64 BinaryLength = Align(BinarySize, 4);
+        const int64 TotalLength = 12 + 8 + JsonLength + (BinarySize > 0 ? 8 + BinaryLength : 0);
+
+        if (TotalLength > MAX_uint32)
+        {
+            return false;
+        }
+
+        TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*ExportPath));
+
+        if (!Writer)
+        {
+            return false;
+        }
+
+        uint32 Header[3] = { GLB_MAGIC, 2, (uint32)TotalLength };
+        Writer->Serialize(Header, sizeof(Header));
+        WriteJsonChunk(*Writer, JsonUTF8, JsonLength);
+
+        if (BinarySize > 0)
+        {
+            TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Embedded->Path));
+
+            if (!Reader)
+            {
+                return false;
+            }
+
+            uint32 BinaryHeader[2] = { (uint32)BinaryLength, GLB_CHUNK_BIN };
+            Writer->Serialize(BinaryHeader, sizeof(BinaryHeader));
+            CopyBlocks(*Reader, *Writer, BinarySize);
+
+            for (int64 Padding = BinarySize; Padding < BinaryLength; Padding++)
+            {
+                uint8 Zero = 0;
+                Writer->Serialize(&Zero, 1);
+            }
+
+            if (Reader->IsError())
+            {
+                return false;
+            }
+        }
+
+        return Writer->Close() && !Writer->IsError();
+    }
+
+    static void RemoveRootFields(const TSharedPtr<FJsonObject>& Root, bool bResetLocation, bool bResetScale)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Scenes = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+
+        if (!Root->TryGetArrayField(TEXT("scenes"), Scenes) || !Root->TryGetArrayField(TEXT("nodes"), Nodes))
+        {
+            return;
+        }
+
+        for (const TSharedPtr<FJsonValue>& Each_Scene : *Scenes)
+        {
+            const TSharedPtr<FJsonObject>* SceneObject = nullptr;
+            const TArray<TSharedPtr<FJsonValue>>* RootNodes = nullptr;
+
+            if (!Each_Scene->TryGetObject(SceneObject) || !(*SceneObject)->TryGetArrayField(TEXT("nodes"), RootNodes))
+            {
+                continue;
+            }
+
+            for (const TSharedPtr<FJsonValue>& Each_Root : *RootNodes)
+            {
+                const int32 NodeIndex = (int32)Each_Root->AsNumber();
+                const TSharedPtr<FJsonObject>* NodeObject = nullptr;
+
+                if (!Nodes->IsValidIndex(NodeIndex) || !(*Nodes)[NodeIndex]->TryGetObject(NodeObject))
+                {
+                    continue;
+                }
+
+                // Missing fields mean zero translation and unit scale.
+                if (bResetLocation)
+                {
+                    (*NodeObject)->RemoveField(TEXT("translation"));
+                }
+
+                if (bResetScale)
+                {
+                    (*NodeObject)->RemoveField(TEXT("scale"));
+                }
+            }
+        }
+    }
+
+    static bool PatchJson(const FString& Source, bool bResetLocation, bool bResetScale, FString& Out_Json)
+    {
+        TSharedPtr<FJsonObject> Root;
+
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<TCHAR>::Create(Source), Root) || !Root.IsValid())
+        {
+            return false;
+        }
+
+        RemoveRootFields(Root, bResetLocation, bResetScale);
+
+        Out_Json.Reset();
+        return FJsonSerializer::Serialize(Root.ToSharedRef(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out_Json));
+    }
+
+    static bool PatchGLB(const FString& ExportPath, bool bResetLocation, bool bResetScale, FString& Out_Error)
+    {
+        const FString TempPath = ExportPath + TEXT(".tmp");
+
+        {
+            TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*ExportPath));
+
+            if (!Reader)
+            {
+                Out_Error = FString::Printf(TEXT("%s couldn't be opened."), *ExportPath);
+                return false;
+            }
+
+            uint32 Header[3] = { 0 };
+            uint32 JsonHeader[2] = { 0 };
+            Reader->Serialize(Header, sizeof(Header));
+            Reader->Serialize(JsonHeader, sizeof(JsonHeader));
+
+            if (Reader->IsError() || Header[0] != GLB_MAGIC || JsonHeader[1] != GLB_CHUNK_JSON || 20 + (int64)JsonHeader[0] > Reader->TotalSize())
+            {
+                Out_Error = FString::Printf(TEXT("%s isn't a valid GLB file."), *ExportPath);
+                return false;
+            }
+
+            TArray<uint8> JsonBytes;
+            JsonBytes.SetNumUninitialized(JsonHeader[0]);
+            Reader->Serialize(JsonBytes.GetData(), JsonBytes.Num());
+
+            const FUTF8ToTCHAR JsonConverter(reinterpret_cast<const ANSICHAR*>(JsonBytes.GetData()), JsonBytes.Num());
+            FString Json;
+
+            if (!PatchJson(FString(JsonConverter.Length(), JsonConverter.Get()), bResetLocation, bResetScale, Json))
+            {
+                Out_Error = FString::Printf(TEXT("JSON chunk of %s couldn't be parsed."), *ExportPath);
+                return false;
+            }
+
+            const FTCHARToUTF8 JsonUTF8(*Json);
+            const uint32 JsonLength = Align((uint32)JsonUTF8.Length(), 4);
+            const int64 RemainingSize = Reader->TotalSize() - Reader->Tell();
+
+            TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+
+            if (!Writer)
+            {
+                Out_Error = FString::Printf(TEXT("%s couldn't be written."), *TempPath);
+                return false;
+            }
+
+            uint32 NewHeader[3] = { GLB_MAGIC, 2, (uint32)(12 + 8 + JsonLength + RemainingSize) };
+            Writer->Serialize(NewHeader, sizeof(NewHeader));
+            WriteJsonChunk(*Writer, JsonUTF8, JsonLength);
+            CopyBlocks(*Reader, *Writer, RemainingSize);
+
+            if (!Writer->Close() || Writer->IsError() || Reader->IsError())
+            {
+                Writer.Reset();
+                IFileManager::Get().Delete(*TempPath);
+                Out_Error = FString::Printf(TEXT("%s couldn't be written."), *TempPath);
+                return false;
+            }
+        }
+
+        if (!IFileManager::Get().Move(*ExportPath, *TempPath, true))
+        {
+            IFileManager::Get().Delete(*TempPath);
+            Out_Error = FString::Printf(TEXT("%s couldn't be replaced."), *ExportPath);
+            return false;
+        }
+
+        return true;
+    }
+
+    static uint32 GetMaterialHash(const FMeshOps_ExportScene::FMaterial& Material)
+    {
+        uint32 Hash = HashCombineFast(GetTypeHash(Material.BaseColor), GetTypeHash(Material.Emissive));
+        Hash = HashCombineFast(Hash, GetTypeHash(Material.Metallic));
+        Hash = HashCombineFast(Hash, GetTypeHash(Material.Roughness));
+        return HashCombineFast(Hash, (uint32)Material.bIsTwoSided | (uint32)Material.bIsTranslucent << 1 | (uint32)Material.bIsMasked << 2);
+    }
+
+    static bool IsSameMaterial(const FMeshOps_ExportScene::FMaterial& A, const FMeshOps_ExportScene::FMaterial& B)
+    {
+        return A.BaseColor == B.BaseColor && A.Emissive == B.Emissive && A.Metallic == B.Metallic && A.Roughness == B.Roughness && A.bIsTwoSided == B.bIsTwoSided && A.bIsTranslucent == B.bIsTranslucent && A.bIsMasked == B.bIsMasked;
+    }
+
+    static void GetMaterialFactors(const UMaterialInterface* Material, FMeshOps_ExportScene::FMaterial& Out_Material)
+    {
+        Out_Material.Name = Material->GetName();
+
+        FLinearColor Color;
+
+        for (const TCHAR* Each_Name : { TEXT("BaseColor"), TEXT("Base Color"), TEXT("Color"), TEXT("Albedo") })
+        {
+            if (Material->GetVectorParameterValue(FHashedMaterialParameterInfo(FName(Each_Name)), Color))
+            {
+                Out_Material.BaseColor = Color;
+                break;
+            }
+        }
+
+        for (const TCHAR* Each_Name : { TEXT("EmissiveColor"), TEXT("Emissive") })
+        {
+            if (Material->GetVectorParameterValue(FHashedMaterialParameterInfo(FName(Each_Name)), Color))
+            {
+                Out_Material.Emissive = Color;
+                break;
+            }
+        }
+
+        float Value = 0.f;
+
+        if (Material->GetScalarParameterValue(FHashedMaterialParameterInfo(FName(TEXT("Metallic"))), Value))
+        {
+            Out_Material.Metallic = Value;
+        }
+
+        if (Material->GetScalarParameterValue(FHashedMaterialParameterInfo(FName(TEXT("Roughness"))), Value))
+        {
+            Out_Material.Roughness = Value;
+        }
+
+        if (Material->GetScalarParameterValue(FHashedMaterialParameterInfo(FName(TEXT("Opacity"))), Value))
+        {
+            Out_Material.BaseColor.A = Value;
+        }
+
+        const EBlendMode BlendMode = Material->GetBlendMode();
+        Out_Material.bIsTranslucent = BlendMode == BLEND_Translucent || BlendMode == BLEND_Additive || BlendMode == BLEND_Modulate;
+        Out_Material.bIsMasked = BlendMode == BLEND_Masked;
+        Out_Material.bIsTwoSided = Material->IsTwoSided();
+    }
+}
+
+struct FMeshOps_GLTFCache::FImpl
+{
+    FCriticalSection Meshes_Guard;
+    TMap<MeshOps_GLTFWriter_Private::FMeshKey, TSharedPtr<const MeshOps_GLTFWriter_Private::FMeshData>> Meshes;
+    int64 Budget = 0;
+    int64 Used = 0;
+
+    // Game thread only.
+    TMap<TWeakObjectPtr<const UMaterialInterface>, FMeshOps_ExportScene::FMaterial> Materials;
+};
+
+FMeshOps_GLTFCache::FMeshOps_GLTFCache(int64 In_Budget) : Impl(MakeUnique<FImpl>())
+{
+    this->Impl->Budget = In_Budget;
+}
+
+FMeshOps_GLTFCache::~FMeshOps_GLTFCache() = default;
+
+void FMeshOps_GLTFWriter::MakeSnapshot(TArrayView<AActor* const> Actors, const FGLTFExportOptionsStruct& Options, FMeshOps_ExportScene& Out_Scene, FMeshOps_GLTFCache* Cache)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_GLTFWriter_Private;
+
+    Out_Scene = FMeshOps_ExportScene();
+
+    TMap<const UMaterialInterface*, int32> MaterialIndices;
+    TMultiMap<uint32, int32> MaterialContents;
+    TMultiMap<uint64, int32> MeshIndices;
+
+    /*
+    * Separately imported copies of a part and per component copies made by pivot changes are different assets with the same geometry.
+    * Geometry hash covers LOD 0, so it is only used when LOD 0 is exported.
+    */
+    const bool bMatchGeometry = Options.bDeduplicateMeshes && Options.DefaultLevelOfDetail <= 0;
+
+    if (bMatchGeometry)
+    {
+        TArray<const UStaticMesh*> StaticMeshes;
+
+        for (AActor* Each_Actor : Actors)
+        {
+            if (!IsValid(Each_Actor))
+            {
+                continue;
+            }
+
+            TArray<UStaticMeshComponent*> StaticMeshComps;
+            Each_Actor->GetComponents(StaticMeshComps);
+
+            for (const UStaticMeshComponent* Each_Comp : StaticMeshComps)
+            {
+                StaticMeshes.Add(Each_Comp->GetStaticMesh());
+            }
+        }
+
+        FMeshOps_Instancing::PrecacheGeometryHashes(StaticMeshes);
+    }
+
+    auto AddMaterial = [&Out_Scene, &MaterialIndices, &MaterialContents, &Options, Cache](const UMaterialInterface* Material) -> int32
+        {
+            if (!IsValid(Material))
+            {
+                return INDEX_NONE;
+            }
+
+            if (const int32* Found = MaterialIndices.Find(Material))
+            {
+                return *Found;
+            }
+
+            FMeshOps_ExportScene::FMaterial NewMaterial;
+
+            if (Cache)
+            {
+                FMeshOps_ExportScene::FMaterial* Cached = Cache->Impl->Materials.Find(Material);
+
+                if (Cached)
+                {
+                    NewMaterial = *Cached;
+                }
+
+                else
+                {
+                    GetMaterialFactors(Material, NewMaterial);
+                    Cache->Impl->Materials.Add(Material, NewMaterial);
+                }
+            }
+
+            else
+            {
+                GetMaterialFactors(Material, NewMaterial);
+            }
+
+            // Only constant factors are exported, so material instances with equal factors give equal glTF materials.
+            const uint32 ContentHash = GetMaterialHash(NewMaterial);
+
+            if (Options.bDeduplicateMeshes)
+            {
+                TArray<int32> Candidates;
+                MaterialContents.MultiFind(ContentHash, Candidates);
+
+                for (const int32 Each_Candidate : Candidates)
+                {
+                    if (IsSameMaterial(Out_Scene.Materials[Each_Candidate], NewMaterial))
+                    {
+                        MaterialIndices.Add(Material, Each_Candidate);
+                        return Each_Candidate;
+                    }
+                }
+            }
+
+            const int32 MaterialIndex = Out_Scene.Materials.Add(MoveTemp(NewMaterial));
+            MaterialIndices.Add(Material, MaterialIndex);
+            MaterialContents.Add(ContentHash, MaterialIndex);
+
+            return MaterialIndex;
+        };
+
+    // Hash only finds candidates. Different assets are compared byte by byte once per pair before they share a glTF mesh.
+    TMap<TPair<const UStaticMesh*, const UStaticMesh*>, bool> SameGeometry;
+
+    auto AddMesh = [&Out_Scene, &MeshIndices, &SameGeometry, &AddMaterial, &Options, bMatchGeometry](const UStaticMeshComponent* Component) -> int32
+        {
+            const UStaticMesh* StaticMesh = Component->GetStaticMesh();
+
+            if (!IsValid(StaticMesh))
+            {
+                return INDEX_NONE;
+            }
+
+            TArray<int32> Materials;
+
+            for (int32 SlotIndex = 0; SlotIndex < Component->GetNumMaterials(); SlotIndex++)
+            {
+                Materials.Add(AddMaterial(Component->GetMaterial(SlotIndex)));
+            }
+
+            const uint64 MeshKey = bMatchGeometry ? FMeshOps_Instancing::GetGeometryHash(StaticMesh) : (uint64)(UPTRINT)StaticMesh;
+
+            TArray<int32> Candidates;
+            MeshIndices.MultiFind(MeshKey, Candidates);
+
+            for (const int32 Each_Candidate : Candidates)
+            {
+                const FMeshOps_ExportScene::FMesh& Candidate = Out_Scene.Meshes[Each_Candidate];
+
+                if (Candidate.Materials != Materials)
+                {
+                    continue;
+                }
+
+                if (Candidate.StaticMesh != StaticMesh)
+                {
+                    const TPair<const UStaticMesh*, const UStaticMesh*> Pair(Candidate.StaticMesh, StaticMesh);
+                    const bool* Found = SameGeometry.Find(Pair);
+
+                    if (!(Found ? *Found : SameGeometry.Add(Pair, FMeshOps_Instancing::HasSameGeometry(Candidate.StaticMesh, StaticMesh))))
+                    {
+                        continue;
+                    }
+                }
+
+                return Each_Candidate;
+            }
+
+            FMeshOps_ExportScene::FMesh& Mesh = Out_Scene.Meshes.AddDefaulted_GetRef();
+            Mesh.Name = StaticMesh->GetName();
+            Mesh.StaticMesh = StaticMesh;
+            Mesh.LOD_Index = FMath::Max(Options.DefaultLevelOfDetail, 0);
+            Mesh.Materials = MoveTemp(Materials);
+
+            MeshIndices.Add(MeshKey, Out_Scene.Meshes.Num() - 1);
+            return Out_Scene.Meshes.Num() - 1;
+        };
+
+    auto AddNode = [&Out_Scene](const FString& Name, int32 Parent, const FTransform& Transform) -> int32
+        {
+            const int32 NodeIndex = Out_Scene.Nodes.AddDefaulted();
+            FMeshOps_ExportScene::FNode& Node = Out_Scene.Nodes[NodeIndex];
+            Node.Name = Name;
+            Node.Parent = Parent;
+            Node.Transform = Transform;
+
+            if (Parent == INDEX_NONE)
+            {
+                Out_Scene.RootNodes.Add(NodeIndex);
+            }
+
+            else
+            {
+                Out_Scene.Nodes[Parent].Children.Add(NodeIndex);
+            }
+
+            return NodeIndex;
+        };
+
+    // Traversal follows attach children into attached actors, so actors which are attached under another target are exported through it.
+    TSet<const AActor*> Target_Actors;
+    TSet<const AActor*> Exported_Actors;
+
+    for (const AActor* Each_Actor : Actors)
+    {
+        Target_Actors.Add(Each_Actor);
+    }
+
+    auto IsAttachedToTarget = [&Target_Actors](const AActor* Actor) -> bool
+        {
+            for (const AActor* Each_Parent = Actor->GetAttachParentActor(); Each_Parent; Each_Parent = Each_Parent->GetAttachParentActor())
+            {
+                if (Target_Actors.Contains(Each_Parent))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+    for (AActor* Each_Actor : Actors)
+    {
+        if (!IsValid(Each_Actor) || !IsValid(Each_Actor->GetRootComponent()) || IsAttachedToTarget(Each_Actor))
+        {
+            continue;
+        }
+
+        bool bIsAlreadyExported = false;
+        Exported_Actors.Add(Each_Actor, &bIsAlreadyExported);
+
+        if (bIsAlreadyExported)
+        {
+            continue;
+        }
+
+        USceneComponent* Root = Each_Actor->GetRootComponent();
+
+        // Overrides are applied to the snapshot only. Actors are never moved.
+        FTransform RootTransform = Root->GetComponentTransform();
+
+        if (Options.bResetLocation)
+        {
+            RootTransform.SetLocation(FVector::ZeroVector);
+        }
+
+        if (Options.bResetScale)
+        {
+            RootTransform.SetScale3D(FVector::OneVector);
+        }
+
+        TArray<TPair<USceneComponent*, int32>> Stack;
+        Stack.Add(TPair<USceneComponent*, int32>(Root, INDEX_NONE));
+
+        while (!Stack.IsEmpty())
+        {
+            const TPair<USceneComponent*, int32> Current = Stack.Pop();
+            USceneComponent* Component = Current.Key;
+
+            const FTransform Transform = Current.Value == INDEX_NONE ? RootTransform : Component->GetComponentTransform().GetRelativeTransform(Component->GetAttachParent()->GetComponentTransform());
+            const FString Name = Current.Value == INDEX_NONE ? Each_Actor->GetActorNameOrLabel() : UMeshOperationsBPLibrary::GetObjectNameForPackage(Component);
+            const int32 NodeIndex = AddNode(Name, Current.Value, Transform);
+
+            const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component);
+            const bool bIsVisible = Options.bExportHiddenInGame || !Component->bHiddenInGame;
+
+            if (StaticMeshComp && bIsVisible)
+            {
+                const int32 MeshIndex = AddMesh(StaticMeshComp);
+                const UInstancedStaticMeshComponent* InstancedComp = Cast<UInstancedStaticMeshComponent>(StaticMeshComp);
+
+                if (InstancedComp)
+                {
+                    for (int32 InstanceIndex = 0; InstanceIndex < InstancedComp->GetInstanceCount(); InstanceIndex++)
+                    {
+                        FTransform InstanceTransform;
+
+                        if (InstancedComp->GetInstanceTransform(InstanceIndex, InstanceTransform, false))
+                        {
+                            const int32 InstanceNode = AddNode(FString::Printf(TEXT("%s_%d"), *Name, InstanceIndex), NodeIndex, InstanceTransform);
+                            Out_Scene.Nodes[InstanceNode].Mesh = MeshIndex;
+                        }
+                    }
+                }
+
+                else
+                {
+                    Out_Scene.Nodes[NodeIndex].Mesh = MeshIndex;
+                }
+            }
+
+            // Children are pushed in reverse, so they are visited in attachment order.
+            const TArray<TObjectPtr<USceneComponent>>& Children = Component->GetAttachChildren();
+
+            for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; ChildIndex--)
+            {
+                if (IsValid(Children[ChildIndex]))
+                {
+                    Stack.Add(TPair<USceneComponent*, int32>(Children[ChildIndex], NodeIndex));
+                }
+            }
+        }
+    }
+}
+
+void FMeshOps_GLTFWriter::GetIgnoredOptions(const FGLTFExportOptionsStruct& Options, TArray<FString>& Out_Names)
+{
+    Out_Names.Reset();
+
+    // Only options which are disabled by default are listed. Defaults of the engine exporter shouldn't warn on every export.
+    const TPair<const TCHAR*, bool> Requested[] =
+    {
+        { TEXT("BakeMaterialInputs"), Options.BakeMaterialInputs != EGLTFMaterialBakeMode::Disabled },
+        { TEXT("ExportMaterialVariants"), Options.ExportMaterialVariants != EGLTFMaterialVariantMode::None },
+        { TEXT("bUseImporterMaterialMapping"), Options.bUseImporterMaterialMapping },
+        { TEXT("bAdjustNormalmaps"), Options.bAdjustNormalmaps },
+        { TEXT("bExportSourceModel"), Options.bExportSourceModel },
+        { TEXT("bExportMorphTargets"), Options.bExportMorphTargets },
+        { TEXT("bExportLevelSequences"), Options.bExportLevelSequences },
+        { TEXT("bExportAnimationSequences"), Options.bExportAnimationSequences },
+        { TEXT("bExportLights"), Options.bExportLights },
+        { TEXT("bExportCameras"), Options.bExportCameras },
+        { TEXT("bExportPreviewMesh"), Options.bExportPreviewMesh },
+        { TEXT("bIncludeCopyrightNotice"), Options.bIncludeCopyrightNotice },
+    };
+
+    for (const TPair<const TCHAR*, bool>& Each_Option : Requested)
+    {
+        if (Each_Option.Value)
+        {
+            Out_Names.Add(Each_Option.Key);
+        }
+    }
+}
+
+bool FMeshOps_GLTFWriter::Write(const FMeshOps_ExportScene& Scene, const FGLTFExportOptionsStruct& Options, const FString& ExportPath, TFunctionRef<bool(float Progress)> ReportProgress, FGLTFExportStatsStruct& Out_Stats, FString& Out_Error, FMeshOps_GLTFCache* Cache)
+{
+    using namespace MeshOps_GLTFWriter_Private;
+
+    const double StartTime = FPlatformTime::Seconds();
+    Out_Stats = FGLTFExportStatsStruct();
+
+    const bool bIsBinary = FPaths::GetExtension(ExportPath).Equals(TEXT("glb"), ESearchCase::IgnoreCase);
+    const float UniformScale = Options.ExportUniformScale;
+
+    if (!FPaths::DirectoryExists(FPaths::GetPath(ExportPath)))
+    {
+        Out_Error = FString::Printf(TEXT("Export directory of %s doesn't exist."), *ExportPath);
+        return false;
+    }
+
+    // --- CONVERT AND STREAM MESHES ---
+
+    FBinaryStream Buffer(ExportPath, bIsBinary, (int64)FMath::Max(Options.Max_Buffer_Size, 0) * 1024 * 1024);
+    TArray<FMeshAccessors> MeshAccessors;
+    TArray<int32> MeshMap;
+    MeshMap.Init(INDEX_NONE, Scene.Meshes.Num());
+
+    auto Fail = [&Buffer, &Out_Error](const FString& Error)
+        {
+            Buffer.DeleteFiles();
+            Out_Error = Error;
+            return false;
+        };
+
+    TArray<TSharedPtr<const FMeshData>> Batch;
+    TArray<bool> Batch_IsReused;
+    FMeshOps_GLTFCache::FImpl* SharedCache = Cache ? Cache->Impl.Get() : nullptr;
+
+    for (int32 First = 0; First < Scene.Meshes.Num(); First += GLTF_CONVERT_BATCH_SIZE)
+    {
+        const int32 Count = FMath::Min(GLTF_CONVERT_BATCH_SIZE, Scene.Meshes.Num() - First);
+
+        Batch.Reset();
+        Batch.SetNum(Count);
+        Batch_IsReused.Init(false, Count);
+
+        ParallelFor(Count, [&Scene, &Batch, &Batch_IsReused, &Options, SharedCache, First, UniformScale](int32 Index)
+            {
+                const FMeshOps_ExportScene::FMesh& Mesh = Scene.Meshes[First + Index];
+                const FMeshKey Key(Mesh.StaticMesh, Mesh.LOD_Index, UniformScale, Options.bUseMeshCompression);
+
+                if (SharedCache)
+                {
+                    FScopeLock Lock(&SharedCache->Meshes_Guard);
+
+                    if (const TSharedPtr<const FMeshData>* Found = SharedCache->Meshes.Find(Key))
+                    {
+                        Batch[Index] = *Found;
+                        Batch_IsReused[Index] = true;
+                        return;
+                    }
+                }
+
+                TSharedPtr<FMeshData> MeshData = MakeShared<FMeshData>();
+                ConvertMesh(Mesh, UniformScale, Options.bUseMeshCompression, *MeshData);
+                Batch[Index] = MeshData;
+
+                // Meshes which don't fit into budget are converted again by later exports.
+                if (SharedCache)
+                {
+                    const int64 Size = MeshData->GetAllocatedSize();
+                    FScopeLock Lock(&SharedCache->Meshes_Guard);
+
+                    if (SharedCache->Used + Size <= SharedCache->Budget)
+                    {
+                        SharedCache->Meshes.Add(Key, MeshData);
+                        SharedCache->Used += Size;
+                    }
+                }
+            });
+
+        // Written in mesh order, so output doesn't depend on thread timing.
+        for (int32 Index = 0; Index < Count; Index++)
+        {
+            const FMeshData& MeshData = *Batch[Index];
+
+            if (!MeshData.bIsValid)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("GLTF Export : %s is skipped because its CPU data isn't available."), *Scene.Meshes[First + Index].Name);
+                continue;
+            }
+
+            MeshMap[First + Index] = MeshAccessors.Num();
+            AddMeshData(Scene.Meshes[First + Index], MeshData, Buffer, MeshAccessors.AddDefaulted_GetRef());
+
+            if (Batch_IsReused[Index])
+            {
+                Out_Stats.Num_Reused_Meshes++;
+            }
+
+            else
+            {
+                Out_Stats.Encode_Time += MeshData.Encode_Time;
+            }
+        }
+
+        if (Buffer.bHasError)
+        {
+            return Fail(FString::Printf(TEXT("Buffers of %s couldn't be written."), *ExportPath));
+        }
+
+        if (!ReportProgress(0.9f * (First + Count) / Scene.Meshes.Num()))
+        {
+            return Fail(TEXT("Export is canceled."));
+        }
+    }
+
+    Batch.Empty();
+
+    TArray<FInstanceGroup> Groups;
+    TArray<int32> NodeMap;
+
+    if (Options.bUseGPUInstancing)
+    {
+        AddInstanceGroups(Scene, MeshMap, UniformScale, Buffer, Groups, NodeMap);
+    }
+
+    else
+    {
+        NodeMap.SetNumUninitialized(Scene.Nodes.Num());
+
+        for (int32 NodeIndex = 0; NodeIndex < Scene.Nodes.Num(); NodeIndex++)
+        {
+            NodeMap[NodeIndex] = NodeIndex;
+        }
+    }
+
+    if (!Buffer.Close())
+    {
+        return Fail(FString::Printf(TEXT("Buffers of %s couldn't be written."), *ExportPath));
+    }
+
+    // --- WRITE ---
+
+    const FString Json = MakeJson(Scene, MeshAccessors, MeshMap, Groups, NodeMap, Buffer, UniformScale, Options.bSkipNearDefaultValues);
+
+    bool bIsWritten = false;
+
+    if (bIsBinary)
+    {
+        const FBinaryStream::FBuffer* Embedded = !Buffer.Buffers.IsEmpty() && Buffer.Buffers[0].bIsEmbedded ? &Buffer.Buffers[0] : nullptr;
+        bIsWritten = WriteGLB(ExportPath, Json, Embedded);
+
+        if (Embedded)
+        {
+            IFileManager::Get().Delete(*Embedded->Path, false, false, true);
+        }
+    }
+
+    else
+    {
+        bIsWritten = FFileHelper::SaveStringToFile(Json, *ExportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+    }
+
+    if (!bIsWritten)
+    {
+        return Fail(FString::Printf(TEXT("%s couldn't be written."), *ExportPath));
+    }
+
+    Out_Stats.Num_Meshes = MeshAccessors.Num();
+    Out_Stats.Num_Nodes = Scene.Nodes.Num();
+    Out_Stats.Num_Instance_Groups = Groups.Num();
+    Out_Stats.Raw_Size = Buffer.Raw_Size;
+    Out_Stats.Buffer_Size = Buffer.GetWrittenSize();
+    Out_Stats.Compression_Ratio = Out_Stats.Buffer_Size > 0 ? (double)Out_Stats.Raw_Size / Out_Stats.Buffer_Size : 1.0;
+    Out_Stats.Total_Time = FPlatformTime::Seconds() - StartTime;
+
+    ReportProgress(1.0f);
+    return true;
+}
+
+bool FMeshOps_GLTFWriter::OverrideRootTransforms(const FString& ExportPath, bool bResetLocation, bool bResetScale, FString& Out_Error)
+{
+    using namespace MeshOps_GLTFWriter_Private;
+
+    if (!bResetLocation && !bResetScale)
+    {
+        return true;
+    }
+
+    if (FPaths::GetExtension(ExportPath).Equals(TEXT("glb"), ESearchCase::IgnoreCase))
+    {
+        return PatchGLB(ExportPath, bResetLocation, bResetScale, Out_Error);
+    }
+
+    FString Source;
+    FString Json;
+
+    if (!FFileHelper::LoadFileToString(Source, *ExportPath) || !PatchJson(Source, bResetLocation, bResetScale, Json))
+    {
+        Out_Error = FString::Printf(TEXT("%s couldn't be parsed."), *ExportPath);
+        return false;
+    }
+
+    if (!FFileHelper::SaveStringToFile(Json, *ExportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        Out_Error = FString::Printf(TEXT("%s couldn't be written."), *ExportPath);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,298 @@
+#include "MeshOps_HierarchyOutline.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_BoundsCache.h"
+
+#define HIERARCHY_OUTLINE_MAGIC 0x4C54484D
+// Increase when file layout changes.
+#define HIERARCHY_OUTLINE_VERSION 1
+
+namespace MeshOps_HierarchyOutline_Private
+{
+    // Node fields are string table indices, so a node costs a few integers and its bounds.
+    struct FStringTable
+    {
+        TArray<FString> Strings;
+        TMap<FString, int32> Indices;
+
+        int32 Add(const FString& In_String)
+        {
+            if (const int32* Found = this->Indices.Find(In_String))
+            {
+                return *Found;
+            }
+
+            const int32 NewIndex = this->Strings.Add(In_String);
+            this->Indices.Add(In_String, NewIndex);
+            return NewIndex;
+        }
+    };
+}
+
+bool FMeshOps_HierarchyOutline::Build(USceneComponent* AssetRoot, FMeshOps_HierarchyOutline& Out_Outline)
+{
+    Out_Outline.Nodes.Reset();
+    Out_Outline.Meshes.Reset();
+
+    if (!IsValid(AssetRoot))
+    {
+        return false;
+    }
+
+    TSharedRef<FMeshOps_BoundsCache> BoundsCache = FMeshOps_BoundsCache::Get(AssetRoot);
+    TMap<FSoftObjectPath, int32> MeshIndices;
+
+    // Children are pushed in reverse, so they are popped in attachment order and every node comes after its parent.
+    TArray<TPair<USceneComponent*, int32>> Stack;
+    Stack.Add(TPair<USceneComponent*, int32>(AssetRoot, INDEX_NONE));
+
+    TArray<USceneComponent*> Children;
+
+    while (!Stack.IsEmpty())
+    {
+        const TPair<USceneComponent*, int32> Current = Stack.Pop();
+        USceneComponent* Component = Current.Key;
+
+        const int32 NodeIndex = Out_Outline.Nodes.Num();
+        FNode& Node = Out_Outline.Nodes.AddDefaulted_GetRef();
+        Node.Name = UMeshOperationsBPLibrary::GetObjectNameForPackage(Component);
+        Node.Tags = Component->ComponentTags;
+        Node.Parent = Current.Value;
+
+        if (BoundsCache->Contains(Component))
+        {
+            BoundsCache->GetSubtreeBounds(Component, Node.Bounds);
+        }
+
+        if (const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component))
+        {
+            if (const UStaticMesh* StaticMesh = MeshComponent->GetStaticMesh())
+            {
+                const FSoftObjectPath MeshPath(StaticMesh);
+
+                if (const int32* Found = MeshIndices.Find(MeshPath))
+                {
+                    Node.Mesh = *Found;
+                }
+
+                else
+                {
+                    Node.Mesh = Out_Outline.Meshes.Add(MeshPath);
+                    MeshIndices.Add(MeshPath, Node.Mesh);
+                }
+            }
+        }
+
+        Children.Reset();
+        Component->GetChildrenComponents(false, Children);
+
+        for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; ChildIndex--)
+        {
+            if (IsValid(Children[ChildIndex]))
+            {
+                Stack.Add(TPair<USceneComponent*, int32>(Children[ChildIndex], NodeIndex));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FMeshOps_HierarchyOutline::Save(const FString& File_Path) const
+{
+    using namespace MeshOps_HierarchyOutline_Private;
+
+    if (File_Path.IsEmpty() || this->Nodes.IsEmpty())
+    {
+        return false;
+    }
+
+    FStringTable StringTable;
+    TArray<int32> MeshStrings;
+    MeshStrings.Reserve(this->Meshes.Num());
+
+    for (const FSoftObjectPath& Each_Mesh : this->Meshes)
+    {
+        MeshStrings.Add(StringTable.Add(Each_Mesh.ToString()));
+    }
+
+    // Nodes are written to a separate buffer first, because string table has to be complete before it is written.
+    TArray<uint8> NodeBytes;
+    FMemoryWriter NodeWriter(NodeBytes);
+
+    for (const FNode& Each_Node : this->Nodes)
+    {
+        int32 NameIndex = StringTable.Add(Each_Node.Name);
+        int32 Parent = Each_Node.Parent;
+        int32 Mesh = Each_Node.Mesh;
+        int32 NumTags = Each_Node.Tags.Num();
+        uint8 bIsValidBounds = Each_Node.Bounds.IsValid;
+        FVector3f BoundsMin = FVector3f(Each_Node.Bounds.Min);
+        FVector3f BoundsMax = FVector3f(Each_Node.Bounds.Max);
+
+        NodeWriter << NameIndex << Parent << Mesh << NumTags;
+
+        for (const FName& Each_Tag : Each_Node.Tags)
+        {
+            int32 TagIndex = StringTable.Add(Each_Tag.ToString());
+            NodeWriter << TagIndex;
+        }
+
+        NodeWriter << bIsValidBounds << BoundsMin << BoundsMax;
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = HIERARCHY_OUTLINE_MAGIC;
+    uint32 Version = HIERARCHY_OUTLINE_VERSION;
+    int32 NumStrings = StringTable.Strings.Num();
+    int32 NumMeshes = MeshStrings.Num();
+    int32 NumNodes = this->Nodes.Num();
+
+    Writer << Magic << Version << NumStrings << NumMeshes << NumNodes;
+
+    for (FString& Each_String : StringTable.Strings)
+    {
+        Writer << Each_String;
+    }
+
+    for (int32& Each_MeshString : MeshStrings)
+    {
+        Writer << Each_MeshString;
+    }
+
+    Writer.Serialize(NodeBytes.GetData(), NodeBytes.Num());
+
+    return FFileHelper::SaveArrayToFile(Bytes, *File_Path);
+}
+
+bool FMeshOps_HierarchyOutline::Load(const FString& File_Path)
+{
+    this->Nodes.Reset();
+    this->Meshes.Reset();
+
+    TArray<uint8> Bytes;
+
+    if (!FFileHelper::LoadFileToArray(Bytes, *File_Path))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int32 NumStrings = 0;
+    int32 NumMeshes = 0;
+    int32 NumNodes = 0;
+
+    Reader << Magic << Version << NumStrings << NumMeshes << NumNodes;
+
+    // Every string, mesh and node takes at least four bytes, so counts of a corrupted header can't cause huge allocations.
+    const int64 MaxCount = Bytes.Num() / 4;
+
+    if (Reader.IsError() || Magic != HIERARCHY_OUTLINE_MAGIC || Version != HIERARCHY_OUTLINE_VERSION || NumStrings < 0 || NumMeshes < 0 || NumNodes <= 0 || NumStrings > MaxCount || NumMeshes > MaxCount || NumNodes > MaxCount)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Hierarchy outline is not valid or it is written by another version: %s"), *File_Path);
+        return false;
+    }
+
+    TArray<FString> Strings;
+    Strings.SetNum(NumStrings);
+
+    // A string can't be longer than the file, so corrupted lengths fail the reader instead of allocating.
+    Reader.ArMaxSerializeSize = Bytes.Num();
+
+    for (FString& Each_String : Strings)
+    {
+        Reader << Each_String;
+
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Hierarchy outline is not valid or it is written by another version: %s"), *File_Path);
+            return false;
+        }
+    }
+
+    this->Meshes.Reserve(NumMeshes);
+
+    for (int32 MeshIndex = 0; MeshIndex < NumMeshes; MeshIndex++)
+    {
+        int32 StringIndex = INDEX_NONE;
+        Reader << StringIndex;
+
+        if (!Strings.IsValidIndex(StringIndex))
+        {
+            this->Meshes.Reset();
+            return false;
+        }
+
+        this->Meshes.Add(FSoftObjectPath(Strings[StringIndex]));
+    }
+
+    this->Nodes.SetNum(NumNodes);
+    bool bIsValid = !Reader.IsError();
+
+    for (int32 NodeIndex = 0; bIsValid && NodeIndex < NumNodes; NodeIndex++)
+    {
+        FNode& Node = this->Nodes[NodeIndex];
+
+        int32 NameIndex = INDEX_NONE;
+        int32 NumTags = 0;
+        uint8 bIsValidBounds = 0;
+        FVector3f BoundsMin;
+        FVector3f BoundsMax;
+
+        Reader << NameIndex << Node.Parent << Node.Mesh << NumTags;
+
+        // Parents before children is what makes the outline indexable in one pass.
+        bIsValid = !Reader.IsError() && Strings.IsValidIndex(NameIndex) && Node.Parent >= INDEX_NONE && Node.Parent < NodeIndex && (Node.Mesh == INDEX_NONE || this->Meshes.IsValidIndex(Node.Mesh)) && NumTags >= 0 && NumTags <= MaxCount;
+
+        if (!bIsValid)
+        {
+            break;
+        }
+
+        Node.Name = Strings[NameIndex];
+        Node.Tags.Reserve(NumTags);
+
+        for (int32 TagIndex = 0; TagIndex < NumTags; TagIndex++)
+        {
+            int32 StringIndex = INDEX_NONE;
+            Reader << StringIndex;
+
+            if (!Strings.IsValidIndex(StringIndex))
+            {
+                bIsValid = false;
+                break;
+            }
+
+            Node.Tags.Add(FName(*Strings[StringIndex]));
+        }
+
+        Reader << bIsValidBounds << BoundsMin << BoundsMax;
+        bIsValid = bIsValid && !Reader.IsError();
+
+        if (bIsValidBounds)
+        {
+            Node.Bounds = FBox(FVector(BoundsMin), FVector(BoundsMax));
+        }
+    }
+
+    if (!bIsValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Hierarchy outline is corrupted: %s"), *File_Path);
+        this->Nodes.Reset();
+        this->Meshes.Reset();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,279 @@
+#include "MeshOps_ImportTask.h"
+
+#include "Async/Async.h"
+#include "Components/SceneComponent.h"
+#include "Containers/Ticker.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/Paths.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_MeshBuilder.h"
+
+bool UMeshOps_ImportTask::Start(AActor* In_Target_Actor, const FString& In_ImportPath, const FGLTFImportOptionsStruct& In_Options)
+{
+    check(IsInGameThread());
+
+    if (this->bIsRunning || !IsValid(In_Target_Actor))
+    {
+        return false;
+    }
+
+    this->ImportPath = In_ImportPath;
+    this->Options = In_Options;
+    this->Target_Actor = In_Target_Actor;
+    this->Import_Root = nullptr;
+    this->Meshes.Reset();
+
+    // Task has to survive until completion even if caller doesn't keep a reference.
+    this->AddToRoot();
+    this->bIsRunning = true;
+
+    Async(EAsyncExecution::ThreadPool, [this]()
+        {
+            FString Error;
+            const double StartTime = FPlatformTime::Seconds();
+            const bool bIsRead = FMeshOps_GLTFReader::Read(this->ImportPath, this->Options.ImportUniformScale, this->Scene, Error);
+            const double ReadTime = FPlatformTime::Seconds() - StartTime;
+
+            AsyncTask(ENamedThreads::GameThread, [this, bIsRead, Error, ReadTime]()
+                {
+                    if (!bIsRead)
+                    {
+                        this->Finish(false, Error);
+                        return;
+                    }
+
+                    this->Read_Time = ReadTime;
+                    this->Build_Start_Time = FPlatformTime::Seconds();
+                    this->CreateMaterials();
+
+                    if (this->bIsRunning)
+                    {
+                        this->Ticker_Handle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMeshOps_ImportTask::TickBuild));
+                    }
+                });
+        });
+
+    return true;
+}
+
+void UMeshOps_ImportTask::CreateMaterials()
+{
+    check(IsInGameThread());
+
+    AActor* Target = this->Target_Actor.Get();
+
+    if (!IsValid(Target))
+    {
+        this->Finish(false, TEXT("Target actor is destroyed while file was read."));
+        return;
+    }
+
+    UMaterialInterface* Base_Material = this->Options.Base_Material;
+    this->Materials.Reset(this->Scene.Materials.Num());
+
+    for (const FMeshOps_ImportScene::FMaterial& Each_Material : this->Scene.Materials)
+    {
+        UMaterialInstanceDynamic* Instance = Base_Material ? UMaterialInstanceDynamic::Create(Base_Material, Target) : nullptr;
+
+        if (Instance)
+        {
+            Instance->SetVectorParameterValue(this->Options.BaseColor_Parameter, Each_Material.BaseColor);
+            Instance->SetScalarParameterValue(this->Options.Metallic_Parameter, Each_Material.Metallic);
+            Instance->SetScalarParameterValue(this->Options.Roughness_Parameter, Each_Material.Roughness);
+            Instance->SetVectorParameterValue(this->Options.Emissive_Parameter, Each_Material.Emissive);
+        }
+
+        this->Materials.Add(Instance ? Instance : Base_Material);
+    }
+
+    this->Meshes.SetNum(this->Scene.Meshes.Num());
+    this->Next_Mesh = 0;
+    this->Node_Stack.Reset();
+    this->Node_Components.Reset();
+}
+
+bool UMeshOps_ImportTask::TickBuild(float DeltaTime)
+{
+    // Each tick builds at least one mesh or component, so small budgets still finish.
+    const double Deadline = FPlatformTime::Seconds() + FMath::Max(this->Options.Build_Budget_Ms, 0.f) / 1000.0;
+
+    do
+    {
+        if (!this->BuildNext())
+        {
+            this->Ticker_Handle.Reset();
+            return false;
+        }
+    }
+    while (FPlatformTime::Seconds() < Deadline);
+
+    return true;
+}
+
+bool UMeshOps_ImportTask::BuildNext()
+{
+    check(IsInGameThread());
+
+    AActor* Target = this->Target_Actor.Get();
+
+    if (!IsValid(Target))
+    {
+        this->Finish(false, TEXT("Target actor is destroyed while components were created."));
+        return false;
+    }
+
+    // Meshes first, one per step.
+    if (this->Next_Mesh < this->Scene.Meshes.Num())
+    {
+        const int32 MeshIndex = this->Next_Mesh++;
+        const FMeshOps_ImportScene::FMesh& Mesh = this->Scene.Meshes[MeshIndex];
+
+        if (!Mesh.Buffers.IsValid() || Mesh.Buffers.Sections.IsEmpty())
+        {
+            return true;
+        }
+
+        UMaterialInterface* Base_Material = this->Options.Base_Material;
+        TArray<UMaterialInterface*> Slots;
+
+        for (const int32 Each_Material : Mesh.Materials)
+        {
+            Slots.Add(this->Materials.IsValidIndex(Each_Material) ? this->Materials[Each_Material].Get() : Base_Material);
+        }
+
+        const FMeshOps_MeshBuilder::ECollisionType CollisionType = this->Options.bCreateCollision ? FMeshOps_MeshBuilder::ECollisionType::BoxAndConvex : FMeshOps_MeshBuilder::ECollisionType::None;
+        const FName Mesh_Name = MakeUniqueObjectName(GetTransientPackage(), UStaticMesh::StaticClass(), FName(*SlugStringForValidName(Mesh.Name, TEXT("_"))));
+        this->Meshes[MeshIndex] = FMeshOps_MeshBuilder::BuildStaticMesh(Mesh_Name, MakeArrayView(&Mesh.Buffers, 1), Slots, CollisionType, this->Options.bSupportRayTracing);
+
+        return true;
+    }
+
+    const EComponentMobility::Type Mobility = this->Options.Mobility;
+
+    if (!this->Import_Root)
+    {
+        this->Import_Root = UMeshOperationsBPLibrary::AddSceneCompWithName(Target, FTransform::Identity, MakeUniqueObjectName(Target, USceneComponent::StaticClass(), FName(*SlugStringForValidName(FPaths::GetBaseFilename(this->ImportPath), TEXT("_")))), false, EAttachmentRule::KeepRelative, Mobility);
+
+        if (!IsValid(this->Import_Root))
+        {
+            this->Finish(false, TEXT("Import root can't be created."));
+            return false;
+        }
+
+        this->Import_Root->RegisterComponent();
+
+        // Parents are created before their children, so each node is attached as soon as it is created.
+        this->Node_Components.SetNumZeroed(this->Scene.Nodes.Num());
+
+        for (int32 RootIndex = this->Scene.RootNodes.Num() - 1; RootIndex >= 0; RootIndex--)
+        {
+            this->Node_Stack.Add(this->Scene.RootNodes[RootIndex]);
+        }
+
+        return true;
+    }
+
+    if (this->Node_Stack.IsEmpty())
+    {
+        UMeshOperationsBPLibrary::NotifyHierarchyChanged(this->Import_Root);
+
+        UE_LOG(LogTemp, Log, TEXT("GLTF Import : %s is imported. %d nodes, %d meshes, read %.3f s, build %.3f s."), *this->ImportPath, this->Scene.Nodes.Num(), this->Scene.Meshes.Num(), this->Read_Time, FPlatformTime::Seconds() - this->Build_Start_Time);
+
+        this->Finish(true, this->ImportPath);
+        return false;
+    }
+
+    const int32 NodeIndex = this->Node_Stack.Pop();
+    const FMeshOps_ImportScene::FNode& Node = this->Scene.Nodes[NodeIndex];
+    USceneComponent* Parent = Node.Parent == INDEX_NONE ? this->Import_Root.Get() : this->Node_Components[Node.Parent].Get();
+
+    // Children of a node which couldn't be created are skipped with it.
+    if (!IsValid(Parent))
+    {
+        return true;
+    }
+
+    UStaticMesh* StaticMesh = Node.Mesh == INDEX_NONE ? nullptr : this->Meshes[Node.Mesh].Get();
+    const FString Name = SlugStringForValidName(Node.Name, TEXT("_"));
+    USceneComponent* Component = nullptr;
+
+    if (StaticMesh)
+    {
+        Component = UMeshOperationsBPLibrary::AddStaticMeshCompWithName(Target, StaticMesh, Node.Transform, MakeUniqueObjectName(Target, UStaticMeshComponent::StaticClass(), FName(*Name)), true, EAttachmentRule::KeepRelative, Mobility);
+    }
+
+    else
+    {
+        Component = UMeshOperationsBPLibrary::AddSceneCompWithName(Target, Node.Transform, MakeUniqueObjectName(Target, USceneComponent::StaticClass(), FName(*Name)), true, EAttachmentRule::KeepRelative, Mobility);
+
+        if (IsValid(Component))
+        {
+            Component->RegisterComponent();
+        }
+    }
+
+    if (!IsValid(Component))
+    {
+        return true;
+    }
+
+    Component->AttachToComponent(Parent, FAttachmentTransformRules::KeepRelativeTransform);
+    this->Node_Components[NodeIndex] = Component;
+
+    for (int32 ChildIndex = Node.Children.Num() - 1; ChildIndex >= 0; ChildIndex--)
+    {
+        this->Node_Stack.Add(Node.Children[ChildIndex]);
+    }
+
+    return true;
+}
+
+void UMeshOps_ImportTask::Finish(bool bIsSuccessful, const FString& Message)
+{
+    check(IsInGameThread());
+
+    if (this->Ticker_Handle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(this->Ticker_Handle);
+        this->Ticker_Handle.Reset();
+    }
+
+    // Render data is copied to static meshes, so buffers aren't needed anymore.
+    this->Scene = FMeshOps_ImportScene();
+    this->Materials.Reset();
+    this->Node_Stack.Reset();
+    this->Node_Components.Reset();
+    this->bIsRunning = false;
+
+    this->OnCompleted.Broadcast(bIsSuccessful, Message);
+    this->RemoveFromRoot();
+}
+
+bool UMeshOps_ImportTask::IsRunning() const
+{
+    return this->bIsRunning;
+}
+
+USceneComponent* UMeshOps_ImportTask::GetImportRoot() const
+{
+    return this->Import_Root;
+}
+
+TArray<UStaticMesh*> UMeshOps_ImportTask::GetMeshes() const
+{
+    TArray<UStaticMesh*> Result;
+
+    for (const TObjectPtr<UStaticMesh>& Each_Mesh : this->Meshes)
+    {
+        if (Each_Mesh)
+        {
+            Result.Add(Each_Mesh);
+        }
+    }
+
+    return Result;
+}
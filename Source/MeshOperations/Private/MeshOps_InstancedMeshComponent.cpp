@@ -0,0 +1,93 @@
+#include "MeshOps_InstancedMeshComponent.h"
+
+bool UMeshOps_InstancedMeshComponent::RemoveInstance(int32 InstanceIndex)
+{
+	if (!Super::RemoveInstance(InstanceIndex))
+	{
+		return false;
+	}
+
+	// Instanced static mesh component keeps order of remaining instances, so records are removed the same way.
+	if (this->Instance_Records.IsValidIndex(InstanceIndex))
+	{
+		this->Instance_Records.RemoveAt(InstanceIndex);
+	}
+
+	return true;
+}
+
+bool UMeshOps_InstancedMeshComponent::RemoveInstances(const TArray<int32>& InstancesToRemove)
+{
+	TArray<int32> Sorted = InstancesToRemove;
+	Sorted.Sort(TGreater<int32>());
+
+	return this->RemoveInstances(Sorted, true);
+}
+
+bool UMeshOps_InstancedMeshComponent::RemoveInstances(const TArray<int32>& InstancesToRemove, bool bInstanceArrayAlreadySortedInReverseOrder)
+{
+	TArray<int32> Sorted = InstancesToRemove;
+
+	if (!bInstanceArrayAlreadySortedInReverseOrder)
+	{
+		Sorted.Sort(TGreater<int32>());
+	}
+
+	if (!Super::RemoveInstances(Sorted, true))
+	{
+		return false;
+	}
+
+	// Descending order, so removing a record doesn't shift indices of the ones which are removed after it.
+	int32 Previous_Index = INDEX_NONE;
+
+	for (const int32 Each_Index : Sorted)
+	{
+		if (Each_Index != Previous_Index && this->Instance_Records.IsValidIndex(Each_Index))
+		{
+			this->Instance_Records.RemoveAt(Each_Index);
+		}
+
+		Previous_Index = Each_Index;
+	}
+
+	return true;
+}
+
+void UMeshOps_InstancedMeshComponent::ClearInstances()
+{
+	Super::ClearInstances();
+	this->Instance_Records.Reset();
+}
+
+int32 UMeshOps_InstancedMeshComponent::AddInstanceWithRecord(const FTransform& InstanceTransform, const FMeshInstanceRecordStruct& Record, bool bWorldSpace)
+{
+	const int32 InstanceIndex = this->AddInstance(InstanceTransform, bWorldSpace);
+
+	if (InstanceIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// Instances added without record get empty ones, so indices stay aligned.
+	this->Instance_Records.SetNum(InstanceIndex + 1);
+	this->Instance_Records[InstanceIndex] = Record;
+
+	return InstanceIndex;
+}
+
+bool UMeshOps_InstancedMeshComponent::GetInstanceRecord(int32 InstanceIndex, FMeshInstanceRecordStruct& Out_Record) const
+{
+	if (!this->Instance_Records.IsValidIndex(InstanceIndex))
+	{
+		return false;
+	}
+
+	Out_Record = this->Instance_Records[InstanceIndex];
+	return true;
+}
+
+int32 UMeshOps_InstancedMeshComponent::FindInstanceByTag(FName Tag) const
+{
+	return this->Instance_Records.IndexOfByPredicate([Tag](const FMeshInstanceRecordStruct& Each_Record) { return Each_Record.Tags.Contains(Tag); });
+}
@@ -0,0 +1,453 @@
+#include "MeshOps_Instancing.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Hash/xxhash.h"
+#include "StaticMeshResources.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_BoundsCache.h"
+#include "MeshOps_InstancedMeshComponent.h"
+
+namespace MeshOps_Instancing_Private
+{
+    struct FCachedHash
+    {
+        uint64 Hash = 0;
+
+        // Render data is recreated when a mesh is rebuilt. We use it to detect stale hashes.
+        const FStaticMeshRenderData* RenderData = nullptr;
+    };
+
+    // Cache is only accessed from game thread. Hashes themselves are computed on workers.
+    static TMap<TWeakObjectPtr<const UStaticMesh>, FCachedHash>& GetHashCache()
+    {
+        static TMap<TWeakObjectPtr<const UStaticMesh>, FCachedHash> HashCache;
+        return HashCache;
+    }
+
+    static const FCachedHash* FindValidHash(const UStaticMesh* StaticMesh)
+    {
+        const FCachedHash* Found = GetHashCache().Find(StaticMesh);
+
+        if (Found && Found->RenderData == StaticMesh->GetRenderData())
+        {
+            return Found;
+        }
+
+        return nullptr;
+    }
+
+    // Every vertex stream of LOD 0 as raw bytes. Streams are empty if CPU copies of mesh buffers aren't available.
+    struct FGeometryStreams
+    {
+        TArrayView<const uint8> Positions;
+        TArrayView<const uint8> Tangents;
+        TArrayView<const uint8> TexCoords;
+        TArrayView<const uint8> Colors;
+        uint32 Layout[4] = { 0, 0, 0, 0 };
+        const FStaticMeshLODResources* LOD = nullptr;
+    };
+
+    static bool GetGeometryStreams(const UStaticMesh* StaticMesh, FGeometryStreams& Out_Streams)
+    {
+        const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+
+        // Packaged builds discard CPU copies of mesh buffers unless mesh allows CPU access.
+        const bool bHasCPUData = WITH_EDITOR || StaticMesh->bAllowCPUAccess;
+
+        if (!bHasCPUData || !RenderData || RenderData->LODResources.IsEmpty())
+        {
+            return false;
+        }
+
+        const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+        const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+        const FStaticMeshVertexBuffer& VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+        const FColorVertexBuffer& Colors = LOD.VertexBuffers.ColorVertexBuffer;
+        const uint32 NumVertices = Positions.GetNumVertices();
+
+        if (NumVertices == 0 || !Positions.GetVertexData() || (VertexBuffer.GetNumVertices() > 0 && (!VertexBuffer.GetTangentData() || !VertexBuffer.GetTexCoordData())))
+        {
+            return false;
+        }
+
+        Out_Streams.LOD = &LOD;
+        Out_Streams.Positions = TArrayView<const uint8>((const uint8*)Positions.GetVertexData(), NumVertices * Positions.GetStride());
+
+        if (VertexBuffer.GetNumVertices() > 0)
+        {
+            Out_Streams.Tangents = TArrayView<const uint8>((const uint8*)VertexBuffer.GetTangentData(), VertexBuffer.GetTangentSize());
+            Out_Streams.TexCoords = TArrayView<const uint8>((const uint8*)VertexBuffer.GetTexCoordData(), VertexBuffer.GetTexCoordSize());
+        }
+
+        if (Colors.GetNumVertices() > 0 && Colors.GetVertexData())
+        {
+            Out_Streams.Colors = TArrayView<const uint8>((const uint8*)Colors.GetVertexData(), Colors.GetNumVertices() * Colors.GetStride());
+        }
+
+        // Same bytes mean different things with another precision or UV count, so layout is a part of the geometry.
+        Out_Streams.Layout[0] = NumVertices;
+        Out_Streams.Layout[1] = VertexBuffer.GetNumTexCoords();
+        Out_Streams.Layout[2] = VertexBuffer.GetUseHighPrecisionTangentBasis() ? 1 : 0;
+        Out_Streams.Layout[3] = VertexBuffer.GetUseFullPrecisionUVs() ? 1 : 0;
+
+        return true;
+    }
+
+    static uint64 ComputeGeometryHash(const UStaticMesh* StaticMesh)
+    {
+        FGeometryStreams Streams;
+
+        if (GetGeometryStreams(StaticMesh, Streams))
+        {
+            FXxHash64Builder Builder;
+            Builder.Update(Streams.Layout, sizeof(Streams.Layout));
+            Builder.Update(Streams.Positions.GetData(), Streams.Positions.Num());
+            Builder.Update(Streams.Tangents.GetData(), Streams.Tangents.Num());
+            Builder.Update(Streams.TexCoords.GetData(), Streams.TexCoords.Num());
+            Builder.Update(Streams.Colors.GetData(), Streams.Colors.Num());
+
+            // Same geometry can be stored with 16 or 32 bit indices, so indices are always hashed as 32 bit.
+            TArray<uint32> Indices;
+            Streams.LOD->IndexBuffer.GetCopy(Indices);
+            Builder.Update(Indices.GetData(), Indices.Num() * sizeof(uint32));
+
+            for (const FStaticMeshSection& Each_Section : Streams.LOD->Sections)
+            {
+                const uint32 Section[3] = { (uint32)Each_Section.MaterialIndex, Each_Section.FirstIndex, Each_Section.NumTriangles };
+                Builder.Update(Section, sizeof(Section));
+            }
+
+            return Builder.Finalize().Hash;
+        }
+
+        const UPTRINT Address = (UPTRINT)StaticMesh;
+        return FXxHash64::HashBuffer(&Address, sizeof(Address)).Hash;
+    }
+
+    static bool IsSameBytes(TArrayView<const uint8> A, TArrayView<const uint8> B)
+    {
+        return A.Num() == B.Num() && (A.Num() == 0 || FMemory::Memcmp(A.GetData(), B.GetData(), A.Num()) == 0);
+    }
+
+    static void GetMaterials(const UStaticMeshComponent* Component, TArray<const UMaterialInterface*>& Out_Materials)
+    {
+        Out_Materials.Reset(Component->GetNumMaterials());
+
+        for (int32 MaterialIndex = 0; MaterialIndex < Component->GetNumMaterials(); MaterialIndex++)
+        {
+            Out_Materials.Add(Component->GetMaterial(MaterialIndex));
+        }
+    }
+
+    struct FGroupKey
+    {
+        const UStaticMesh* StaticMesh = nullptr;
+        TArray<const UMaterialInterface*> Materials;
+    };
+}
+
+uint64 FMeshOps_Instancing::GetGeometryHash(const UStaticMesh* StaticMesh)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_Instancing_Private;
+
+    if (!IsValid(StaticMesh))
+    {
+        return 0;
+    }
+
+    if (const FCachedHash* Found = FindValidHash(StaticMesh))
+    {
+        return Found->Hash;
+    }
+
+    FCachedHash& NewEntry = GetHashCache().Add(StaticMesh);
+    NewEntry.Hash = ComputeGeometryHash(StaticMesh);
+    NewEntry.RenderData = StaticMesh->GetRenderData();
+
+    return NewEntry.Hash;
+}
+
+bool FMeshOps_Instancing::HasSameGeometry(const UStaticMesh* A, const UStaticMesh* B)
+{
+    using namespace MeshOps_Instancing_Private;
+
+    if (A == B)
+    {
+        return true;
+    }
+
+    if (!IsValid(A) || !IsValid(B))
+    {
+        return false;
+    }
+
+    FGeometryStreams Streams_A;
+    FGeometryStreams Streams_B;
+
+    // Without CPU data only the same asset is the same geometry.
+    if (!GetGeometryStreams(A, Streams_A) || !GetGeometryStreams(B, Streams_B))
+    {
+        return false;
+    }
+
+    if (FMemory::Memcmp(Streams_A.Layout, Streams_B.Layout, sizeof(Streams_A.Layout)) != 0
+        || !IsSameBytes(Streams_A.Positions, Streams_B.Positions)
+        || !IsSameBytes(Streams_A.Tangents, Streams_B.Tangents)
+        || !IsSameBytes(Streams_A.TexCoords, Streams_B.TexCoords)
+        || !IsSameBytes(Streams_A.Colors, Streams_B.Colors))
+    {
+        return false;
+    }
+
+    const TArray<FStaticMeshSection>& Sections_A = Streams_A.LOD->Sections;
+    const TArray<FStaticMeshSection>& Sections_B = Streams_B.LOD->Sections;
+
+    if (Sections_A.Num() != Sections_B.Num())
+    {
+        return false;
+    }
+
+    for (int32 SectionIndex = 0; SectionIndex < Sections_A.Num(); SectionIndex++)
+    {
+        if (Sections_A[SectionIndex].MaterialIndex != Sections_B[SectionIndex].MaterialIndex || Sections_A[SectionIndex].FirstIndex != Sections_B[SectionIndex].FirstIndex || Sections_A[SectionIndex].NumTriangles != Sections_B[SectionIndex].NumTriangles)
+        {
+            return false;
+        }
+    }
+
+    TArray<uint32> Indices_A;
+    TArray<uint32> Indices_B;
+    Streams_A.LOD->IndexBuffer.GetCopy(Indices_A);
+    Streams_B.LOD->IndexBuffer.GetCopy(Indices_B);
+
+    return Indices_A == Indices_B;
+}
+
+void FMeshOps_Instancing::PrecacheGeometryHashes(TArrayView<const UStaticMesh* const> StaticMeshes)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_Instancing_Private;
+
+    TSet<const UStaticMesh*> Checked;
+    TArray<const UStaticMesh*> Missing;
+
+    for (const UStaticMesh* Each_Mesh : StaticMeshes)
+    {
+        bool bIsChecked = false;
+        Checked.Add(Each_Mesh, &bIsChecked);
+
+        if (!bIsChecked && IsValid(Each_Mesh) && !FindValidHash(Each_Mesh))
+        {
+            Missing.Add(Each_Mesh);
+        }
+    }
+
+    TArray<uint64> Hashes;
+    Hashes.SetNumZeroed(Missing.Num());
+
+    ParallelFor(Missing.Num(), [&Missing, &Hashes](int32 Index)
+        {
+            Hashes[Index] = ComputeGeometryHash(Missing[Index]);
+        }
+    );
+
+    for (int32 Index = 0; Index < Missing.Num(); Index++)
+    {
+        FCachedHash& NewEntry = GetHashCache().Add(Missing[Index]);
+        NewEntry.Hash = Hashes[Index];
+        NewEntry.RenderData = Missing[Index]->GetRenderData();
+    }
+}
+
+void FMeshOps_Instancing::ResetCache()
+{
+    check(IsInGameThread());
+    MeshOps_Instancing_Private::GetHashCache().Empty();
+}
+
+void FMeshOps_Instancing::GroupComponents(TArrayView<UStaticMeshComponent* const> Components, bool bMatchGeometry, int32 MinInstances, TArray<TArray<UStaticMeshComponent*>>& Out_Groups)
+{
+    using namespace MeshOps_Instancing_Private;
+
+    Out_Groups.Reset();
+
+    if (bMatchGeometry)
+    {
+        TArray<const UStaticMesh*> StaticMeshes;
+        StaticMeshes.Reserve(Components.Num());
+
+        for (const UStaticMeshComponent* Each_Component : Components)
+        {
+            StaticMeshes.Add(Each_Component->GetStaticMesh());
+        }
+
+        FMeshOps_Instancing::PrecacheGeometryHashes(StaticMeshes);
+    }
+
+    // Group order follows first appearance in the hierarchy, so results are stable between calls.
+    // Hash only finds candidate groups. Mesh geometry and material arrays are compared before a component joins a group.
+    TMap<uint64, TArray<int32, TInlineAllocator<1>>> GroupsByHash;
+    TArray<FGroupKey> GroupKeys;
+
+    // Separately imported copies are compared once per mesh pair, not once per component.
+    TMap<TPair<const UStaticMesh*, const UStaticMesh*>, bool> SameGeometry;
+    TArray<const UMaterialInterface*> Materials;
+
+    for (UStaticMeshComponent* Each_Component : Components)
+    {
+        const UStaticMesh* StaticMesh = Each_Component->GetStaticMesh();
+        const uint64 MeshHash = bMatchGeometry ? FMeshOps_Instancing::GetGeometryHash(StaticMesh) : (uint64)(UPTRINT)StaticMesh;
+        GetMaterials(Each_Component, Materials);
+
+        TArray<int32, TInlineAllocator<1>>& Candidates = GroupsByHash.FindOrAdd(MeshHash);
+        int32 GroupIndex = INDEX_NONE;
+
+        for (const int32 Each_Candidate : Candidates)
+        {
+            const FGroupKey& Key = GroupKeys[Each_Candidate];
+
+            if (Key.Materials != Materials)
+            {
+                continue;
+            }
+
+            if (Key.StaticMesh != StaticMesh)
+            {
+                if (!bMatchGeometry)
+                {
+                    continue;
+                }
+
+                const TPair<const UStaticMesh*, const UStaticMesh*> Pair(Key.StaticMesh, StaticMesh);
+                const bool* Found = SameGeometry.Find(Pair);
+
+                if (!(Found ? *Found : SameGeometry.Add(Pair, FMeshOps_Instancing::HasSameGeometry(Key.StaticMesh, StaticMesh))))
+                {
+                    continue;
+                }
+            }
+
+            GroupIndex = Each_Candidate;
+            break;
+        }
+
+        if (GroupIndex == INDEX_NONE)
+        {
+            GroupIndex = Out_Groups.AddDefaulted();
+            Candidates.Add(GroupIndex);
+
+            FGroupKey& NewKey = GroupKeys.AddDefaulted_GetRef();
+            NewKey.StaticMesh = StaticMesh;
+            NewKey.Materials = Materials;
+        }
+
+        Out_Groups[GroupIndex].Add(Each_Component);
+    }
+
+    Out_Groups.RemoveAll([MinInstances](const TArray<UStaticMeshComponent*>& Each_Group) { return Each_Group.Num() < FMath::Max(MinInstances, 1); });
+}
+
+int32 FMeshOps_Instancing::ConvertToInstances(USceneComponent* AssetRoot, bool bMatchGeometry, int32 MinInstances, TArray<UMeshOps_InstancedMeshComponent*>& Out_Instanced)
+{
+    Out_Instanced.Reset();
+
+    if (!IsValid(AssetRoot))
+    {
+        return 0;
+    }
+
+    TArray<USceneComponent*> Children;
+    AssetRoot->GetChildrenComponents(true, Children);
+
+    TArray<UStaticMeshComponent*> Candidates;
+
+    for (USceneComponent* Each_Child : Children)
+    {
+        // Subclasses like instanced or spline mesh components have their own rendering, so only plain static mesh components are converted.
+        if (!IsValid(Each_Child) || Each_Child->GetClass() != UStaticMeshComponent::StaticClass() || Each_Child->GetNumChildrenComponents() > 0)
+        {
+            continue;
+        }
+
+        UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Each_Child);
+
+        if (IsValid(StaticMeshComp->GetStaticMesh()))
+        {
+            Candidates.Add(StaticMeshComp);
+        }
+    }
+
+    TArray<TArray<UStaticMeshComponent*>> Groups;
+    FMeshOps_Instancing::GroupComponents(Candidates, bMatchGeometry, MinInstances, Groups);
+
+    int32 ReplacedCount = 0;
+
+    // Asset root gets the instanced components, parents of replaced components lose children.
+    TSet<USceneComponent*> Changed_Parents;
+    Changed_Parents.Add(AssetRoot);
+
+    for (const TArray<UStaticMeshComponent*>& Each_Group : Groups)
+    {
+        const UStaticMeshComponent* First = Each_Group[0];
+        const FName BaseName = *FString::Printf(TEXT("Instances_%s"), *First->GetStaticMesh()->GetName());
+
+        UMeshOps_InstancedMeshComponent* Instanced = NewObject<UMeshOps_InstancedMeshComponent>(AssetRoot->GetOuter(), MakeUniqueObjectName(AssetRoot->GetOuter(), UMeshOps_InstancedMeshComponent::StaticClass(), BaseName));
+        Instanced->SetMobility(First->Mobility);
+        Instanced->SetStaticMesh(First->GetStaticMesh());
+        Instanced->SetCollisionProfileName(First->GetCollisionProfileName());
+        Instanced->SetCollisionEnabled(First->GetCollisionEnabled());
+        Instanced->SetCastShadow(First->CastShadow);
+
+        for (int32 MaterialIndex = 0; MaterialIndex < First->GetNumMaterials(); MaterialIndex++)
+        {
+            Instanced->SetMaterial(MaterialIndex, First->GetMaterial(MaterialIndex));
+        }
+
+        Instanced->AttachToComponent(AssetRoot, FAttachmentTransformRules::KeepRelativeTransform);
+        Instanced->RegisterComponent();
+
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(Each_Group.Num());
+
+        TArray<FMeshInstanceRecordStruct> Records;
+        Records.Reserve(Each_Group.Num());
+
+        for (UStaticMeshComponent* Each_Component : Each_Group)
+        {
+            Transforms.Add(Each_Component->GetComponentTransform());
+
+            FMeshInstanceRecordStruct& Record = Records.AddDefaulted_GetRef();
+            Record.Source_Name = UMeshOperationsBPLibrary::GetObjectNameForPackage(Each_Component);
+            Record.Tags = Each_Component->ComponentTags;
+        }
+
+        // Adding all instances at once rebuilds render state only once.
+        Instanced->AddInstances(Transforms, false, true);
+        Instanced->Instance_Records = MoveTemp(Records);
+
+        for (UStaticMeshComponent* Each_Component : Each_Group)
+        {
+            Changed_Parents.Add(Each_Component->GetAttachParent());
+            Each_Component->DestroyComponent(false);
+        }
+
+        ReplacedCount += Each_Group.Num();
+        Out_Instanced.Add(Instanced);
+    }
+
+    if (ReplacedCount > 0)
+    {
+        FMeshOps_BoundsCache::Reset(AssetRoot);
+
+        for (USceneComponent* Each_Parent : Changed_Parents)
+        {
+            UMeshOperationsBPLibrary::NotifyHierarchyChanged(Each_Parent);
+        }
+    }
+
+    return ReplacedCount;
+}
@@ -0,0 +1,486 @@
+#include "MeshOps_MeshBuilder.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshResources.h"
+
+// Cell coordinates are packed to 20 bits per axis in cluster keys.
+#define CLUSTER_MAX_CELLS ((1 << 20) - 1)
+
+namespace MeshOps_MeshBuilder_Private
+{
+    static FBox GetBounds(const TArray<FVector3f>& Positions)
+    {
+        FBox3f Bounds(ForceInit);
+
+        for (const FVector3f& Each_Position : Positions)
+        {
+            Bounds += Each_Position;
+        }
+
+        return FBox(Bounds);
+    }
+
+    static FVector3f GetAnyTangent(const FVector3f& Normal)
+    {
+        const FVector3f Up = FMath::Abs(Normal.Z) < 0.999f ? FVector3f::UpVector : FVector3f::ForwardVector;
+        return FVector3f::CrossProduct(Up, Normal).GetSafeNormal();
+    }
+
+    static void FillLODResources(const FMeshOps_MeshBuffers& Buffers, FStaticMeshLODResources& LOD_Resource)
+    {
+        const int32 NumVertices = Buffers.GetNumVertices();
+
+        LOD_Resource.IndexBuffer.SetIndices(Buffers.Indices, NumVertices > MAX_uint16 ? EIndexBufferStride::Force32Bit : EIndexBufferStride::Force16Bit);
+        LOD_Resource.VertexBuffers.PositionVertexBuffer.Init(Buffers.Positions);
+        LOD_Resource.VertexBuffers.ColorVertexBuffer.InitFromSingleColor(FColor::White, NumVertices);
+
+        FStaticMeshVertexBuffer& VertexBuffer = LOD_Resource.VertexBuffers.StaticMeshVertexBuffer;
+        VertexBuffer.SetUseFullPrecisionUVs(true);
+        VertexBuffer.Init(NumVertices, 1);
+
+        ParallelFor(NumVertices, [&Buffers, &VertexBuffer](int32 VertexIndex)
+            {
+                const FVector3f Normal = Buffers.Normals.IsEmpty() ? FVector3f::UpVector : Buffers.Normals[VertexIndex];
+                const FVector3f Tangent = Buffers.Tangents.IsEmpty() ? GetAnyTangent(Normal) : Buffers.Tangents[VertexIndex];
+                const float TangentSign = Buffers.TangentSigns.IsEmpty() ? 1.f : Buffers.TangentSigns[VertexIndex];
+                const FVector3f Binormal = FVector3f::CrossProduct(Normal, Tangent).GetSafeNormal() * TangentSign;
+
+                VertexBuffer.SetVertexTangents(VertexIndex, Tangent, Binormal, Normal);
+                VertexBuffer.SetVertexUV(VertexIndex, 0, Buffers.UVs.IsEmpty() ? FVector2f::ZeroVector : Buffers.UVs[VertexIndex]);
+            }, NumVertices < 4096 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+        LOD_Resource.Sections.Empty(Buffers.Sections.Num());
+
+        for (const FMeshOps_MeshBuffers::FSection& Each_Section : Buffers.Sections)
+        {
+            FStaticMeshSection& NewSection = LOD_Resource.Sections.AddDefaulted_GetRef();
+            NewSection.MaterialIndex = Each_Section.MaterialIndex;
+            NewSection.FirstIndex = Each_Section.FirstIndex;
+            NewSection.NumTriangles = Each_Section.NumTriangles;
+            NewSection.MinVertexIndex = Each_Section.MinVertexIndex;
+            NewSection.MaxVertexIndex = Each_Section.MaxVertexIndex;
+        }
+    }
+}
+
+bool FMeshOps_MeshBuffers::IsValid() const
+{
+    const int32 NumVertices = this->GetNumVertices();
+
+    if (NumVertices == 0 || this->Indices.IsEmpty() || this->Indices.Num() % 3 != 0 || this->Sections.IsEmpty())
+    {
+        return false;
+    }
+
+    if ((!this->Normals.IsEmpty() && this->Normals.Num() != NumVertices) || (!this->Tangents.IsEmpty() && this->Tangents.Num() != NumVertices) || (!this->TangentSigns.IsEmpty() && this->TangentSigns.Num() != this->Tangents.Num()) || (!this->UVs.IsEmpty() && this->UVs.Num() != NumVertices))
+    {
+        return false;
+    }
+
+    for (const uint32 Each_Index : this->Indices)
+    {
+        if (Each_Index >= (uint32)NumVertices)
+        {
+            return false;
+        }
+    }
+
+    for (const FSection& Each_Section : this->Sections)
+    {
+        if (Each_Section.MaterialIndex < 0 || (uint64)Each_Section.FirstIndex + Each_Section.NumTriangles * 3 > (uint64)this->Indices.Num())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FMeshOps_MeshBuffers::Reset()
+{
+    this->Positions.Reset();
+    this->Normals.Reset();
+    this->Tangents.Reset();
+    this->TangentSigns.Reset();
+    this->UVs.Reset();
+    this->Indices.Reset();
+    this->Sections.Reset();
+}
+
+void FMeshOps_MeshBuffers::AddSingleSection(int32 MaterialIndex)
+{
+    FSection& NewSection = this->Sections.AddDefaulted_GetRef();
+    NewSection.MaterialIndex = MaterialIndex;
+    NewSection.FirstIndex = 0;
+    NewSection.NumTriangles = this->Indices.Num() / 3;
+    NewSection.MinVertexIndex = 0;
+    NewSection.MaxVertexIndex = FMath::Max(this->GetNumVertices() - 1, 0);
+}
+
+UStaticMesh* FMeshOps_MeshBuilder::BuildStaticMesh(FName Mesh_Name, TArrayView<const FMeshOps_MeshBuffers> LODs, TArrayView<UMaterialInterface* const> Materials, ECollisionType CollisionType, bool bSupportRayTracing, TArrayView<const float> ScreenSizes)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_MeshBuilder_Private;
+
+    // Levels after an invalid one are ignored, because LOD chain can't have holes.
+    int32 NumLODs = 0;
+
+    while (NumLODs < FMath::Min(LODs.Num(), (int32)MAX_STATIC_MESH_LODS) && LODs[NumLODs].IsValid())
+    {
+        NumLODs++;
+    }
+
+    if (NumLODs == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Mesh buffers of %s are not valid."), *Mesh_Name.ToString());
+        return nullptr;
+    }
+
+    int32 NumMaterials = 1;
+
+    for (int32 LOD_Index = 0; LOD_Index < NumLODs; LOD_Index++)
+    {
+        for (const FMeshOps_MeshBuffers::FSection& Each_Section : LODs[LOD_Index].Sections)
+        {
+            NumMaterials = FMath::Max(NumMaterials, Each_Section.MaterialIndex + 1);
+        }
+    }
+
+    UStaticMesh* StaticMesh = CreateStaticMesh(Mesh_Name, NumLODs, NumMaterials, Materials, bSupportRayTracing);
+
+    if (!StaticMesh)
+    {
+        return nullptr;
+    }
+
+    FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    float ScreenSize = 1.0f;
+
+    for (int32 LOD_Index = 0; LOD_Index < NumLODs; LOD_Index++)
+    {
+        FillLODResources(LODs[LOD_Index], RenderData->LODResources[LOD_Index]);
+
+        ScreenSize = ScreenSizes.IsValidIndex(LOD_Index) ? ScreenSizes[LOD_Index] : (LOD_Index == 0 ? 1.0f : ScreenSize * 0.5f);
+        RenderData->ScreenSize[LOD_Index].Default = ScreenSize;
+    }
+
+    FinalizeStaticMesh(StaticMesh, GetBounds(LODs[0].Positions), CollisionType, LODs[0].Positions);
+
+    return StaticMesh;
+}
+
+UStaticMesh* FMeshOps_MeshBuilder::CreateStaticMesh(FName Mesh_Name, int32 NumLODs, int32 NumMaterials, TArrayView<UMaterialInterface* const> Materials, bool bSupportRayTracing)
+{
+    check(IsInGameThread());
+
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(GetTransientPackage(), Mesh_Name.IsNone() ? NAME_None : Mesh_Name, RF_Public | RF_Standalone);
+
+    if (!StaticMesh)
+    {
+        return nullptr;
+    }
+
+    StaticMesh->bAllowCPUAccess = true;
+    StaticMesh->NeverStream = true;
+    StaticMesh->bSupportRayTracing = bSupportRayTracing;
+
+    NumMaterials = FMath::Max3(NumMaterials, Materials.Num(), 1);
+    StaticMesh->GetStaticMaterials().Reserve(NumMaterials);
+
+    for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+    {
+        const FName MaterialSlotName = GetMaterialSlotName(MaterialIndex);
+        StaticMesh->GetStaticMaterials().Add(FStaticMaterial(Materials.IsValidIndex(MaterialIndex) ? Materials[MaterialIndex] : nullptr, MaterialSlotName, MaterialSlotName));
+    }
+
+    StaticMesh->SetRenderData(MakeUnique<FStaticMeshRenderData>());
+    StaticMesh->GetRenderData()->AllocateLODResources(NumLODs);
+
+    return StaticMesh;
+}
+
+FName FMeshOps_MeshBuilder::GetMaterialSlotName(int32 MaterialIndex)
+{
+    return FName(*FString::Printf(TEXT("MaterialSlot_%d"), MaterialIndex));
+}
+
+void FMeshOps_MeshBuilder::FinalizeStaticMesh(UStaticMesh* StaticMesh, const FBox& BoundingBox, ECollisionType CollisionType, TArrayView<const FVector3f> ConvexPoints)
+{
+    check(IsInGameThread());
+
+    FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    RenderData->Bounds = FBoxSphereBounds(BoundingBox);
+
+#if RHI_RAYTRACING
+    if (StaticMesh->bSupportRayTracing)
+    {
+        RenderData->InitializeRayTracingRepresentationFromRenderingLODs();
+    }
+#endif
+
+    // Finalize render data.
+    StaticMesh->InitResources();
+    StaticMesh->CalculateExtendedBounds();
+
+    if (CollisionType == ECollisionType::None)
+    {
+        return;
+    }
+
+    // Same collision with meshes built from descriptions. Triangles of render data are cooked as complex collision.
+    if (CollisionType == ECollisionType::ComplexAsSimple)
+    {
+        StaticMesh->CreateBodySetup();
+        StaticMesh->GetBodySetup()->CollisionTraceFlag = CTF_UseComplexAsSimple;
+        StaticMesh->GetBodySetup()->InvalidatePhysicsData();
+        StaticMesh->GetBodySetup()->CreatePhysicsMeshes();
+        return;
+    }
+
+    UBodySetup* BodySetup = NewObject<UBodySetup>(StaticMesh, NAME_None, RF_Public | RF_Standalone);
+    StaticMesh->SetBodySetup(BodySetup);
+    BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+    BodySetup->bHasCookedCollisionData = true;
+
+    FKBoxElem BoxElem;
+    BoxElem.Center = BoundingBox.GetCenter();
+    BoxElem.X = BoundingBox.GetExtent().X * 2.0f;
+    BoxElem.Y = BoundingBox.GetExtent().Y * 2.0f;
+    BoxElem.Z = BoundingBox.GetExtent().Z * 2.0f;
+    BodySetup->AggGeom.BoxElems.Add(BoxElem);
+
+    if (CollisionType == ECollisionType::BoxAndConvex)
+    {
+        FKConvexElem ConvexElem;
+        ConvexElem.VertexData.Reserve(ConvexPoints.Num());
+
+        for (const FVector3f& Each_Position : ConvexPoints)
+        {
+            ConvexElem.VertexData.Add((FVector)Each_Position);
+        }
+
+        ConvexElem.UpdateElemBox();
+        BodySetup->AggGeom.ConvexElems.Add(ConvexElem);
+    }
+
+    BodySetup->InvalidatePhysicsData();
+    BodySetup->CreatePhysicsMeshes();
+}
+
+bool FMeshOps_MeshBuilder::ReadStaticMesh(const UStaticMesh* StaticMesh, int32 LOD_Index, FMeshOps_MeshBuffers& Out_Buffers)
+{
+    Out_Buffers.Reset();
+
+    if (!::IsValid(StaticMesh))
+    {
+        return false;
+    }
+
+    const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+
+    // Packaged builds discard CPU copies of mesh buffers unless mesh allows CPU access.
+    const bool bHasCPUData = WITH_EDITOR || StaticMesh->bAllowCPUAccess;
+
+    if (!bHasCPUData || !RenderData || !RenderData->LODResources.IsValidIndex(LOD_Index))
+    {
+        return false;
+    }
+
+    const FStaticMeshLODResources& LOD = RenderData->LODResources[LOD_Index];
+    const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+    const FStaticMeshVertexBuffer& VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+    const int32 NumVertices = Positions.GetNumVertices();
+
+    if (NumVertices == 0 || !Positions.GetVertexData() || !VertexBuffer.GetTangentData())
+    {
+        return false;
+    }
+
+    const bool bHasUVs = VertexBuffer.GetNumTexCoords() > 0 && VertexBuffer.GetTexCoordData();
+
+    Out_Buffers.Positions.SetNumUninitialized(NumVertices);
+    Out_Buffers.Normals.SetNumUninitialized(NumVertices);
+    Out_Buffers.Tangents.SetNumUninitialized(NumVertices);
+    Out_Buffers.TangentSigns.SetNumUninitialized(NumVertices);
+    Out_Buffers.UVs.SetNumZeroed(NumVertices);
+
+    for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+    {
+        Out_Buffers.Positions[VertexIndex] = Positions.VertexPosition(VertexIndex);
+        const FVector4f TangentZ = VertexBuffer.VertexTangentZ(VertexIndex);
+
+        Out_Buffers.Normals[VertexIndex] = FVector3f(TangentZ);
+        Out_Buffers.Tangents[VertexIndex] = FVector3f(VertexBuffer.VertexTangentX(VertexIndex));
+        Out_Buffers.TangentSigns[VertexIndex] = TangentZ.W < 0 ? -1.f : 1.f;
+
+        if (bHasUVs)
+        {
+            Out_Buffers.UVs[VertexIndex] = VertexBuffer.GetVertexUV(VertexIndex, 0);
+        }
+    }
+
+    LOD.IndexBuffer.GetCopy(Out_Buffers.Indices);
+
+    for (const FStaticMeshSection& Each_Section : LOD.Sections)
+    {
+        FMeshOps_MeshBuffers::FSection& NewSection = Out_Buffers.Sections.AddDefaulted_GetRef();
+        NewSection.MaterialIndex = Each_Section.MaterialIndex;
+        NewSection.FirstIndex = Each_Section.FirstIndex;
+        NewSection.NumTriangles = Each_Section.NumTriangles;
+        NewSection.MinVertexIndex = Each_Section.MinVertexIndex;
+        NewSection.MaxVertexIndex = Each_Section.MaxVertexIndex;
+    }
+
+    return true;
+}
+
+void FMeshOps_MeshBuilder::SimplifyByClustering(const FMeshOps_MeshBuffers& Source, double CellSize, FMeshOps_MeshBuffers& Out_Simplified)
+{
+    Out_Simplified.Reset();
+
+    const int32 NumVertices = Source.GetNumVertices();
+
+    if (NumVertices == 0)
+    {
+        return;
+    }
+
+    const FBox Bounds = MeshOps_MeshBuilder_Private::GetBounds(Source.Positions);
+
+    // Cells are enlarged if needed, so coordinates always fit to cluster keys.
+    const double MinCellSize = Bounds.GetSize().GetMax() / CLUSTER_MAX_CELLS;
+    const double EffectiveCellSize = FMath::Max3(CellSize, MinCellSize, (double)UE_KINDA_SMALL_NUMBER);
+
+    TArray<uint64> Keys;
+    Keys.SetNumUninitialized(NumVertices);
+
+    ParallelFor(NumVertices, [&Source, &Bounds, &Keys, EffectiveCellSize](int32 VertexIndex)
+        {
+            const FVector Relative = (FVector)Source.Positions[VertexIndex] - Bounds.Min;
+            const uint64 Cell_X = (uint64)FMath::Min(FMath::FloorToInt64(Relative.X / EffectiveCellSize), (int64)CLUSTER_MAX_CELLS);
+            const uint64 Cell_Y = (uint64)FMath::Min(FMath::FloorToInt64(Relative.Y / EffectiveCellSize), (int64)CLUSTER_MAX_CELLS);
+            const uint64 Cell_Z = (uint64)FMath::Min(FMath::FloorToInt64(Relative.Z / EffectiveCellSize), (int64)CLUSTER_MAX_CELLS);
+
+            // Vertices facing different main axes aren't merged, so hard edges of mechanical parts survive.
+            uint64 Facing = 0;
+
+            if (!Source.Normals.IsEmpty())
+            {
+                const FVector3f& Normal = Source.Normals[VertexIndex];
+                const int32 Axis = FMath::Abs(Normal.X) >= FMath::Abs(Normal.Y) && FMath::Abs(Normal.X) >= FMath::Abs(Normal.Z) ? 0 : (FMath::Abs(Normal.Y) >= FMath::Abs(Normal.Z) ? 1 : 2);
+                Facing = Axis * 2 + (Normal[Axis] < 0 ? 1 : 0);
+            }
+
+            Keys[VertexIndex] = Cell_X | (Cell_Y << 20) | (Cell_Z << 40) | (Facing << 60);
+        }, NumVertices < 4096 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    TMap<uint64, int32> Clusters;
+    Clusters.Reserve(NumVertices / 4);
+
+    TArray<int32> Remap;
+    Remap.SetNumUninitialized(NumVertices);
+
+    TArray<FVector> PositionSums;
+    TArray<int32> Counts;
+
+    for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+    {
+        int32& Cluster = Clusters.FindOrAdd(Keys[VertexIndex], INDEX_NONE);
+
+        if (Cluster == INDEX_NONE)
+        {
+            Cluster = PositionSums.Add(FVector::ZeroVector);
+            Counts.Add(0);
+
+            Out_Simplified.Normals.Add(FVector3f::ZeroVector);
+            Out_Simplified.Tangents.Add(FVector3f::ZeroVector);
+
+            // UV and tangent sign of first vertex are used. Averaging would blend across seams.
+            Out_Simplified.UVs.Add(Source.UVs.IsEmpty() ? FVector2f::ZeroVector : Source.UVs[VertexIndex]);
+
+            if (!Source.TangentSigns.IsEmpty())
+            {
+                Out_Simplified.TangentSigns.Add(Source.TangentSigns[VertexIndex]);
+            }
+        }
+
+        Remap[VertexIndex] = Cluster;
+        PositionSums[Cluster] += (FVector)Source.Positions[VertexIndex];
+        Counts[Cluster]++;
+
+        if (!Source.Normals.IsEmpty())
+        {
+            Out_Simplified.Normals[Cluster] += Source.Normals[VertexIndex];
+        }
+
+        // Tangents of mirrored UVs point the other way, so only the ones with the sign of the cluster are averaged.
+        if (!Source.Tangents.IsEmpty() && (Source.TangentSigns.IsEmpty() || Source.TangentSigns[VertexIndex] == Out_Simplified.TangentSigns[Cluster]))
+        {
+            Out_Simplified.Tangents[Cluster] += Source.Tangents[VertexIndex];
+        }
+    }
+
+    const int32 NumClusters = PositionSums.Num();
+    Out_Simplified.Positions.SetNumUninitialized(NumClusters);
+
+    for (int32 Cluster = 0; Cluster < NumClusters; Cluster++)
+    {
+        Out_Simplified.Positions[Cluster] = (FVector3f)(PositionSums[Cluster] / Counts[Cluster]);
+
+        const FVector3f Normal = Out_Simplified.Normals[Cluster].GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+        const FVector3f Tangent = Out_Simplified.Tangents[Cluster] - Normal * FVector3f::DotProduct(Out_Simplified.Tangents[Cluster], Normal);
+
+        Out_Simplified.Normals[Cluster] = Normal;
+        Out_Simplified.Tangents[Cluster] = Tangent.IsNearlyZero() ? MeshOps_MeshBuilder_Private::GetAnyTangent(Normal) : Tangent.GetSafeNormal();
+    }
+
+    Out_Simplified.Indices.Reserve(Source.Indices.Num());
+
+    for (const FMeshOps_MeshBuffers::FSection& Each_Section : Source.Sections)
+    {
+        FMeshOps_MeshBuffers::FSection NewSection;
+        NewSection.MaterialIndex = Each_Section.MaterialIndex;
+        NewSection.FirstIndex = Out_Simplified.Indices.Num();
+        NewSection.MinVertexIndex = MAX_uint32;
+
+        for (uint32 Triangle = 0; Triangle < Each_Section.NumTriangles; Triangle++)
+        {
+            const uint32 First = Each_Section.FirstIndex + Triangle * 3;
+            const uint32 A = Remap[Source.Indices[First]];
+            const uint32 B = Remap[Source.Indices[First + 1]];
+            const uint32 C = Remap[Source.Indices[First + 2]];
+
+            if (A == B || B == C || C == A)
+            {
+                continue;
+            }
+
+            Out_Simplified.Indices.Add(A);
+            Out_Simplified.Indices.Add(B);
+            Out_Simplified.Indices.Add(C);
+
+            NewSection.NumTriangles++;
+            NewSection.MinVertexIndex = FMath::Min3(NewSection.MinVertexIndex, A, FMath::Min(B, C));
+            NewSection.MaxVertexIndex = FMath::Max3(NewSection.MaxVertexIndex, A, FMath::Max(B, C));
+        }
+
+        // Sections which collapse completely are dropped. Their material slot stays on the mesh.
+        if (NewSection.NumTriangles > 0)
+        {
+            Out_Simplified.Sections.Add(NewSection);
+        }
+    }
+
+    if (Source.Normals.IsEmpty())
+    {
+        Out_Simplified.Normals.Reset();
+    }
+
+    if (Source.Tangents.IsEmpty())
+    {
+        Out_Simplified.Tangents.Reset();
+    }
+}
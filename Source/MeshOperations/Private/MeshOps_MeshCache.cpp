@@ -0,0 +1,418 @@
+#include "MeshOps_MeshCache.h"
+
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/StaticMesh.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "StaticMeshResources.h"
+
+#define MESH_CACHE_MAGIC 0x434D4F4D
+// Increase when file layout or the way generators fill render data changes.
+#define MESH_CACHE_VERSION 1
+#define MESH_CACHE_ALIGNMENT 16
+#define MESH_CACHE_EXTENSION TEXT(".meshcache")
+// Least recently used files are deleted when cache directory grows over this size.
+#define MESH_CACHE_MAX_SIZE (512ll * 1024 * 1024)
+
+namespace MeshOps_MeshCache_Private
+{
+    // Offsets are from the beginning of the file. Payload hash covers everything after the header.
+    struct FHeader
+    {
+        uint32 Magic = MESH_CACHE_MAGIC;
+        uint32 Version = MESH_CACHE_VERSION;
+        uint32 EngineVersion = ENGINE_MAJOR_VERSION * 100 + ENGINE_MINOR_VERSION;
+        uint32 CollisionType = 0;
+        uint64 Key = 0;
+        uint64 PayloadHash = 0;
+        uint64 FileSize = 0;
+
+        uint32 NumVertices = 0;
+        uint32 NumIndices = 0;
+        uint32 NumSections = 0;
+        uint32 NumMaterials = 0;
+        uint32 NumTexCoords = 0;
+        uint32 bUseHighPrecisionTangents = 0;
+        uint32 bUseFullPrecisionUVs = 0;
+        uint32 Padding = 0;
+
+        FVector3f BoundsMin = FVector3f::ZeroVector;
+        FVector3f BoundsMax = FVector3f::ZeroVector;
+
+        uint64 PositionsOffset = 0;
+        uint64 TangentsOffset = 0;
+        uint64 TangentsSize = 0;
+        uint64 TexCoordsOffset = 0;
+        uint64 TexCoordsSize = 0;
+        uint64 IndicesOffset = 0;
+        uint64 SectionsOffset = 0;
+    };
+
+    static_assert(sizeof(FMeshOps_MeshBuffers::FSection) == 20, "Mesh cache stores sections as they are.");
+
+    // Keeps a cache file mapped while it is copied to render buffers.
+    struct FMappedFile
+    {
+        // Region has to be released before its handle.
+        TUniquePtr<IMappedFileHandle> Handle;
+        TUniquePtr<IMappedFileRegion> Region;
+
+        const uint8* Data = nullptr;
+        int64 Size = 0;
+
+        bool Open(const FString& Path)
+        {
+            FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+
+            if (!Result.HasValue())
+            {
+                return false;
+            }
+
+            this->Handle = Result.StealValue();
+            this->Region.Reset(this->Handle->MapRegion(0, this->Handle->GetFileSize()));
+
+            if (!this->Region.IsValid())
+            {
+                return false;
+            }
+
+            this->Data = this->Region->GetMappedPtr();
+            this->Size = this->Region->GetMappedSize();
+            return true;
+        }
+    };
+
+    static uint64 Align(uint64 Offset)
+    {
+        return (Offset + MESH_CACHE_ALIGNMENT - 1) & ~(uint64)(MESH_CACHE_ALIGNMENT - 1);
+    }
+
+    static FString GetCachePath(uint64 Key)
+    {
+        return FPaths::Combine(FMeshOps_MeshCache::GetCacheDirectory(), FString::Printf(TEXT("%016llx"), Key) + MESH_CACHE_EXTENSION);
+    }
+
+    static bool IsInside(const FHeader& Header, uint64 Offset, uint64 Size)
+    {
+        return Offset >= sizeof(FHeader) && Offset % MESH_CACHE_ALIGNMENT == 0 && Offset + Size <= Header.FileSize;
+    }
+
+    static bool IsValidHeader(const FHeader& Header, uint64 Key, int64 FileSize)
+    {
+        const FHeader Current;
+
+        if (Header.Magic != Current.Magic || Header.Version != Current.Version || Header.EngineVersion != Current.EngineVersion || Header.Key != Key || Header.FileSize != (uint64)FileSize)
+        {
+            return false;
+        }
+
+        if (Header.NumVertices == 0 || Header.NumIndices == 0 || Header.NumIndices % 3 != 0 || Header.NumSections == 0 || Header.CollisionType > (uint32)FMeshOps_MeshBuilder::ECollisionType::ComplexAsSimple)
+        {
+            return false;
+        }
+
+        return IsInside(Header, Header.PositionsOffset, (uint64)Header.NumVertices * sizeof(FVector3f))
+            && IsInside(Header, Header.TangentsOffset, Header.TangentsSize)
+            && IsInside(Header, Header.TexCoordsOffset, Header.TexCoordsSize)
+            && IsInside(Header, Header.IndicesOffset, (uint64)Header.NumIndices * sizeof(uint32))
+            && IsInside(Header, Header.SectionsOffset, (uint64)Header.NumSections * sizeof(FMeshOps_MeshBuffers::FSection));
+    }
+
+    // File is written with a temporary name and moved at the end, so other sessions never map a half written file.
+    static bool WriteFile(const FHeader& Header, const TArray64<uint8>& Payload)
+    {
+        const FString Directory = FMeshOps_MeshCache::GetCacheDirectory();
+        IFileManager::Get().MakeDirectory(*Directory, true);
+
+        const FString TempPath = FPaths::CreateTempFilename(*Directory, TEXT("MeshCache"), TEXT(".tmp"));
+        TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+
+        if (!Writer)
+        {
+            return false;
+        }
+
+        Writer->Serialize(const_cast<FHeader*>(&Header), sizeof(FHeader));
+        Writer->Serialize(const_cast<uint8*>(Payload.GetData()), Payload.Num());
+
+        const bool bIsWritten = Writer->Close() && !Writer->IsError();
+        Writer.Reset();
+
+        if (!bIsWritten || !IFileManager::Get().Move(*GetCachePath(Header.Key), *TempPath, true, true))
+        {
+            IFileManager::Get().Delete(*TempPath);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Deletes least recently used files until cache fits to its size limit. Load touches files, so modification time is the last use.
+    static void TrimCache()
+    {
+        static FCriticalSection TrimSection;
+        FScopeLock Lock(&TrimSection);
+
+        TArray<TPair<FDateTime, FString>> Files;
+        int64 TotalSize = 0;
+
+        IFileManager::Get().IterateDirectoryStat(*FMeshOps_MeshCache::GetCacheDirectory(), [&Files, &TotalSize](const TCHAR* Path, const FFileStatData& StatData)
+            {
+                if (!StatData.bIsDirectory && FStringView(Path).EndsWith(MESH_CACHE_EXTENSION))
+                {
+                    Files.Add(TPair<FDateTime, FString>(StatData.ModificationTime, Path));
+                    TotalSize += StatData.FileSize;
+                }
+
+                return true;
+            });
+
+        if (TotalSize <= MESH_CACHE_MAX_SIZE)
+        {
+            return;
+        }
+
+        Files.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) { return A.Key < B.Key; });
+
+        for (const TPair<FDateTime, FString>& Each_File : Files)
+        {
+            if (TotalSize <= MESH_CACHE_MAX_SIZE)
+            {
+                break;
+            }
+
+            const int64 FileSize = IFileManager::Get().FileSize(*Each_File.Value);
+
+            if (FileSize >= 0 && IFileManager::Get().Delete(*Each_File.Value, false, false, true))
+            {
+                TotalSize -= FileSize;
+            }
+        }
+    }
+
+    // Render buffers are allocated with the precision stored in the file. Their sizes have to match the streams, otherwise file was written by a different buffer layout.
+    static bool FillLODResources(const uint8* Data, const FHeader& Header, FStaticMeshLODResources& LOD_Resource)
+    {
+        FPositionVertexBuffer& Positions = LOD_Resource.VertexBuffers.PositionVertexBuffer;
+        FStaticMeshVertexBuffer& VertexBuffer = LOD_Resource.VertexBuffers.StaticMeshVertexBuffer;
+
+        VertexBuffer.SetUseHighPrecisionTangentBasis(Header.bUseHighPrecisionTangents != 0);
+        VertexBuffer.SetUseFullPrecisionUVs(Header.bUseFullPrecisionUVs != 0);
+        VertexBuffer.Init(Header.NumVertices, Header.NumTexCoords);
+        Positions.Init(Header.NumVertices);
+
+        if (VertexBuffer.GetTangentSize() != Header.TangentsSize || VertexBuffer.GetTexCoordSize() != Header.TexCoordsSize)
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(Positions.GetVertexData(), Data + Header.PositionsOffset, (SIZE_T)Header.NumVertices * sizeof(FVector3f));
+        FMemory::Memcpy(VertexBuffer.GetTangentData(), Data + Header.TangentsOffset, Header.TangentsSize);
+
+        if (Header.TexCoordsSize > 0)
+        {
+            FMemory::Memcpy(VertexBuffer.GetTexCoordData(), Data + Header.TexCoordsOffset, Header.TexCoordsSize);
+        }
+
+        LOD_Resource.VertexBuffers.ColorVertexBuffer.InitFromSingleColor(FColor::White, Header.NumVertices);
+
+        // Indices are stored with 32 bits. Buffer stride is chosen by vertex count like mesh builder does.
+        LOD_Resource.IndexBuffer.SetIndices(TArray<uint32>(), Header.NumVertices > MAX_uint16 ? EIndexBufferStride::Force32Bit : EIndexBufferStride::Force16Bit);
+        LOD_Resource.IndexBuffer.AppendIndices((const uint32*)(Data + Header.IndicesOffset), Header.NumIndices);
+
+        const FMeshOps_MeshBuffers::FSection* Sections = (const FMeshOps_MeshBuffers::FSection*)(Data + Header.SectionsOffset);
+        LOD_Resource.Sections.Empty(Header.NumSections);
+
+        for (uint32 SectionIndex = 0; SectionIndex < Header.NumSections; SectionIndex++)
+        {
+            const FMeshOps_MeshBuffers::FSection& Each_Section = Sections[SectionIndex];
+
+            if (Each_Section.MaterialIndex < 0 || (uint32)Each_Section.MaterialIndex >= Header.NumMaterials || (uint64)Each_Section.FirstIndex + Each_Section.NumTriangles * 3 > Header.NumIndices)
+            {
+                return false;
+            }
+
+            FStaticMeshSection& NewSection = LOD_Resource.Sections.AddDefaulted_GetRef();
+            NewSection.MaterialIndex = Each_Section.MaterialIndex;
+            NewSection.FirstIndex = Each_Section.FirstIndex;
+            NewSection.NumTriangles = Each_Section.NumTriangles;
+            NewSection.MinVertexIndex = Each_Section.MinVertexIndex;
+            NewSection.MaxVertexIndex = Each_Section.MaxVertexIndex;
+        }
+
+        return true;
+    }
+}
+
+uint64 FMeshOps_MeshCache::MakeKey(const TCHAR* Generator, std::initializer_list<TArrayView<const uint8>> Inputs)
+{
+    FXxHash64Builder Builder;
+    Builder.Update(Generator, FCString::Strlen(Generator) * sizeof(TCHAR));
+
+    for (const TArrayView<const uint8>& Each_Input : Inputs)
+    {
+        // Sizes separate inputs, so moving bytes from one input to the next one changes the key.
+        const int64 Size = Each_Input.Num();
+        Builder.Update(&Size, sizeof(Size));
+        Builder.Update(Each_Input.GetData(), Size);
+    }
+
+    return Builder.Finalize().Hash;
+}
+
+FString FMeshOps_MeshCache::GetCacheDirectory()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MeshOperations"), TEXT("MeshCache"));
+}
+
+UStaticMesh* FMeshOps_MeshCache::Load(FName Mesh_Name, uint64 Key, bool bSupportRayTracing)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_MeshCache_Private;
+
+    const FString Path = GetCachePath(Key);
+    FMappedFile File;
+
+    if (!FPaths::FileExists(Path) || !File.Open(Path) || File.Size < (int64)sizeof(FHeader))
+    {
+        return nullptr;
+    }
+
+    FHeader Header;
+    FMemory::Memcpy(&Header, File.Data, sizeof(FHeader));
+
+    if (!IsValidHeader(Header, Key, File.Size) || FXxHash64::HashBuffer(File.Data + sizeof(FHeader), File.Size - sizeof(FHeader)).Hash != Header.PayloadHash)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Mesh cache file %s is outdated or corrupted. Mesh will be rebuilt."), *Path);
+        return nullptr;
+    }
+
+    UStaticMesh* StaticMesh = FMeshOps_MeshBuilder::CreateStaticMesh(Mesh_Name, 1, Header.NumMaterials, TArrayView<UMaterialInterface* const>(), bSupportRayTracing);
+
+    if (!StaticMesh)
+    {
+        return nullptr;
+    }
+
+    if (!FillLODResources(File.Data, Header, StaticMesh->GetRenderData()->LODResources[0]))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Mesh cache file %s doesn't match render buffer layout. Mesh will be rebuilt."), *Path);
+
+        StaticMesh->ClearFlags(RF_Public | RF_Standalone);
+        StaticMesh->MarkAsGarbage();
+        return nullptr;
+    }
+
+    StaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
+
+    // Trimming deletes least recently used files first.
+    IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+
+    const TArrayView<const FVector3f> Positions((const FVector3f*)(File.Data + Header.PositionsOffset), Header.NumVertices);
+    FMeshOps_MeshBuilder::FinalizeStaticMesh(StaticMesh, FBox(FBox3f(Header.BoundsMin, Header.BoundsMax)), (FMeshOps_MeshBuilder::ECollisionType)Header.CollisionType, Positions);
+
+    return StaticMesh;
+}
+
+bool FMeshOps_MeshCache::Save(const UStaticMesh* StaticMesh, uint64 Key, FMeshOps_MeshBuilder::ECollisionType CollisionType)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_MeshCache_Private;
+
+    const FStaticMeshRenderData* RenderData = ::IsValid(StaticMesh) ? StaticMesh->GetRenderData() : nullptr;
+
+    if (!RenderData || RenderData->LODResources.IsEmpty())
+    {
+        return false;
+    }
+
+    const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+    const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+    const FStaticMeshVertexBuffer& VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+
+    if (Positions.GetNumVertices() == 0 || !Positions.GetVertexData() || !VertexBuffer.GetTangentData() || (VertexBuffer.GetTexCoordSize() > 0 && !VertexBuffer.GetTexCoordData()))
+    {
+        return false;
+    }
+
+    TArray<uint32> Indices;
+    LOD.IndexBuffer.GetCopy(Indices);
+
+    TArray<FMeshOps_MeshBuffers::FSection> Sections;
+
+    for (const FStaticMeshSection& Each_Section : LOD.Sections)
+    {
+        FMeshOps_MeshBuffers::FSection& NewSection = Sections.AddZeroed_GetRef();
+        NewSection.MaterialIndex = Each_Section.MaterialIndex;
+        NewSection.FirstIndex = Each_Section.FirstIndex;
+        NewSection.NumTriangles = Each_Section.NumTriangles;
+        NewSection.MinVertexIndex = Each_Section.MinVertexIndex;
+        NewSection.MaxVertexIndex = Each_Section.MaxVertexIndex;
+    }
+
+    const FBox Bounds = RenderData->Bounds.GetBox();
+
+    FHeader Header;
+    Header.CollisionType = (uint32)CollisionType;
+    Header.Key = Key;
+    Header.NumVertices = Positions.GetNumVertices();
+    Header.NumIndices = Indices.Num();
+    Header.NumSections = Sections.Num();
+    Header.NumMaterials = FMath::Max(StaticMesh->GetStaticMaterials().Num(), 1);
+    Header.NumTexCoords = VertexBuffer.GetNumTexCoords();
+    Header.bUseHighPrecisionTangents = VertexBuffer.GetUseHighPrecisionTangentBasis();
+    Header.bUseFullPrecisionUVs = VertexBuffer.GetUseFullPrecisionUVs();
+    Header.BoundsMin = (FVector3f)Bounds.Min;
+    Header.BoundsMax = (FVector3f)Bounds.Max;
+
+    Header.PositionsOffset = Align(sizeof(FHeader));
+    Header.TangentsOffset = Align(Header.PositionsOffset + (uint64)Header.NumVertices * sizeof(FVector3f));
+    Header.TangentsSize = VertexBuffer.GetTangentSize();
+    Header.TexCoordsOffset = Align(Header.TangentsOffset + Header.TangentsSize);
+    Header.TexCoordsSize = VertexBuffer.GetTexCoordSize();
+    Header.IndicesOffset = Align(Header.TexCoordsOffset + Header.TexCoordsSize);
+    Header.SectionsOffset = Align(Header.IndicesOffset + (uint64)Header.NumIndices * sizeof(uint32));
+    Header.FileSize = Header.SectionsOffset + (uint64)Header.NumSections * sizeof(FMeshOps_MeshBuffers::FSection);
+
+    // Payload is built in memory first, because its hash is stored in the header.
+    TArray64<uint8> Payload;
+    Payload.SetNumZeroed(Header.FileSize - sizeof(FHeader));
+
+    auto CopyStream = [&Payload](uint64 Offset, const void* Data, uint64 Size)
+        {
+            if (Size > 0)
+            {
+                FMemory::Memcpy(Payload.GetData() + Offset - sizeof(FHeader), Data, Size);
+            }
+        };
+
+    CopyStream(Header.PositionsOffset, Positions.GetVertexData(), (uint64)Header.NumVertices * sizeof(FVector3f));
+    CopyStream(Header.TangentsOffset, VertexBuffer.GetTangentData(), Header.TangentsSize);
+    CopyStream(Header.TexCoordsOffset, VertexBuffer.GetTexCoordData(), Header.TexCoordsSize);
+    CopyStream(Header.IndicesOffset, Indices.GetData(), (uint64)Header.NumIndices * sizeof(uint32));
+    CopyStream(Header.SectionsOffset, Sections.GetData(), (uint64)Header.NumSections * sizeof(FMeshOps_MeshBuffers::FSection));
+
+    // Hashing and writing don't touch the mesh, so they run on a worker thread.
+    Async(EAsyncExecution::ThreadPool, [Header, Payload = MoveTemp(Payload)]() mutable
+        {
+            Header.PayloadHash = FXxHash64::HashBuffer(Payload.GetData(), Payload.Num()).Hash;
+
+            if (WriteFile(Header, Payload))
+            {
+                TrimCache();
+            }
+        });
+
+    return true;
+}
+
+void FMeshOps_MeshCache::Reset()
+{
+    IFileManager::Get().DeleteDirectory(*GetCacheDirectory(), false, true);
+}
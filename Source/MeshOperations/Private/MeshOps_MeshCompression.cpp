@@ -0,0 +1,729 @@
+#include "MeshOps_MeshCompression.h"
+
+#define MESHOPT_VERTEX_HEADER 0xA0
+#define MESHOPT_INDEX_HEADER 0xE1
+
+#define MESHOPT_VERTEX_BLOCK_BYTES 8192
+#define MESHOPT_VERTEX_BLOCK_MAX_SIZE 256
+#define MESHOPT_BYTE_GROUP_SIZE 16
+#define MESHOPT_BYTE_GROUP_DECODE_LIMIT 24
+#define MESHOPT_TAIL_MAX_SIZE 32
+
+namespace MeshOps_MeshCompression_Private
+{
+    // --- VERTEX CODEC ---
+
+    static int32 GetVertexBlockSize(int32 VertexSize)
+    {
+        // Each block is encoded as whole byte groups.
+        const int32 BlockSize = (MESHOPT_VERTEX_BLOCK_BYTES / VertexSize) & ~(MESHOPT_BYTE_GROUP_SIZE - 1);
+        return FMath::Min(BlockSize, MESHOPT_VERTEX_BLOCK_MAX_SIZE);
+    }
+
+    static int64 GetVertexBufferBound(int32 NumVertices, int32 VertexSize)
+    {
+        const int32 BlockSize = GetVertexBlockSize(VertexSize);
+        const int64 NumBlocks = (NumVertices + BlockSize - 1) / BlockSize;
+        const int64 BlockHeaderSize = (BlockSize / MESHOPT_BYTE_GROUP_SIZE + 3) / 4;
+
+        return 1 + NumBlocks * VertexSize * (BlockHeaderSize + BlockSize) + FMath::Max(VertexSize, MESHOPT_TAIL_MAX_SIZE);
+    }
+
+    static uint8 ZigZag8(uint8 Value)
+    {
+        return (uint8)(((int8)Value >> 7) ^ (Value << 1));
+    }
+
+    // Returns encoded size of a byte group, or MAX_int64 if it can't be encoded with given bit count.
+    static int64 MeasureByteGroup(const uint8* Group, int32 Bits)
+    {
+        if (Bits == 1)
+        {
+            for (int32 Index = 0; Index < MESHOPT_BYTE_GROUP_SIZE; Index++)
+            {
+                if (Group[Index])
+                {
+                    return MAX_int64;
+                }
+            }
+
+            return 0;
+        }
+
+        if (Bits == 8)
+        {
+            return MESHOPT_BYTE_GROUP_SIZE;
+        }
+
+        // Values which don't fit are marked with all ones and stored as full bytes after the packed part.
+        const uint8 Sentinel = (uint8)((1 << Bits) - 1);
+        int64 Size = MESHOPT_BYTE_GROUP_SIZE * Bits / 8;
+
+        for (int32 Index = 0; Index < MESHOPT_BYTE_GROUP_SIZE; Index++)
+        {
+            Size += Group[Index] >= Sentinel;
+        }
+
+        return Size;
+    }
+
+    static uint8* EncodeByteGroup(uint8* Data, const uint8* Group, int32 Bits)
+    {
+        if (Bits == 1)
+        {
+            return Data;
+        }
+
+        if (Bits == 8)
+        {
+            FMemory::Memcpy(Data, Group, MESHOPT_BYTE_GROUP_SIZE);
+            return Data + MESHOPT_BYTE_GROUP_SIZE;
+        }
+
+        const int32 ValuesPerByte = 8 / Bits;
+        const uint8 Sentinel = (uint8)((1 << Bits) - 1);
+
+        for (int32 Index = 0; Index < MESHOPT_BYTE_GROUP_SIZE; Index += ValuesPerByte)
+        {
+            uint8 Byte = 0;
+
+            for (int32 Offset = 0; Offset < ValuesPerByte; Offset++)
+            {
+                Byte = (uint8)(Byte << Bits);
+                Byte |= Group[Index + Offset] >= Sentinel ? Sentinel : Group[Index + Offset];
+            }
+
+            *Data++ = Byte;
+        }
+
+        for (int32 Index = 0; Index < MESHOPT_BYTE_GROUP_SIZE; Index++)
+        {
+            if (Group[Index] >= Sentinel)
+            {
+                *Data++ = Group[Index];
+            }
+        }
+
+        return Data;
+    }
+
+    static uint8* EncodeBytes(uint8* Data, const uint8* DataEnd, const uint8* Bytes, int32 NumBytes)
+    {
+        // Two bits of header for each group select 0, 2, 4 or 8 bits per value.
+        const int32 HeaderSize = (NumBytes / MESHOPT_BYTE_GROUP_SIZE + 3) / 4;
+
+        if (DataEnd - Data < HeaderSize)
+        {
+            return nullptr;
+        }
+
+        uint8* Header = Data;
+        FMemory::Memzero(Header, HeaderSize);
+        Data += HeaderSize;
+
+        for (int32 GroupStart = 0; GroupStart < NumBytes; GroupStart += MESHOPT_BYTE_GROUP_SIZE)
+        {
+            if (DataEnd - Data < MESHOPT_BYTE_GROUP_DECODE_LIMIT)
+            {
+                return nullptr;
+            }
+
+            int32 BestBits = 8;
+            int64 BestSize = MeasureByteGroup(Bytes + GroupStart, 8);
+
+            for (int32 Bits = 1; Bits < 8; Bits *= 2)
+            {
+                const int64 Size = MeasureByteGroup(Bytes + GroupStart, Bits);
+
+                if (Size < BestSize)
+                {
+                    BestBits = Bits;
+                    BestSize = Size;
+                }
+            }
+
+            const int32 BitsLog2 = BestBits == 1 ? 0 : BestBits == 2 ? 1 : BestBits == 4 ? 2 : 3;
+            const int32 GroupIndex = GroupStart / MESHOPT_BYTE_GROUP_SIZE;
+            Header[GroupIndex / 4] |= BitsLog2 << ((GroupIndex % 4) * 2);
+
+            Data = EncodeByteGroup(Data, Bytes + GroupStart, BestBits);
+        }
+
+        return Data;
+    }
+
+    static uint8* EncodeVertexBlock(uint8* Data, const uint8* DataEnd, const uint8* Vertices, int32 NumVertices, int32 VertexSize, uint8* LastVertex)
+    {
+        // Byte k of every vertex is delta encoded against the previous vertex and stored together, so similar bytes end up in the same groups.
+        uint8 Bytes[MESHOPT_VERTEX_BLOCK_MAX_SIZE] = { 0 };
+        const int32 NumBytes = (NumVertices + MESHOPT_BYTE_GROUP_SIZE - 1) & ~(MESHOPT_BYTE_GROUP_SIZE - 1);
+
+        for (int32 ByteIndex = 0; ByteIndex < VertexSize; ByteIndex++)
+        {
+            uint8 Previous = LastVertex[ByteIndex];
+
+            for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+            {
+                const uint8 Current = Vertices[VertexIndex * VertexSize + ByteIndex];
+                Bytes[VertexIndex] = ZigZag8((uint8)(Current - Previous));
+                Previous = Current;
+            }
+
+            Data = EncodeBytes(Data, DataEnd, Bytes, NumBytes);
+
+            if (!Data)
+            {
+                return nullptr;
+            }
+        }
+
+        FMemory::Memcpy(LastVertex, Vertices + (NumVertices - 1) * VertexSize, VertexSize);
+        return Data;
+    }
+
+    // --- INDEX CODEC ---
+
+    static const uint8 CodeAuxTable[16] =
+    {
+        0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xA9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69,
+        0, 0,
+    };
+
+    static const int32 TriangleOrder[3][3] =
+    {
+        { 0, 1, 2 },
+        { 1, 2, 0 },
+        { 2, 0, 1 },
+    };
+
+    struct FIndexFifos
+    {
+        uint32 Edges[16][2];
+        uint32 Vertices[16];
+        int32 EdgeOffset = 0;
+        int32 VertexOffset = 0;
+
+        FIndexFifos()
+        {
+            FMemory::Memset(this->Edges, 0xFF, sizeof(this->Edges));
+            FMemory::Memset(this->Vertices, 0xFF, sizeof(this->Vertices));
+        }
+
+        // Returns (fifo index << 2) | rotation of the triangle whose first edge matches, or -1.
+        int32 FindEdge(uint32 A, uint32 B, uint32 C) const
+        {
+            for (int32 Index = 0; Index < 16; Index++)
+            {
+                const int32 Slot = (this->EdgeOffset - 1 - Index) & 15;
+                const uint32 E0 = this->Edges[Slot][0];
+                const uint32 E1 = this->Edges[Slot][1];
+
+                if (E0 == A && E1 == B)
+                {
+                    return (Index << 2) | 0;
+                }
+
+                if (E0 == B && E1 == C)
+                {
+                    return (Index << 2) | 1;
+                }
+
+                if (E0 == C && E1 == A)
+                {
+                    return (Index << 2) | 2;
+                }
+            }
+
+            return -1;
+        }
+
+        void PushEdge(uint32 A, uint32 B)
+        {
+            this->Edges[this->EdgeOffset][0] = A;
+            this->Edges[this->EdgeOffset][1] = B;
+            this->EdgeOffset = (this->EdgeOffset + 1) & 15;
+        }
+
+        int32 FindVertex(uint32 Vertex) const
+        {
+            for (int32 Index = 0; Index < 16; Index++)
+            {
+                if (this->Vertices[(this->VertexOffset - 1 - Index) & 15] == Vertex)
+                {
+                    return Index;
+                }
+            }
+
+            return -1;
+        }
+
+        void PushVertex(uint32 Vertex)
+        {
+            this->Vertices[this->VertexOffset] = Vertex;
+            this->VertexOffset = (this->VertexOffset + 1) & 15;
+        }
+    };
+
+    static void EncodeVByte(uint8*& Data, uint32 Value)
+    {
+        do
+        {
+            *Data++ = (uint8)((Value & 127) | (Value > 127 ? 128 : 0));
+            Value >>= 7;
+        } while (Value);
+    }
+
+    // Free indices are zigzag encoded deltas from the last free index.
+    static void EncodeIndex(uint8*& Data, uint32 Index, uint32 Last)
+    {
+        const uint32 Delta = Index - Last;
+        EncodeVByte(Data, (Delta << 1) ^ (uint32)((int32)Delta >> 31));
+    }
+
+    static int32 FindCodeAux(uint8 Value)
+    {
+        for (int32 Index = 0; Index < 16; Index++)
+        {
+            if (CodeAuxTable[Index] == Value)
+            {
+                return Index;
+            }
+        }
+
+        return -1;
+    }
+
+    // --- TIPSIFY ---
+
+    static int32 SkipDeadEnd(const TArray<int32>& LiveTriangles, TArray<uint32>& DeadEnds, int32& Cursor)
+    {
+        while (!DeadEnds.IsEmpty())
+        {
+            const uint32 Vertex = DeadEnds.Pop();
+
+            if (LiveTriangles[Vertex] > 0)
+            {
+                return Vertex;
+            }
+        }
+
+        while (Cursor < LiveTriangles.Num())
+        {
+            if (LiveTriangles[Cursor] > 0)
+            {
+                return Cursor;
+            }
+
+            Cursor++;
+        }
+
+        return INDEX_NONE;
+    }
+}
+
+void FMeshOps_MeshCompression::OptimizeVertexCache(TArrayView<uint32> Indices, int32 NumVertices, int32 CacheSize)
+{
+    using namespace MeshOps_MeshCompression_Private;
+
+    const int32 NumTriangles = Indices.Num() / 3;
+
+    if (NumTriangles < 2 || NumVertices <= 0)
+    {
+        return;
+    }
+
+    // Triangles of each vertex in a flat adjacency array.
+    TArray<int32> LiveTriangles;
+    LiveTriangles.Init(0, NumVertices);
+
+    for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+    {
+        LiveTriangles[Indices[Index]]++;
+    }
+
+    TArray<int32> Offsets;
+    Offsets.SetNumUninitialized(NumVertices + 1);
+    Offsets[0] = 0;
+
+    for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+    {
+        Offsets[VertexIndex + 1] = Offsets[VertexIndex] + LiveTriangles[VertexIndex];
+    }
+
+    TArray<int32> Adjacency;
+    Adjacency.SetNumUninitialized(NumTriangles * 3);
+    TArray<int32> Fill = Offsets;
+
+    for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+    {
+        Adjacency[Fill[Indices[Index]]++] = Index / 3;
+    }
+
+    TArray<int32> CacheTime;
+    CacheTime.Init(0, NumVertices);
+
+    TBitArray<> Emitted(false, NumTriangles);
+    TArray<uint32> DeadEnds;
+    TArray<uint32> Candidates;
+    TArray<uint32> Output;
+    Output.Reserve(NumTriangles * 3);
+
+    int32 Time = CacheSize + 1;
+    int32 Cursor = 0;
+    int32 Fanning = Indices[0];
+
+    while (Fanning != INDEX_NONE)
+    {
+        Candidates.Reset();
+
+        for (int32 Slot = Offsets[Fanning]; Slot < Offsets[Fanning + 1]; Slot++)
+        {
+            const int32 Triangle = Adjacency[Slot];
+
+            if (Emitted[Triangle])
+            {
+                continue;
+            }
+
+            for (int32 Corner = 0; Corner < 3; Corner++)
+            {
+                const uint32 Vertex = Indices[Triangle * 3 + Corner];
+
+                Output.Add(Vertex);
+                DeadEnds.Add(Vertex);
+                Candidates.Add(Vertex);
+                LiveTriangles[Vertex]--;
+
+                if (Time - CacheTime[Vertex] > CacheSize)
+                {
+                    CacheTime[Vertex] = Time++;
+                }
+            }
+
+            Emitted[Triangle] = true;
+        }
+
+        // Next fanning vertex is the one which stays longest in cache after its remaining triangles are emitted.
+        int32 BestVertex = INDEX_NONE;
+        int32 BestPriority = -1;
+
+        for (const uint32 Each_Candidate : Candidates)
+        {
+            if (LiveTriangles[Each_Candidate] <= 0)
+            {
+                continue;
+            }
+
+            int32 Priority = 0;
+
+            if (Time - CacheTime[Each_Candidate] + 2 * LiveTriangles[Each_Candidate] <= CacheSize)
+            {
+                Priority = Time - CacheTime[Each_Candidate];
+            }
+
+            if (Priority > BestPriority)
+            {
+                BestPriority = Priority;
+                BestVertex = Each_Candidate;
+            }
+        }
+
+        Fanning = BestVertex != INDEX_NONE ? BestVertex : SkipDeadEnd(LiveTriangles, DeadEnds, Cursor);
+    }
+
+    FMemory::Memcpy(Indices.GetData(), Output.GetData(), Output.Num() * sizeof(uint32));
+}
+
+void FMeshOps_MeshCompression::OptimizeVertexFetch(TArrayView<uint32> Indices, int32 NumVertices, TArray<int32>& Out_NewToOld)
+{
+    TArray<int32> OldToNew;
+    OldToNew.Init(INDEX_NONE, NumVertices);
+    Out_NewToOld.Reset();
+
+    for (uint32& Each_Index : Indices)
+    {
+        int32& NewIndex = OldToNew[Each_Index];
+
+        if (NewIndex == INDEX_NONE)
+        {
+            NewIndex = Out_NewToOld.Add(Each_Index);
+        }
+
+        Each_Index = NewIndex;
+    }
+}
+
+bool FMeshOps_MeshCompression::EncodeVertexBuffer(const void* Vertices, int32 NumVertices, int32 VertexSize, TArray<uint8>& Out_Encoded)
+{
+    using namespace MeshOps_MeshCompression_Private;
+
+    if (VertexSize <= 0 || VertexSize > 256 || VertexSize % 4 != 0)
+    {
+        return false;
+    }
+
+    Out_Encoded.SetNumUninitialized(GetVertexBufferBound(NumVertices, VertexSize));
+
+    const uint8* VertexData = static_cast<const uint8*>(Vertices);
+    uint8* Data = Out_Encoded.GetData();
+    const uint8* DataEnd = Data + Out_Encoded.Num();
+
+    *Data++ = MESHOPT_VERTEX_HEADER;
+
+    uint8 FirstVertex[256] = { 0 };
+    uint8 LastVertex[256] = { 0 };
+
+    if (NumVertices > 0)
+    {
+        FMemory::Memcpy(FirstVertex, VertexData, VertexSize);
+        FMemory::Memcpy(LastVertex, VertexData, VertexSize);
+    }
+
+    const int32 BlockSize = GetVertexBlockSize(VertexSize);
+
+    for (int32 VertexOffset = 0; VertexOffset < NumVertices; VertexOffset += BlockSize)
+    {
+        Data = EncodeVertexBlock(Data, DataEnd, VertexData + (int64)VertexOffset * VertexSize, FMath::Min(BlockSize, NumVertices - VertexOffset), VertexSize, LastVertex);
+
+        if (!Data)
+        {
+            return false;
+        }
+    }
+
+    // First vertex is stored at the end and padded to 32 bytes, so decoder bounds checks stay simple.
+    const int32 TailSize = FMath::Max(VertexSize, MESHOPT_TAIL_MAX_SIZE);
+
+    if (DataEnd - Data < TailSize)
+    {
+        return false;
+    }
+
+    FMemory::Memzero(Data, TailSize - VertexSize);
+    Data += TailSize - VertexSize;
+    FMemory::Memcpy(Data, FirstVertex, VertexSize);
+    Data += VertexSize;
+
+    Out_Encoded.SetNum(Data - Out_Encoded.GetData());
+    return true;
+}
+
+bool FMeshOps_MeshCompression::EncodeIndexBuffer(TArrayView<const uint32> Indices, int32 NumVertices, TArray<uint8>& Out_Encoded)
+{
+    using namespace MeshOps_MeshCompression_Private;
+
+    if (Indices.Num() % 3 != 0)
+    {
+        return false;
+    }
+
+    // Worst case is a code byte, an aux byte and three 5 byte varints for each triangle. Aux table is also padding for the decoder.
+    int32 VertexBits = 1;
+
+    while (VertexBits < 32 && NumVertices > (int64)1 << VertexBits)
+    {
+        VertexBits++;
+    }
+
+    const int64 VertexGroups = (VertexBits + 1 + 6) / 7;
+    Out_Encoded.SetNumUninitialized(1 + (Indices.Num() / 3) * (2 + 3 * VertexGroups) + 16);
+
+    uint8* Buffer = Out_Encoded.GetData();
+    uint8* Code = Buffer + 1;
+    uint8* Data = Code + Indices.Num() / 3;
+    const uint8* DataSafeEnd = Buffer + Out_Encoded.Num() - 16;
+
+    Buffer[0] = MESHOPT_INDEX_HEADER;
+
+    FIndexFifos Fifos;
+    uint32 Next = 0;
+    uint32 Last = 0;
+
+    // Version 1 reserves 13 and 14 for last - 1 and last + 1.
+    const int32 FecMax = 13;
+
+    for (int32 First = 0; First < Indices.Num(); First += 3)
+    {
+        if (Data > DataSafeEnd)
+        {
+            return false;
+        }
+
+        const int32 Fer = Fifos.FindEdge(Indices[First], Indices[First + 1], Indices[First + 2]);
+
+        if (Fer >= 0 && (Fer >> 2) < 15)
+        {
+            // Triangle shares an edge with a recent one. Only the third vertex is encoded.
+            const int32* Order = TriangleOrder[Fer & 3];
+            const uint32 A = Indices[First + Order[0]];
+            const uint32 B = Indices[First + Order[1]];
+            const uint32 C = Indices[First + Order[2]];
+
+            const int32 Fe = Fer >> 2;
+            const int32 Fc = Fifos.FindVertex(C);
+
+            int32 Fec = 15;
+
+            if (Fc >= 1 && Fc < FecMax)
+            {
+                Fec = Fc;
+            }
+
+            else if (C == Next)
+            {
+                Fec = 0;
+                Next++;
+            }
+
+            if (Fec == 15)
+            {
+                if (C + 1 == Last)
+                {
+                    Fec = 13;
+                    Last = C;
+                }
+
+                if (C == Last + 1)
+                {
+                    Fec = 14;
+                    Last = C;
+                }
+            }
+
+            *Code++ = (uint8)((Fe << 4) | Fec);
+
+            if (Fec == 15)
+            {
+                EncodeIndex(Data, C, Last);
+                Last = C;
+            }
+
+            if (Fec == 0 || Fec >= FecMax)
+            {
+                Fifos.PushVertex(C);
+            }
+
+            Fifos.PushEdge(C, B);
+            Fifos.PushEdge(A, C);
+        }
+
+        else
+        {
+            // Rotate so the next new vertex comes first.
+            const int32 Rotation = Indices[First + 1] == Next ? 1 : Indices[First + 2] == Next ? 2 : 0;
+            const int32* Order = TriangleOrder[Rotation];
+            const uint32 A = Indices[First + Order[0]];
+            const uint32 B = Indices[First + Order[1]];
+            const uint32 C = Indices[First + Order[2]];
+
+            bool bIsReset = false;
+
+            if (A == 0 && B == 1 && C == 2 && Next > 0)
+            {
+                bIsReset = true;
+                Next = 0;
+                FMemory::Memset(Fifos.Vertices, 0xFF, sizeof(Fifos.Vertices));
+            }
+
+            const int32 Fb = Fifos.FindVertex(B);
+            const int32 Fc = Fifos.FindVertex(C);
+
+            // Next has to be advanced after each vertex, so this order matters.
+            int32 Fea = 15;
+
+            if (A == Next)
+            {
+                Fea = 0;
+                Next++;
+            }
+
+            int32 Feb = 15;
+
+            if (Fb >= 0 && Fb < 14)
+            {
+                Feb = Fb + 1;
+            }
+
+            else if (B == Next)
+            {
+                Feb = 0;
+                Next++;
+            }
+
+            int32 Fec = 15;
+
+            if (Fc >= 0 && Fc < 14)
+            {
+                Fec = Fc + 1;
+            }
+
+            else if (C == Next)
+            {
+                Fec = 0;
+                Next++;
+            }
+
+            const uint8 CodeAux = (uint8)((Feb << 4) | Fec);
+            const int32 CodeAuxIndex = FindCodeAux(CodeAux);
+
+            if (Fea == 0 && CodeAuxIndex >= 0 && CodeAuxIndex < 14 && !bIsReset)
+            {
+                *Code++ = (uint8)((15 << 4) | CodeAuxIndex);
+            }
+
+            else
+            {
+                *Code++ = (uint8)((15 << 4) | 14 | Fea);
+                *Data++ = CodeAux;
+            }
+
+            if (Fea == 15)
+            {
+                EncodeIndex(Data, A, Last);
+                Last = A;
+            }
+
+            if (Feb == 15)
+            {
+                EncodeIndex(Data, B, Last);
+                Last = B;
+            }
+
+            if (Fec == 15)
+            {
+                EncodeIndex(Data, C, Last);
+                Last = C;
+            }
+
+            if (Fea == 0 || Fea == 15)
+            {
+                Fifos.PushVertex(A);
+            }
+
+            if (Feb == 0 || Feb == 15)
+            {
+                Fifos.PushVertex(B);
+            }
+
+            if (Fec == 0 || Fec == 15)
+            {
+                Fifos.PushVertex(C);
+            }
+
+            Fifos.PushEdge(B, A);
+            Fifos.PushEdge(C, B);
+            Fifos.PushEdge(A, C);
+        }
+    }
+
+    if (Data > DataSafeEnd)
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(Data, CodeAuxTable, 16);
+    Data += 16;
+
+    Out_Encoded.SetNum(Data - Buffer);
+    return true;
+}
@@ -0,0 +1,323 @@
+#include "MeshOps_MeshMerge.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+#include "MeshOps_MeshBuilder.h"
+
+namespace MeshOps_MeshMerge_Private
+{
+    struct FPart
+    {
+        int32 MeshIndex = INDEX_NONE;
+        int32 ComponentIndex = INDEX_NONE;
+        FMatrix44d Matrix = FMatrix44d::Identity;
+
+        // Filled after source meshes are read.
+        int32 FirstVertex = 0;
+        int32 FirstSectionOffset = 0;
+    };
+}
+
+UStaticMesh* FMeshOps_MeshMerge::MergeSubtree(USceneComponent* AssetRoot, FName Mesh_Name, const FMeshMergeOptionsStruct& Options, TArray<UStaticMeshComponent*>& Out_Merged)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_MeshMerge_Private;
+
+    Out_Merged.Reset();
+
+    if (!IsValid(AssetRoot))
+    {
+        return nullptr;
+    }
+
+    TArray<USceneComponent*> Children;
+    AssetRoot->GetChildrenComponents(true, Children);
+    Children.Insert(AssetRoot, 0);
+
+    const FMatrix44d RootInverse = Options.bWorldSpace ? FMatrix44d::Identity : AssetRoot->GetComponentTransform().ToMatrixWithScale().Inverse();
+
+    TArray<const UStaticMesh*> UniqueMeshes;
+    TMap<const UStaticMesh*, int32> MeshIndices;
+
+    TArray<UMaterialInterface*> Materials;
+    TMap<UMaterialInterface*, int32> MaterialIndices;
+
+    // Global material index of each slot of each component.
+    TArray<TArray<int32>> ComponentMaterials;
+    TArray<FPart> Parts;
+
+    for (USceneComponent* Each_Child : Children)
+    {
+        UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Each_Child);
+
+        if (!IsValid(StaticMeshComp) || !IsValid(StaticMeshComp->GetStaticMesh()))
+        {
+            continue;
+        }
+
+        UInstancedStaticMeshComponent* InstancedComp = Cast<UInstancedStaticMeshComponent>(StaticMeshComp);
+
+        if (InstancedComp && !Options.bIncludeInstances)
+        {
+            continue;
+        }
+
+        const UStaticMesh* StaticMesh = StaticMeshComp->GetStaticMesh();
+        int32 MeshIndex = INDEX_NONE;
+
+        if (const int32* Found = MeshIndices.Find(StaticMesh))
+        {
+            MeshIndex = *Found;
+        }
+
+        else
+        {
+            MeshIndex = UniqueMeshes.Add(StaticMesh);
+            MeshIndices.Add(StaticMesh, MeshIndex);
+        }
+
+        const int32 ComponentIndex = ComponentMaterials.AddDefaulted();
+
+        for (int32 SlotIndex = 0; SlotIndex < StaticMeshComp->GetNumMaterials(); SlotIndex++)
+        {
+            UMaterialInterface* Material = StaticMeshComp->GetMaterial(SlotIndex);
+            int32* MaterialIndex = MaterialIndices.Find(Material);
+
+            ComponentMaterials[ComponentIndex].Add(MaterialIndex ? *MaterialIndex : MaterialIndices.Add(Material, Materials.Add(Material)));
+        }
+
+        if (InstancedComp)
+        {
+            for (int32 InstanceIndex = 0; InstanceIndex < InstancedComp->GetInstanceCount(); InstanceIndex++)
+            {
+                FTransform InstanceTransform;
+
+                if (InstancedComp->GetInstanceTransform(InstanceIndex, InstanceTransform, true))
+                {
+                    FPart& Part = Parts.AddDefaulted_GetRef();
+                    Part.MeshIndex = MeshIndex;
+                    Part.ComponentIndex = ComponentIndex;
+                    Part.Matrix = InstanceTransform.ToMatrixWithScale() * RootInverse;
+                }
+            }
+        }
+
+        else
+        {
+            FPart& Part = Parts.AddDefaulted_GetRef();
+            Part.MeshIndex = MeshIndex;
+            Part.ComponentIndex = ComponentIndex;
+            Part.Matrix = StaticMeshComp->GetComponentTransform().ToMatrixWithScale() * RootInverse;
+        }
+
+        Out_Merged.Add(StaticMeshComp);
+    }
+
+    if (Parts.IsEmpty())
+    {
+        Out_Merged.Reset();
+        return nullptr;
+    }
+
+    // Each unique mesh is read once.
+    TArray<FMeshOps_MeshBuffers> Sources;
+    TArray<bool> bIsRead;
+    Sources.SetNum(UniqueMeshes.Num());
+    bIsRead.SetNumZeroed(UniqueMeshes.Num());
+
+    ParallelFor(UniqueMeshes.Num(), [&UniqueMeshes, &Sources, &bIsRead](int32 MeshIndex)
+        {
+            bIsRead[MeshIndex] = FMeshOps_MeshBuilder::ReadStaticMesh(UniqueMeshes[MeshIndex], 0, Sources[MeshIndex]);
+        });
+
+    for (int32 MeshIndex = 0; MeshIndex < UniqueMeshes.Num(); MeshIndex++)
+    {
+        if (!bIsRead[MeshIndex])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Merge : %s is skipped because its CPU data isn't available. Enable Allow CPU Access on it."), *UniqueMeshes[MeshIndex]->GetName());
+        }
+    }
+
+    Parts.RemoveAll([&bIsRead](const FPart& Each_Part) { return !bIsRead[Each_Part.MeshIndex]; });
+    Out_Merged.RemoveAll([&MeshIndices, &bIsRead](const UStaticMeshComponent* Each_Component) { return !bIsRead[MeshIndices[Each_Component->GetStaticMesh()]]; });
+
+    if (Parts.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    /*
+    * Output has one section per material. Each source section writes its triangles to a precomputed offset in its material's range.
+    * Offsets are computed sequentially, because it is only a prefix sum over parts and sections.
+    */
+    const int32 NumMaterials = FMath::Max(Materials.Num(), 1);
+
+    auto GetMaterialOfSection = [&ComponentMaterials](const FPart& Part, const FMeshOps_MeshBuffers::FSection& Section)
+        {
+            const TArray<int32>& Slots = ComponentMaterials[Part.ComponentIndex];
+            return Slots.IsValidIndex(Section.MaterialIndex) ? Slots[Section.MaterialIndex] : 0;
+        };
+
+    TArray<uint32> MaterialIndexCounts;
+    MaterialIndexCounts.SetNumZeroed(NumMaterials);
+
+    int32 NumVertices = 0;
+    int32 NumSectionOffsets = 0;
+
+    for (FPart& Each_Part : Parts)
+    {
+        const FMeshOps_MeshBuffers& Source = Sources[Each_Part.MeshIndex];
+
+        Each_Part.FirstVertex = NumVertices;
+        Each_Part.FirstSectionOffset = NumSectionOffsets;
+
+        NumVertices += Source.GetNumVertices();
+        NumSectionOffsets += Source.Sections.Num();
+
+        for (const FMeshOps_MeshBuffers::FSection& Each_Section : Source.Sections)
+        {
+            MaterialIndexCounts[GetMaterialOfSection(Each_Part, Each_Section)] += Each_Section.NumTriangles * 3;
+        }
+    }
+
+    FMeshOps_MeshBuffers Merged;
+    TArray<uint32> MaterialFirstIndices;
+    MaterialFirstIndices.SetNumZeroed(NumMaterials);
+
+    uint32 NumIndices = 0;
+
+    for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+    {
+        MaterialFirstIndices[MaterialIndex] = NumIndices;
+        NumIndices += MaterialIndexCounts[MaterialIndex];
+    }
+
+    TArray<uint32> SectionOffsets;
+    SectionOffsets.SetNumUninitialized(NumSectionOffsets);
+
+    TArray<uint32> MaterialCursors = MaterialFirstIndices;
+    TArray<uint32> MinVertices;
+    TArray<uint32> MaxVertices;
+    MinVertices.Init(MAX_uint32, NumMaterials);
+    MaxVertices.Init(0, NumMaterials);
+
+    for (const FPart& Each_Part : Parts)
+    {
+        const FMeshOps_MeshBuffers& Source = Sources[Each_Part.MeshIndex];
+
+        for (int32 SectionIndex = 0; SectionIndex < Source.Sections.Num(); SectionIndex++)
+        {
+            const FMeshOps_MeshBuffers::FSection& Section = Source.Sections[SectionIndex];
+            const int32 MaterialIndex = GetMaterialOfSection(Each_Part, Section);
+
+            SectionOffsets[Each_Part.FirstSectionOffset + SectionIndex] = MaterialCursors[MaterialIndex];
+            MaterialCursors[MaterialIndex] += Section.NumTriangles * 3;
+
+            MinVertices[MaterialIndex] = FMath::Min(MinVertices[MaterialIndex], Each_Part.FirstVertex + Section.MinVertexIndex);
+            MaxVertices[MaterialIndex] = FMath::Max(MaxVertices[MaterialIndex], Each_Part.FirstVertex + Section.MaxVertexIndex);
+        }
+    }
+
+    for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+    {
+        if (MaterialIndexCounts[MaterialIndex] == 0)
+        {
+            continue;
+        }
+
+        FMeshOps_MeshBuffers::FSection& NewSection = Merged.Sections.AddDefaulted_GetRef();
+        NewSection.MaterialIndex = MaterialIndex;
+        NewSection.FirstIndex = MaterialFirstIndices[MaterialIndex];
+        NewSection.NumTriangles = MaterialIndexCounts[MaterialIndex] / 3;
+        NewSection.MinVertexIndex = MinVertices[MaterialIndex];
+        NewSection.MaxVertexIndex = MaxVertices[MaterialIndex];
+    }
+
+    Merged.Positions.SetNumUninitialized(NumVertices);
+    Merged.Normals.SetNumUninitialized(NumVertices);
+    Merged.Tangents.SetNumUninitialized(NumVertices);
+    Merged.TangentSigns.SetNumUninitialized(NumVertices);
+    Merged.UVs.SetNumUninitialized(NumVertices);
+    Merged.Indices.SetNumUninitialized(NumIndices);
+
+    ParallelFor(Parts.Num(), [&Parts, &Sources, &SectionOffsets, &Merged](int32 PartIndex)
+        {
+            const FPart& Part = Parts[PartIndex];
+            const FMeshOps_MeshBuffers& Source = Sources[Part.MeshIndex];
+
+            // Normals need inverse transpose to stay perpendicular under non uniform scale.
+            const FMatrix44d NormalMatrix = Part.Matrix.Inverse().GetTransposed();
+
+            // Mirroring transforms flip winding, so triangles are reversed to keep them front facing.
+            const bool bIsMirrored = Part.Matrix.Determinant() < 0;
+
+            for (int32 VertexIndex = 0; VertexIndex < Source.GetNumVertices(); VertexIndex++)
+            {
+                const int32 Target = Part.FirstVertex + VertexIndex;
+
+                Merged.Positions[Target] = (FVector3f)Part.Matrix.TransformPosition((FVector)Source.Positions[VertexIndex]);
+                Merged.Normals[Target] = (FVector3f)NormalMatrix.TransformVector((FVector)Source.Normals[VertexIndex]).GetSafeNormal();
+                Merged.Tangents[Target] = (FVector3f)Part.Matrix.TransformVector((FVector)Source.Tangents[VertexIndex]).GetSafeNormal();
+
+                // Mirroring flips handedness of the tangent basis too.
+                const float TangentSign = Source.TangentSigns.IsEmpty() ? 1.f : Source.TangentSigns[VertexIndex];
+                Merged.TangentSigns[Target] = bIsMirrored ? -TangentSign : TangentSign;
+                Merged.UVs[Target] = Source.UVs[VertexIndex];
+            }
+
+            for (int32 SectionIndex = 0; SectionIndex < Source.Sections.Num(); SectionIndex++)
+            {
+                const FMeshOps_MeshBuffers::FSection& Section = Source.Sections[SectionIndex];
+                uint32 Target = SectionOffsets[Part.FirstSectionOffset + SectionIndex];
+
+                for (uint32 Triangle = 0; Triangle < Section.NumTriangles; Triangle++)
+                {
+                    const uint32 First = Section.FirstIndex + Triangle * 3;
+
+                    Merged.Indices[Target] = Part.FirstVertex + Source.Indices[First];
+                    Merged.Indices[Target + 1] = Part.FirstVertex + Source.Indices[bIsMirrored ? First + 2 : First + 1];
+                    Merged.Indices[Target + 2] = Part.FirstVertex + Source.Indices[bIsMirrored ? First + 1 : First + 2];
+                    Target += 3;
+                }
+            }
+        });
+
+    TArray<FMeshOps_MeshBuffers> LODs;
+    LODs.SetNum(FMath::Clamp(Options.NumLODs, 1, (int32)MAX_STATIC_MESH_LODS));
+    LODs[0] = MoveTemp(Merged);
+
+    if (LODs.Num() > 1)
+    {
+        FBox3f Bounds(ForceInit);
+
+        for (const FVector3f& Each_Position : LODs[0].Positions)
+        {
+            Bounds += Each_Position;
+        }
+
+        const double BaseCellSize = Bounds.GetSize().GetMax() * FMath::Max(Options.LOD_Reduction, 0.0001f);
+
+        // Every level is simplified from the base mesh, so levels are independent and built in parallel.
+        ParallelFor(LODs.Num() - 1, [&LODs, BaseCellSize](int32 Index)
+            {
+                FMeshOps_MeshBuilder::SimplifyByClustering(LODs[0], BaseCellSize * FMath::Pow(2.0, Index), LODs[Index + 1]);
+            });
+    }
+
+    const FMeshOps_MeshBuilder::ECollisionType CollisionType = Options.bCreateCollision ? FMeshOps_MeshBuilder::ECollisionType::Box : FMeshOps_MeshBuilder::ECollisionType::None;
+    UStaticMesh* MergedMesh = FMeshOps_MeshBuilder::BuildStaticMesh(Mesh_Name, LODs, Materials, CollisionType, Options.bSupportRayTracing);
+
+    if (MergedMesh && Options.bHideSourceComponents)
+    {
+        for (UStaticMeshComponent* Each_Component : Out_Merged)
+        {
+            Each_Component->SetVisibility(false);
+        }
+    }
+
+    return MergedMesh;
+}
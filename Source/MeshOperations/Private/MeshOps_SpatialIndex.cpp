@@ -0,0 +1,669 @@
+#include "MeshOps_SpatialIndex.h"
+
+#include "Components/StaticMeshComponent.h"
+
+#define BVH_MAX_LEAF_ITEMS 4
+#define BVH_NUM_BINS 16
+
+namespace MeshOps_SpatialIndex_Private
+{
+    static double GetHalfArea(const FBox& Box)
+    {
+        if (!Box.IsValid)
+        {
+            return 0;
+        }
+
+        const FVector Size = Box.GetSize();
+        return Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X;
+    }
+
+    // Slab test. Returns entry distance or a negative value if ray misses the box.
+    static double IntersectRay(const FBox& Box, const FVector& Origin, const FVector& InverseDirection, double MaxDistance)
+    {
+        if (!Box.IsValid)
+        {
+            return -1;
+        }
+
+        double Near = 0;
+        double Far = MaxDistance;
+
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            double T0 = (Box.Min[Axis] - Origin[Axis]) * InverseDirection[Axis];
+            double T1 = (Box.Max[Axis] - Origin[Axis]) * InverseDirection[Axis];
+
+            if (T0 > T1)
+            {
+                Swap(T0, T1);
+            }
+
+            Near = FMath::Max(Near, T0);
+            Far = FMath::Min(Far, T1);
+
+            if (Near > Far)
+            {
+                return -1;
+            }
+        }
+
+        return Near;
+    }
+}
+
+void FMeshOps_BVH::Build(TArrayView<const FBox> Boxes)
+{
+    this->Nodes.Reset();
+    this->ItemBoxes.Reset();
+    this->ItemBoxes.Append(Boxes.GetData(), Boxes.Num());
+    this->ItemOrder.SetNumUninitialized(Boxes.Num());
+    this->ItemLeaves.Init(INDEX_NONE, Boxes.Num());
+
+    if (Boxes.IsEmpty())
+    {
+        return;
+    }
+
+    TArray<FVector> Centers;
+    Centers.SetNumUninitialized(Boxes.Num());
+
+    for (int32 ItemIndex = 0; ItemIndex < Boxes.Num(); ItemIndex++)
+    {
+        this->ItemOrder[ItemIndex] = ItemIndex;
+        Centers[ItemIndex] = Boxes[ItemIndex].IsValid ? Boxes[ItemIndex].GetCenter() : FVector::ZeroVector;
+    }
+
+    // A balanced tree has 2N - 1 nodes at most.
+    this->Nodes.Reserve(2 * Boxes.Num());
+    this->BuildRecursive(INDEX_NONE, 0, Boxes.Num(), Centers);
+}
+
+int32 FMeshOps_BVH::BuildRecursive(int32 Parent, int32 First, int32 Count, TArray<FVector>& Centers)
+{
+    using namespace MeshOps_SpatialIndex_Private;
+
+    const int32 NodeIndex = this->Nodes.AddDefaulted();
+    this->Nodes[NodeIndex].Parent = Parent;
+
+    FBox NodeBox(ForceInit);
+    FBox CenterBox(ForceInit);
+
+    for (int32 Index = First; Index < First + Count; Index++)
+    {
+        NodeBox += this->ItemBoxes[this->ItemOrder[Index]];
+        CenterBox += Centers[this->ItemOrder[Index]];
+    }
+
+    this->Nodes[NodeIndex].Box = NodeBox;
+
+    const FVector CenterSize = CenterBox.GetSize();
+    const int32 Axis = CenterSize.X >= CenterSize.Y && CenterSize.X >= CenterSize.Z ? 0 : (CenterSize.Y >= CenterSize.Z ? 1 : 2);
+
+    if (Count <= BVH_MAX_LEAF_ITEMS)
+    {
+        this->Nodes[NodeIndex].FirstItem = First;
+        this->Nodes[NodeIndex].NumItems = Count;
+
+        for (int32 Index = First; Index < First + Count; Index++)
+        {
+            this->ItemLeaves[this->ItemOrder[Index]] = NodeIndex;
+        }
+
+        return NodeIndex;
+    }
+
+    int32 Middle = First;
+
+    if (CenterSize[Axis] > UE_KINDA_SMALL_NUMBER)
+    {
+        // Binned surface area heuristic.
+        FBox BinBoxes[BVH_NUM_BINS];
+        int32 BinCounts[BVH_NUM_BINS] = {};
+
+        for (FBox& Each_Bin : BinBoxes)
+        {
+            Each_Bin.Init();
+        }
+
+        const double BinScale = BVH_NUM_BINS / CenterSize[Axis];
+        auto GetBin = [&](int32 ItemIndex)
+            {
+                return FMath::Clamp((int32)((Centers[ItemIndex][Axis] - CenterBox.Min[Axis]) * BinScale), 0, BVH_NUM_BINS - 1);
+            };
+
+        for (int32 Index = First; Index < First + Count; Index++)
+        {
+            const int32 Bin = GetBin(this->ItemOrder[Index]);
+            BinBoxes[Bin] += this->ItemBoxes[this->ItemOrder[Index]];
+            BinCounts[Bin]++;
+        }
+
+        double RightCosts[BVH_NUM_BINS] = {};
+        FBox RightBox(ForceInit);
+        int32 RightCount = 0;
+
+        for (int32 Bin = BVH_NUM_BINS - 1; Bin > 0; Bin--)
+        {
+            RightBox += BinBoxes[Bin];
+            RightCount += BinCounts[Bin];
+            RightCosts[Bin] = RightCount * GetHalfArea(RightBox);
+        }
+
+        double BestCost = TNumericLimits<double>::Max();
+        int32 BestSplit = INDEX_NONE;
+        FBox LeftBox(ForceInit);
+        int32 LeftCount = 0;
+
+        for (int32 Split = 1; Split < BVH_NUM_BINS; Split++)
+        {
+            LeftBox += BinBoxes[Split - 1];
+            LeftCount += BinCounts[Split - 1];
+
+            const double Cost = LeftCount * GetHalfArea(LeftBox) + RightCosts[Split];
+
+            if (LeftCount > 0 && LeftCount < Count && Cost < BestCost)
+            {
+                BestCost = Cost;
+                BestSplit = Split;
+            }
+        }
+
+        if (BestSplit != INDEX_NONE)
+        {
+            int32 Left = First;
+            int32 Right = First + Count - 1;
+
+            while (Left <= Right)
+            {
+                if (GetBin(this->ItemOrder[Left]) < BestSplit)
+                {
+                    Left++;
+                }
+
+                else
+                {
+                    Swap(this->ItemOrder[Left], this->ItemOrder[Right]);
+                    Right--;
+                }
+            }
+
+            Middle = Left;
+        }
+    }
+
+    // All centers are in one bin. Median split keeps depth logarithmic.
+    if (Middle <= First || Middle >= First + Count)
+    {
+        MakeArrayView(this->ItemOrder.GetData() + First, Count).Sort([&Centers, Axis](int32 A, int32 B) { return Centers[A][Axis] < Centers[B][Axis]; });
+        Middle = First + Count / 2;
+    }
+
+    const int32 LeftChild = this->BuildRecursive(NodeIndex, First, Middle - First, Centers);
+    const int32 RightChild = this->BuildRecursive(NodeIndex, Middle, First + Count - Middle, Centers);
+
+    this->Nodes[NodeIndex].Left = LeftChild;
+    this->Nodes[NodeIndex].Right = RightChild;
+
+    return NodeIndex;
+}
+
+void FMeshOps_BVH::UpdateItem(int32 ItemIndex, const FBox& NewBox)
+{
+    if (!this->ItemBoxes.IsValidIndex(ItemIndex))
+    {
+        return;
+    }
+
+    this->ItemBoxes[ItemIndex] = NewBox;
+    this->RefitLeaf(this->ItemLeaves[ItemIndex]);
+}
+
+void FMeshOps_BVH::RefitLeaf(int32 NodeIndex)
+{
+    if (!this->Nodes.IsValidIndex(NodeIndex))
+    {
+        return;
+    }
+
+    FNode& Leaf = this->Nodes[NodeIndex];
+    Leaf.Box.Init();
+
+    for (int32 Index = Leaf.FirstItem; Index < Leaf.FirstItem + Leaf.NumItems; Index++)
+    {
+        Leaf.Box += this->ItemBoxes[this->ItemOrder[Index]];
+    }
+
+    // Boxes can shrink too, so each parent is recomputed from its children. Walk stops when a parent doesn't change.
+    for (int32 Parent = Leaf.Parent; Parent != INDEX_NONE; Parent = this->Nodes[Parent].Parent)
+    {
+        FNode& ParentNode = this->Nodes[Parent];
+        const FBox NewBox = this->Nodes[ParentNode.Left].Box + this->Nodes[ParentNode.Right].Box;
+
+        if (NewBox == ParentNode.Box)
+        {
+            break;
+        }
+
+        ParentNode.Box = NewBox;
+    }
+}
+
+void FMeshOps_BVH::QueryOverlap(const FBox& Box, TArray<int32>& Out_Items) const
+{
+    Out_Items.Reset();
+
+    if (this->Nodes.IsEmpty() || !Box.IsValid)
+    {
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+
+    while (!Stack.IsEmpty())
+    {
+        const FNode& Node = this->Nodes[Stack.Pop()];
+
+        if (!Node.Box.IsValid || !Node.Box.Intersect(Box))
+        {
+            continue;
+        }
+
+        if (!Node.IsLeaf())
+        {
+            Stack.Add(Node.Left);
+            Stack.Add(Node.Right);
+            continue;
+        }
+
+        for (int32 Index = Node.FirstItem; Index < Node.FirstItem + Node.NumItems; Index++)
+        {
+            const int32 ItemIndex = this->ItemOrder[Index];
+            const FBox& ItemBox = this->ItemBoxes[ItemIndex];
+
+            if (ItemBox.IsValid && ItemBox.Intersect(Box))
+            {
+                Out_Items.Add(ItemIndex);
+            }
+        }
+    }
+}
+
+void FMeshOps_BVH::QueryNearest(const FVector& Point, int32 Count, TArray<int32>& Out_Items, TArray<double>& Out_DistancesSquared) const
+{
+    Out_Items.Reset();
+    Out_DistancesSquared.Reset();
+
+    if (this->Nodes.IsEmpty() || Count <= 0)
+    {
+        return;
+    }
+
+    typedef TPair<double, int32> FEntry;
+
+    auto Closer = [](const FEntry& A, const FEntry& B) { return A.Key < B.Key; };
+    auto Farther = [](const FEntry& A, const FEntry& B) { return A.Key > B.Key; };
+
+    // Best first traversal. Queue is a min heap of node distances, results is a max heap of the current K best items.
+    TArray<FEntry> Queue;
+    TArray<FEntry> Results;
+
+    Queue.HeapPush(FEntry(this->Nodes[0].Box.ComputeSquaredDistanceToPoint(Point), 0), Closer);
+
+    while (!Queue.IsEmpty())
+    {
+        FEntry Current;
+        Queue.HeapPop(Current, Closer);
+
+        if (Results.Num() == Count && Current.Key > Results.HeapTop().Key)
+        {
+            break;
+        }
+
+        const FNode& Node = this->Nodes[Current.Value];
+
+        if (!Node.IsLeaf())
+        {
+            for (const int32 Child : { Node.Left, Node.Right })
+            {
+                if (this->Nodes[Child].Box.IsValid)
+                {
+                    Queue.HeapPush(FEntry(this->Nodes[Child].Box.ComputeSquaredDistanceToPoint(Point), Child), Closer);
+                }
+            }
+
+            continue;
+        }
+
+        for (int32 Index = Node.FirstItem; Index < Node.FirstItem + Node.NumItems; Index++)
+        {
+            const int32 ItemIndex = this->ItemOrder[Index];
+            const FBox& ItemBox = this->ItemBoxes[ItemIndex];
+
+            if (!ItemBox.IsValid)
+            {
+                continue;
+            }
+
+            const double DistanceSquared = ItemBox.ComputeSquaredDistanceToPoint(Point);
+
+            if (Results.Num() < Count)
+            {
+                Results.HeapPush(FEntry(DistanceSquared, ItemIndex), Farther);
+            }
+
+            else if (DistanceSquared < Results.HeapTop().Key)
+            {
+                FEntry Removed;
+                Results.HeapPop(Removed, Farther);
+                Results.HeapPush(FEntry(DistanceSquared, ItemIndex), Farther);
+            }
+        }
+    }
+
+    Results.Sort(Closer);
+
+    for (const FEntry& Each_Result : Results)
+    {
+        Out_Items.Add(Each_Result.Value);
+        Out_DistancesSquared.Add(Each_Result.Key);
+    }
+}
+
+int32 FMeshOps_BVH::Raycast(const FVector& Start, const FVector& End, TFunctionRef<double(int32 ItemIndex, double BoxDistance)> HitCallback, double& Out_Distance) const
+{
+    using namespace MeshOps_SpatialIndex_Private;
+
+    Out_Distance = -1;
+
+    const FVector Delta = End - Start;
+    const double Length = Delta.Size();
+
+    if (this->Nodes.IsEmpty() || Length < UE_KINDA_SMALL_NUMBER)
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector Direction = Delta / Length;
+    FVector InverseDirection;
+
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        const double Component = FMath::Abs(Direction[Axis]) > UE_DOUBLE_SMALL_NUMBER ? Direction[Axis] : UE_DOUBLE_SMALL_NUMBER;
+        InverseDirection[Axis] = 1.0 / Component;
+    }
+
+    double BestDistance = Length;
+    int32 BestItem = INDEX_NONE;
+
+    typedef TPair<double, int32> FEntry;
+    TArray<FEntry, TInlineAllocator<64>> Stack;
+
+    const double RootDistance = IntersectRay(this->Nodes[0].Box, Start, InverseDirection, BestDistance);
+
+    if (RootDistance >= 0)
+    {
+        Stack.Add(FEntry(RootDistance, 0));
+    }
+
+    while (!Stack.IsEmpty())
+    {
+        const FEntry Current = Stack.Pop();
+
+        if (Current.Key > BestDistance)
+        {
+            continue;
+        }
+
+        const FNode& Node = this->Nodes[Current.Value];
+
+        if (Node.IsLeaf())
+        {
+            for (int32 Index = Node.FirstItem; Index < Node.FirstItem + Node.NumItems; Index++)
+            {
+                const int32 ItemIndex = this->ItemOrder[Index];
+                const double BoxDistance = IntersectRay(this->ItemBoxes[ItemIndex], Start, InverseDirection, BestDistance);
+
+                if (BoxDistance < 0)
+                {
+                    continue;
+                }
+
+                const double HitDistance = HitCallback(ItemIndex, BoxDistance);
+
+                if (HitDistance >= 0 && HitDistance <= BestDistance)
+                {
+                    BestDistance = HitDistance;
+                    BestItem = ItemIndex;
+                }
+            }
+
+            continue;
+        }
+
+        const double LeftDistance = IntersectRay(this->Nodes[Node.Left].Box, Start, InverseDirection, BestDistance);
+        const double RightDistance = IntersectRay(this->Nodes[Node.Right].Box, Start, InverseDirection, BestDistance);
+
+        // Farther child is pushed first, so closer one is visited first and tightens the best distance.
+        const bool bIsLeftCloser = LeftDistance >= 0 && (RightDistance < 0 || LeftDistance <= RightDistance);
+        const FEntry Closer = bIsLeftCloser ? FEntry(LeftDistance, Node.Left) : FEntry(RightDistance, Node.Right);
+        const FEntry Farther = bIsLeftCloser ? FEntry(RightDistance, Node.Right) : FEntry(LeftDistance, Node.Left);
+
+        if (Farther.Key >= 0)
+        {
+            Stack.Add(Farther);
+        }
+
+        if (Closer.Key >= 0)
+        {
+            Stack.Add(Closer);
+        }
+    }
+
+    if (BestItem != INDEX_NONE)
+    {
+        Out_Distance = BestDistance;
+    }
+
+    return BestItem;
+}
+
+void UMeshOps_SpatialIndex::BeginDestroy()
+{
+    this->UnbindItems();
+    Super::BeginDestroy();
+}
+
+bool UMeshOps_SpatialIndex::Initialize(USceneComponent* AssetRoot, bool bOnlyStaticMeshes, bool bAutoRefit)
+{
+    this->Root = AssetRoot;
+    this->bIsOnlyStaticMeshes = bOnlyStaticMeshes;
+    this->bIsAutoRefit = bAutoRefit;
+
+    this->Rebuild();
+    return IsValid(AssetRoot);
+}
+
+void UMeshOps_SpatialIndex::Gather()
+{
+    this->UnbindItems();
+    this->Items.Reset();
+    this->ItemIndices.Reset();
+    this->DirtyItems.Reset();
+
+    USceneComponent* AssetRoot = this->Root.Get();
+
+    if (!IsValid(AssetRoot))
+    {
+        return;
+    }
+
+    TArray<USceneComponent*> Children;
+    AssetRoot->GetChildrenComponents(true, Children);
+
+    for (USceneComponent* Each_Child : Children)
+    {
+        UPrimitiveComponent* Primitive = this->bIsOnlyStaticMeshes ? Cast<UStaticMeshComponent>(Each_Child) : Cast<UPrimitiveComponent>(Each_Child);
+
+        if (IsValid(Primitive))
+        {
+            this->ItemIndices.Add(Primitive, this->Items.Num());
+            this->Items.Add(Primitive);
+        }
+    }
+
+    if (this->bIsAutoRefit)
+    {
+        this->TransformHandles.Reserve(this->Items.Num());
+
+        for (const TWeakObjectPtr<UPrimitiveComponent>& Each_Item : this->Items)
+        {
+            this->TransformHandles.Add(Each_Item->TransformUpdated.AddUObject(this, &UMeshOps_SpatialIndex::OnTransformUpdated));
+        }
+    }
+}
+
+void UMeshOps_SpatialIndex::UnbindItems()
+{
+    for (int32 ItemIndex = 0; ItemIndex < this->TransformHandles.Num(); ItemIndex++)
+    {
+        if (UPrimitiveComponent* Primitive = this->Items[ItemIndex].Get())
+        {
+            Primitive->TransformUpdated.Remove(this->TransformHandles[ItemIndex]);
+        }
+    }
+
+    this->TransformHandles.Reset();
+}
+
+void UMeshOps_SpatialIndex::OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (const int32* ItemIndex = this->ItemIndices.Find(UpdatedComponent))
+    {
+        this->DirtyItems.Add(*ItemIndex);
+    }
+}
+
+void UMeshOps_SpatialIndex::GetResults(const TArray<int32>& Results, TArray<UPrimitiveComponent*>& Out_Components) const
+{
+    Out_Components.Reset(Results.Num());
+
+    for (const int32 ItemIndex : Results)
+    {
+        if (UPrimitiveComponent* Primitive = this->Items[ItemIndex].Get())
+        {
+            Out_Components.Add(Primitive);
+        }
+    }
+}
+
+void UMeshOps_SpatialIndex::Rebuild()
+{
+    this->Gather();
+
+    TArray<FBox> Boxes;
+    Boxes.SetNumUninitialized(this->Items.Num());
+
+    for (int32 ItemIndex = 0; ItemIndex < this->Items.Num(); ItemIndex++)
+    {
+        const UPrimitiveComponent* Primitive = this->Items[ItemIndex].Get();
+        Boxes[ItemIndex] = IsValid(Primitive) ? Primitive->Bounds.GetBox() : FBox(ForceInit);
+    }
+
+    this->BVH.Build(Boxes);
+    this->DirtyItems.Reset();
+}
+
+void UMeshOps_SpatialIndex::Refit()
+{
+    for (const int32 ItemIndex : this->DirtyItems)
+    {
+        const UPrimitiveComponent* Primitive = this->Items[ItemIndex].Get();
+        this->BVH.UpdateItem(ItemIndex, IsValid(Primitive) ? Primitive->Bounds.GetBox() : FBox(ForceInit));
+    }
+
+    this->DirtyItems.Reset();
+}
+
+void UMeshOps_SpatialIndex::QueryOverlap(FVector In_Origin, FVector In_Extent, TArray<UPrimitiveComponent*>& Out_Components)
+{
+    this->Refit();
+
+    TArray<int32> Results;
+    this->BVH.QueryOverlap(FBox::BuildAABB(In_Origin, In_Extent), Results);
+    this->GetResults(Results, Out_Components);
+}
+
+void UMeshOps_SpatialIndex::QueryNearest(FVector Location, int32 Count, TArray<UPrimitiveComponent*>& Out_Components, TArray<double>& Out_Distances)
+{
+    this->Refit();
+
+    TArray<int32> Results;
+    TArray<double> DistancesSquared;
+    this->BVH.QueryNearest(Location, Count, Results, DistancesSquared);
+
+    Out_Components.Reset(Results.Num());
+    Out_Distances.Reset(Results.Num());
+
+    for (int32 Index = 0; Index < Results.Num(); Index++)
+    {
+        if (UPrimitiveComponent* Primitive = this->Items[Results[Index]].Get())
+        {
+            Out_Components.Add(Primitive);
+            Out_Distances.Add(FMath::Sqrt(DistancesSquared[Index]));
+        }
+    }
+}
+
+bool UMeshOps_SpatialIndex::Raycast(FVector Start, FVector End, bool bTraceComplex, UPrimitiveComponent*& Out_Component, FVector& Out_Location, double& Out_Distance)
+{
+    this->Refit();
+
+    Out_Component = nullptr;
+    Out_Location = FVector::ZeroVector;
+    Out_Distance = -1;
+
+    const FCollisionQueryParams QueryParams(FName(TEXT("MeshOps_SpatialIndex")), true);
+    const double Length = FVector::Dist(Start, End);
+
+    auto HitCallback = [this, bTraceComplex, &Start, &End, &QueryParams, Length](int32 ItemIndex, double BoxDistance) -> double
+        {
+            UPrimitiveComponent* Primitive = this->Items[ItemIndex].Get();
+
+            if (!IsValid(Primitive))
+            {
+                return -1;
+            }
+
+            if (!bTraceComplex)
+            {
+                return BoxDistance;
+            }
+
+            FHitResult HitResult;
+
+            if (!Primitive->LineTraceComponent(HitResult, Start, End, QueryParams))
+            {
+                return -1;
+            }
+
+            return HitResult.Time * Length;
+        };
+
+    const int32 HitItem = this->BVH.Raycast(Start, End, HitCallback, Out_Distance);
+
+    if (HitItem == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Out_Component = this->Items[HitItem].Get();
+    Out_Location = Start + (End - Start).GetSafeNormal() * Out_Distance;
+    return true;
+}
+
+int32 UMeshOps_SpatialIndex::GetNumItems() const
+{
+    return this->Items.Num();
+}
@@ -0,0 +1,227 @@
+#include "MeshOps_SpatialQueries.h"
+
+#include "Async/ParallelFor.h"
+
+// Has to be a multiple of 32, so chunks never share a bitset word.
+#define SPATIAL_QUERY_CHUNK_SIZE 1024
+
+namespace MeshOps_SpatialQueries_Private
+{
+    // Padding value for the last partial group of four. It is never inside of anything.
+    static constexpr float OutsideValue = 3.0e38f;
+
+    static int32 GetNumChunks(int32 NumElements)
+    {
+        return FMath::DivideAndRoundUp(NumElements, SPATIAL_QUERY_CHUNK_SIZE);
+    }
+
+    static EParallelForFlags GetFlags(int32 NumElements)
+    {
+        return NumElements > SPATIAL_QUERY_CHUNK_SIZE ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+    }
+
+    static void InitBits(TBitArray<>& Bits, int32 NumElements)
+    {
+        Bits.Init(false, NumElements);
+    }
+
+    // Writes 4 bit mask of one group into the chunk's words.
+    static void WriteMask(uint32* Words, int32 ElementIndex, uint32 Mask)
+    {
+        Words[ElementIndex / 32] |= Mask << (ElementIndex % 32);
+    }
+}
+
+void FMeshOps_SpatialQueries::PointsInBox(TArrayView<const FVector> Points, const FBox& Bounds, TBitArray<>& Out_Inside)
+{
+    using namespace MeshOps_SpatialQueries_Private;
+
+    const int32 NumPoints = Points.Num();
+    InitBits(Out_Inside, NumPoints);
+
+    if (NumPoints == 0 || !Bounds.IsValid)
+    {
+        return;
+    }
+
+    const FVector Center = Bounds.GetCenter();
+    const FVector Extent = Bounds.GetExtent();
+    uint32* Words = Out_Inside.GetData();
+
+    ParallelFor(GetNumChunks(NumPoints), [&Points, &Center, &Extent, Words, NumPoints](int32 ChunkIndex)
+        {
+            const int32 First = ChunkIndex * SPATIAL_QUERY_CHUNK_SIZE;
+            const int32 Count = FMath::Min(SPATIAL_QUERY_CHUNK_SIZE, NumPoints - First);
+
+            alignas(16) float Xs[SPATIAL_QUERY_CHUNK_SIZE];
+            alignas(16) float Ys[SPATIAL_QUERY_CHUNK_SIZE];
+            alignas(16) float Zs[SPATIAL_QUERY_CHUNK_SIZE];
+
+            const int32 PaddedCount = Align(Count, 4);
+
+            for (int32 Index = 0; Index < PaddedCount; Index++)
+            {
+                if (Index < Count)
+                {
+                    const FVector Relative = Points[First + Index] - Center;
+                    Xs[Index] = (float)Relative.X;
+                    Ys[Index] = (float)Relative.Y;
+                    Zs[Index] = (float)Relative.Z;
+                }
+
+                else
+                {
+                    Xs[Index] = Ys[Index] = Zs[Index] = OutsideValue;
+                }
+            }
+
+            const VectorRegister4Float Extent_X = VectorSetFloat1((float)Extent.X);
+            const VectorRegister4Float Extent_Y = VectorSetFloat1((float)Extent.Y);
+            const VectorRegister4Float Extent_Z = VectorSetFloat1((float)Extent.Z);
+
+            for (int32 Index = 0; Index < PaddedCount; Index += 4)
+            {
+                const VectorRegister4Float Inside_X = VectorCompareLT(VectorAbs(VectorLoadAligned(&Xs[Index])), Extent_X);
+                const VectorRegister4Float Inside_Y = VectorCompareLT(VectorAbs(VectorLoadAligned(&Ys[Index])), Extent_Y);
+                const VectorRegister4Float Inside_Z = VectorCompareLT(VectorAbs(VectorLoadAligned(&Zs[Index])), Extent_Z);
+                const uint32 Mask = (uint32)VectorMaskBits(VectorBitwiseAnd(Inside_X, VectorBitwiseAnd(Inside_Y, Inside_Z)));
+
+                WriteMask(Words, First + Index, Mask);
+            }
+        }, GetFlags(NumPoints));
+
+    // Padding lanes are always outside, but we clear them anyway to keep bits after Num() zero.
+    const int32 NumBitsInLastWord = NumPoints % 32;
+
+    if (NumBitsInLastWord != 0)
+    {
+        Words[NumPoints / 32] &= (1u << NumBitsInLastWord) - 1;
+    }
+}
+
+void FMeshOps_SpatialQueries::PointsInBoxes(TArrayView<const FVector> Points, TArrayView<const FBox> Bounds, TArray<int32>& Out_BoundsIndices)
+{
+    Out_BoundsIndices.Init(INDEX_NONE, Points.Num());
+
+    TBitArray<> Inside;
+
+    for (int32 BoundsIndex = 0; BoundsIndex < Bounds.Num(); BoundsIndex++)
+    {
+        FMeshOps_SpatialQueries::PointsInBox(Points, Bounds[BoundsIndex], Inside);
+
+        for (TConstSetBitIterator<> It(Inside); It; ++It)
+        {
+            int32& Result = Out_BoundsIndices[It.GetIndex()];
+
+            if (Result == INDEX_NONE)
+            {
+                Result = BoundsIndex;
+            }
+        }
+    }
+}
+
+void FMeshOps_SpatialQueries::BoxesInBox(TArrayView<const FBox> Boxes, const FBox& Bounds, bool bFullyInside, TBitArray<>& Out_Result)
+{
+    using namespace MeshOps_SpatialQueries_Private;
+
+    const int32 NumBoxes = Boxes.Num();
+    InitBits(Out_Result, NumBoxes);
+
+    if (NumBoxes == 0 || !Bounds.IsValid)
+    {
+        return;
+    }
+
+    const FVector Center = Bounds.GetCenter();
+    const FVector Extent = Bounds.GetExtent();
+    uint32* Words = Out_Result.GetData();
+
+    ParallelFor(GetNumChunks(NumBoxes), [&Boxes, &Center, &Extent, Words, NumBoxes, bFullyInside](int32 ChunkIndex)
+        {
+            const int32 First = ChunkIndex * SPATIAL_QUERY_CHUNK_SIZE;
+            const int32 Count = FMath::Min(SPATIAL_QUERY_CHUNK_SIZE, NumBoxes - First);
+            const int32 PaddedCount = Align(Count, 4);
+
+            // Box to box tests are done with centers and extents: |C| + E <= B for containment and |C| <= E + B for intersection.
+            alignas(16) float Centers[3][SPATIAL_QUERY_CHUNK_SIZE];
+            alignas(16) float Extents[3][SPATIAL_QUERY_CHUNK_SIZE];
+
+            for (int32 Index = 0; Index < PaddedCount; Index++)
+            {
+                const FBox* Box = Index < Count ? &Boxes[First + Index] : nullptr;
+
+                if (Box && Box->IsValid)
+                {
+                    const FVector Relative = Box->GetCenter() - Center;
+                    const FVector BoxExtent = Box->GetExtent();
+
+                    for (int32 Axis = 0; Axis < 3; Axis++)
+                    {
+                        Centers[Axis][Index] = (float)Relative[Axis];
+                        Extents[Axis][Index] = (float)BoxExtent[Axis];
+                    }
+                }
+
+                else
+                {
+                    for (int32 Axis = 0; Axis < 3; Axis++)
+                    {
+                        Centers[Axis][Index] = OutsideValue;
+                        Extents[Axis][Index] = 0.f;
+                    }
+                }
+            }
+
+            const VectorRegister4Float Bounds_Extents[3] = { VectorSetFloat1((float)Extent.X), VectorSetFloat1((float)Extent.Y), VectorSetFloat1((float)Extent.Z) };
+
+            for (int32 Index = 0; Index < PaddedCount; Index += 4)
+            {
+                VectorRegister4Float AxisResults[3];
+
+                for (int32 Axis = 0; Axis < 3; Axis++)
+                {
+                    const VectorRegister4Float BoxCenter = VectorAbs(VectorLoadAligned(&Centers[Axis][Index]));
+                    const VectorRegister4Float BoxExtent = VectorLoadAligned(&Extents[Axis][Index]);
+
+                    AxisResults[Axis] = bFullyInside
+                        ? VectorCompareLE(VectorAdd(BoxCenter, BoxExtent), Bounds_Extents[Axis])
+                        : VectorCompareLE(BoxCenter, VectorAdd(BoxExtent, Bounds_Extents[Axis]));
+                }
+
+                const VectorRegister4Float Accepted = VectorBitwiseAnd(AxisResults[0], VectorBitwiseAnd(AxisResults[1], AxisResults[2]));
+
+                WriteMask(Words, First + Index, (uint32)VectorMaskBits(Accepted));
+            }
+        }, GetFlags(NumBoxes));
+
+    const int32 NumBitsInLastWord = NumBoxes % 32;
+
+    if (NumBitsInLastWord != 0)
+    {
+        Words[NumBoxes / 32] &= (1u << NumBitsInLastWord) - 1;
+    }
+}
+
+void FMeshOps_SpatialQueries::BitsToIndices(const TBitArray<>& Bits, bool bValue, TArray<int32>& Out_Indices)
+{
+    Out_Indices.Reset();
+
+    if (bValue)
+    {
+        for (TConstSetBitIterator<> It(Bits); It; ++It)
+        {
+            Out_Indices.Add(It.GetIndex());
+        }
+
+        return;
+    }
+
+    for (int32 Index = 0; Index < Bits.Num(); Index++)
+    {
+        if (!Bits[Index])
+        {
+            Out_Indices.Add(Index);
+        }
+    }
+}
@@ -0,0 +1,715 @@
+#include "MeshOps_TightBounds.h"
+
+#include "Async/ParallelFor.h"
+#include "CompGeom/ConvexHull3.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+// Hull cache isn't scanned for stale entries before it has this many hulls.
+#define HULL_CACHE_MIN_PURGE_SIZE 256
+
+namespace MeshOps_TightBounds_Private
+{
+    struct FCachedHull
+    {
+        TSharedPtr<const FMeshOps_TightBounds::FMeshHull> Hull;
+
+        // Render data is recreated when a mesh is rebuilt. We use it to detect stale hulls.
+        const FStaticMeshRenderData* RenderData = nullptr;
+    };
+
+    typedef TPair<TWeakObjectPtr<const UStaticMesh>, int32> FHullKey;
+
+    // Cache is only accessed from game thread. Hulls themselves are computed on workers.
+    static TMap<FHullKey, FCachedHull>& GetHullCache()
+    {
+        static TMap<FHullKey, FCachedHull> HullCache;
+        return HullCache;
+    }
+
+    // Stale entries are removed on lookup, so a rebuilt mesh doesn't keep its old hull alive until the next purge.
+    static const FCachedHull* FindValidHull(const UStaticMesh* StaticMesh, int32 LOD_Index)
+    {
+        const FHullKey Key(StaticMesh, LOD_Index);
+        const FCachedHull* Found = GetHullCache().Find(Key);
+
+        if (!Found)
+        {
+            return nullptr;
+        }
+
+        if (Found->RenderData == StaticMesh->GetRenderData())
+        {
+            return Found;
+        }
+
+        GetHullCache().Remove(Key);
+        return nullptr;
+    }
+
+    // Entries of destroyed meshes are never looked up again. They are purged whenever cache doubles its size since the last purge, so adding hulls stays amortized O(1).
+    static void PurgeStaleHulls(bool bIsForced)
+    {
+        static int32 NextPurgeSize = HULL_CACHE_MIN_PURGE_SIZE;
+        TMap<FHullKey, FCachedHull>& HullCache = GetHullCache();
+
+        if (!bIsForced && HullCache.Num() < NextPurgeSize)
+        {
+            return;
+        }
+
+        for (auto It = HullCache.CreateIterator(); It; ++It)
+        {
+            const UStaticMesh* StaticMesh = It.Key().Key.Get();
+
+            if (!StaticMesh || It.Value().RenderData != StaticMesh->GetRenderData())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        NextPurgeSize = FMath::Max(HullCache.Num() * 2, HULL_CACHE_MIN_PURGE_SIZE);
+    }
+
+    static TSharedPtr<FMeshOps_TightBounds::FMeshHull> BuildMeshHull(const UStaticMesh* StaticMesh, int32 LOD_Index)
+    {
+        TSharedPtr<FMeshOps_TightBounds::FMeshHull> MeshHull = MakeShared<FMeshOps_TightBounds::FMeshHull>();
+        const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+
+        // Packaged builds discard CPU copies of vertex buffers unless mesh allows CPU access.
+        const bool bHasCPUData = WITH_EDITOR || StaticMesh->bAllowCPUAccess;
+
+        if (bHasCPUData && RenderData && RenderData->LODResources.IsValidIndex(LOD_Index))
+        {
+            const FPositionVertexBuffer& Positions = RenderData->LODResources[LOD_Index].VertexBuffers.PositionVertexBuffer;
+            const int32 NumVertices = Positions.GetNumVertices();
+
+            if (NumVertices > 0 && Positions.GetVertexData())
+            {
+                UE::Geometry::TConvexHull3<double> ConvexHull;
+                const bool bIsSolved = ConvexHull.Solve(NumVertices, [&Positions](int32 Index) { return FVector3d(Positions.VertexPosition(Index)); });
+
+                if (bIsSolved && ConvexHull.GetDimension() == 3)
+                {
+                    TBitArray<> IsHullVertex(false, NumVertices);
+
+                    for (const UE::Geometry::FIndex3i& Each_Triangle : ConvexHull.GetTriangles())
+                    {
+                        IsHullVertex[Each_Triangle.A] = true;
+                        IsHullVertex[Each_Triangle.B] = true;
+                        IsHullVertex[Each_Triangle.C] = true;
+                    }
+
+                    for (TConstSetBitIterator<> It(IsHullVertex); It; ++It)
+                    {
+                        const FVector3f& Position = Positions.VertexPosition(It.GetIndex());
+                        MeshHull->Points.Add(FVector4f(Position.X, Position.Y, Position.Z, 0.f));
+                    }
+                }
+
+                // Flat or linear meshes don't have a 3D hull. All points are still exact.
+                else
+                {
+                    MeshHull->Points.Reserve(NumVertices);
+
+                    for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+                    {
+                        const FVector3f& Position = Positions.VertexPosition(VertexIndex);
+                        MeshHull->Points.Add(FVector4f(Position.X, Position.Y, Position.Z, 0.f));
+                    }
+                }
+
+                MeshHull->bIsExact = true;
+                return MeshHull;
+            }
+        }
+
+        FVector Corners[8];
+        StaticMesh->GetBoundingBox().GetVertices(Corners);
+
+        for (const FVector& Each_Corner : Corners)
+        {
+            MeshHull->Points.Add(FVector4f((float)Each_Corner.X, (float)Each_Corner.Y, (float)Each_Corner.Z, 0.f));
+        }
+
+        MeshHull->bIsExact = false;
+        return MeshHull;
+    }
+
+    // Jacobi rotations. Matrix is 3x3 and symmetric, so a few sweeps are enough.
+    static void GetEigenVectors(double Matrix[3][3], FVector Out_Axes[3])
+    {
+        double Vectors[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+        const int32 Pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+
+        for (int32 Sweep = 0; Sweep < 32; Sweep++)
+        {
+            const double OffDiagonal = FMath::Square(Matrix[0][1]) + FMath::Square(Matrix[0][2]) + FMath::Square(Matrix[1][2]);
+
+            if (OffDiagonal < UE_DOUBLE_SMALL_NUMBER)
+            {
+                break;
+            }
+
+            for (const int32* Each_Pair : Pairs)
+            {
+                const int32 P = Each_Pair[0];
+                const int32 Q = Each_Pair[1];
+
+                if (FMath::Abs(Matrix[P][Q]) < UE_DOUBLE_SMALL_NUMBER)
+                {
+                    continue;
+                }
+
+                const double Theta = (Matrix[Q][Q] - Matrix[P][P]) / (2.0 * Matrix[P][Q]);
+                const double T = (Theta >= 0 ? 1.0 : -1.0) / (FMath::Abs(Theta) + FMath::Sqrt(Theta * Theta + 1.0));
+                const double C = 1.0 / FMath::Sqrt(T * T + 1.0);
+                const double S = T * C;
+
+                for (int32 K = 0; K < 3; K++)
+                {
+                    const double KP = Matrix[K][P];
+                    const double KQ = Matrix[K][Q];
+                    Matrix[K][P] = C * KP - S * KQ;
+                    Matrix[K][Q] = S * KP + C * KQ;
+                }
+
+                for (int32 K = 0; K < 3; K++)
+                {
+                    const double PK = Matrix[P][K];
+                    const double QK = Matrix[Q][K];
+                    Matrix[P][K] = C * PK - S * QK;
+                    Matrix[Q][K] = S * PK + C * QK;
+                }
+
+                for (int32 K = 0; K < 3; K++)
+                {
+                    const double KP = Vectors[K][P];
+                    const double KQ = Vectors[K][Q];
+                    Vectors[K][P] = C * KP - S * KQ;
+                    Vectors[K][Q] = S * KP + C * KQ;
+                }
+            }
+        }
+
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            Out_Axes[Axis] = FVector(Vectors[0][Axis], Vectors[1][Axis], Vectors[2][Axis]).GetSafeNormal();
+        }
+    }
+
+    static double Cross2D(const FVector2D& O, const FVector2D& A, const FVector2D& B)
+    {
+        return (A.X - O.X) * (B.Y - O.Y) - (A.Y - O.Y) * (B.X - O.X);
+    }
+
+    // Monotone chain. Result is counter clockwise without collinear points.
+    static void GetConvexHull2D(TArray<FVector2D>& Points, TArray<FVector2D>& Out_Hull)
+    {
+        Points.Sort([](const FVector2D& A, const FVector2D& B) { return A.X < B.X || (A.X == B.X && A.Y < B.Y); });
+
+        const int32 NumPoints = Points.Num();
+        Out_Hull.SetNumUninitialized(2 * NumPoints);
+        int32 HullSize = 0;
+
+        for (int32 Index = 0; Index < NumPoints; Index++)
+        {
+            while (HullSize >= 2 && Cross2D(Out_Hull[HullSize - 2], Out_Hull[HullSize - 1], Points[Index]) <= 0)
+            {
+                HullSize--;
+            }
+
+            Out_Hull[HullSize++] = Points[Index];
+        }
+
+        for (int32 Index = NumPoints - 2, LowerSize = HullSize + 1; Index >= 0; Index--)
+        {
+            while (HullSize >= LowerSize && Cross2D(Out_Hull[HullSize - 2], Out_Hull[HullSize - 1], Points[Index]) <= 0)
+            {
+                HullSize--;
+            }
+
+            Out_Hull[HullSize++] = Points[Index];
+        }
+
+        Out_Hull.SetNum(FMath::Max(HullSize - 1, FMath::Min(NumPoints, 1)));
+    }
+
+    struct FRectangle2D
+    {
+        FVector2D Center = FVector2D::ZeroVector;
+        FVector2D AxisX = FVector2D(1, 0);
+        double HalfX = 0;
+        double HalfY = 0;
+    };
+
+    // Rotating calipers. One side of the minimum area rectangle is collinear with a hull edge, so we only check hull edges and move three support pointers forward.
+    static FRectangle2D GetMinAreaRectangle(const TArray<FVector2D>& Hull)
+    {
+        FRectangle2D Result;
+        const int32 NumPoints = Hull.Num();
+
+        if (NumPoints == 0)
+        {
+            return Result;
+        }
+
+        if (NumPoints < 3)
+        {
+            const FVector2D Segment = Hull.Last() - Hull[0];
+            Result.Center = (Hull[0] + Hull.Last()) * 0.5;
+            Result.AxisX = Segment.IsNearlyZero() ? FVector2D(1, 0) : Segment.GetSafeNormal();
+            Result.HalfX = Segment.Size() * 0.5;
+            return Result;
+        }
+
+        double BestArea = TNumericLimits<double>::Max();
+        int32 Index_MaxE = 0;
+        int32 Index_MaxN = 0;
+        int32 Index_MinE = 0;
+
+        for (int32 EdgeIndex = 0; EdgeIndex < NumPoints; EdgeIndex++)
+        {
+            const FVector2D& Origin = Hull[EdgeIndex];
+            const FVector2D Edge = (Hull[(EdgeIndex + 1) % NumPoints] - Origin).GetSafeNormal();
+
+            if (Edge.IsNearlyZero())
+            {
+                continue;
+            }
+
+            const FVector2D Normal(-Edge.Y, Edge.X);
+
+            auto Project = [&Hull, &Origin](int32 Index, const FVector2D& Axis)
+                {
+                    return FVector2D::DotProduct(Hull[Index] - Origin, Axis);
+                };
+
+            auto Advance = [&Project, NumPoints](int32& Pointer, const FVector2D& Axis, double Sign)
+                {
+                    for (int32 Step = 0; Step < NumPoints; Step++)
+                    {
+                        const int32 Next = (Pointer + 1) % NumPoints;
+
+                        if (Sign * Project(Next, Axis) < Sign * Project(Pointer, Axis))
+                        {
+                            break;
+                        }
+
+                        Pointer = Next;
+                    }
+                };
+
+            if (EdgeIndex == 0)
+            {
+                for (int32 Index = 1; Index < NumPoints; Index++)
+                {
+                    Index_MaxE = Project(Index, Edge) > Project(Index_MaxE, Edge) ? Index : Index_MaxE;
+                    Index_MaxN = Project(Index, Normal) > Project(Index_MaxN, Normal) ? Index : Index_MaxN;
+                    Index_MinE = Project(Index, Edge) < Project(Index_MinE, Edge) ? Index : Index_MinE;
+                }
+            }
+
+            else
+            {
+                Advance(Index_MaxE, Edge, 1.0);
+                Advance(Index_MaxN, Normal, 1.0);
+                Advance(Index_MinE, Edge, -1.0);
+            }
+
+            const double MaxE = Project(Index_MaxE, Edge);
+            const double MinE = Project(Index_MinE, Edge);
+            const double MaxN = Project(Index_MaxN, Normal);
+            const double Area = (MaxE - MinE) * MaxN;
+
+            if (Area < BestArea)
+            {
+                BestArea = Area;
+                Result.AxisX = Edge;
+                Result.HalfX = (MaxE - MinE) * 0.5;
+                Result.HalfY = MaxN * 0.5;
+                Result.Center = Origin + Edge * ((MaxE + MinE) * 0.5) + Normal * (MaxN * 0.5);
+            }
+        }
+
+        return Result;
+    }
+
+    struct FTightBoundsJob
+    {
+        TSharedPtr<const FMeshOps_TightBounds::FMeshHull> Hull;
+        FTransform Transform;
+        FBox FallbackBox = FBox(ForceInit);
+    };
+
+    // Static meshes (and each instance of instanced meshes) use cached hulls. Other primitives use their conservative bounds.
+    static void CollectJobs(USceneComponent* Target, TArray<FTightBoundsJob>& Out_Jobs)
+    {
+        TArray<USceneComponent*> Children;
+        Target->GetChildrenComponents(true, Children);
+
+        // Big assemblies repeat a few parts thousands of times, so meshes are deduplicated with a set.
+        TSet<const UStaticMesh*> Meshes;
+
+        for (USceneComponent* Each_Child : Children)
+        {
+            if (const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Each_Child))
+            {
+                if (const UStaticMesh* StaticMesh = MeshComp->GetStaticMesh())
+                {
+                    Meshes.Add(StaticMesh);
+                }
+            }
+        }
+
+        FMeshOps_TightBounds::PrecacheMeshHulls(Meshes.Array());
+
+        for (USceneComponent* Each_Child : Children)
+        {
+            const UPrimitiveComponent* Geometry = Cast<UPrimitiveComponent>(Each_Child);
+
+            if (!Geometry)
+            {
+                continue;
+            }
+
+            const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Geometry);
+            TSharedPtr<const FMeshOps_TightBounds::FMeshHull> Hull = MeshComp && MeshComp->GetStaticMesh() ? FMeshOps_TightBounds::GetMeshHull(MeshComp->GetStaticMesh()) : nullptr;
+
+            if (!Hull.IsValid())
+            {
+                FTightBoundsJob& Job = Out_Jobs.AddDefaulted_GetRef();
+                Job.FallbackBox = Geometry->Bounds.GetBox();
+                continue;
+            }
+
+            if (const UInstancedStaticMeshComponent* InstancedComp = Cast<UInstancedStaticMeshComponent>(MeshComp))
+            {
+                const int32 NumInstances = InstancedComp->GetInstanceCount();
+
+                for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; InstanceIndex++)
+                {
+                    FTightBoundsJob& Job = Out_Jobs.AddDefaulted_GetRef();
+                    Job.Hull = Hull;
+                    InstancedComp->GetInstanceTransform(InstanceIndex, Job.Transform, true);
+                }
+
+                continue;
+            }
+
+            FTightBoundsJob& Job = Out_Jobs.AddDefaulted_GetRef();
+            Job.Hull = Hull;
+            Job.Transform = MeshComp->GetComponentTransform();
+        }
+    }
+}
+
+TSharedPtr<const FMeshOps_TightBounds::FMeshHull> FMeshOps_TightBounds::GetMeshHull(const UStaticMesh* StaticMesh, int32 LOD_Index)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_TightBounds_Private;
+
+    if (!IsValid(StaticMesh))
+    {
+        return nullptr;
+    }
+
+    if (const FCachedHull* Found = FindValidHull(StaticMesh, LOD_Index))
+    {
+        return Found->Hull;
+    }
+
+    PurgeStaleHulls(false);
+
+    FCachedHull& NewEntry = GetHullCache().Add(FHullKey(StaticMesh, LOD_Index));
+    NewEntry.Hull = BuildMeshHull(StaticMesh, LOD_Index);
+    NewEntry.RenderData = StaticMesh->GetRenderData();
+
+    return NewEntry.Hull;
+}
+
+void FMeshOps_TightBounds::PrecacheMeshHulls(TArrayView<const UStaticMesh* const> StaticMeshes, int32 LOD_Index)
+{
+    check(IsInGameThread());
+    using namespace MeshOps_TightBounds_Private;
+
+    PurgeStaleHulls(true);
+
+    TSet<const UStaticMesh*> Checked;
+    TArray<const UStaticMesh*> Missing;
+
+    for (const UStaticMesh* Each_Mesh : StaticMeshes)
+    {
+        bool bIsChecked = false;
+        Checked.Add(Each_Mesh, &bIsChecked);
+
+        if (!bIsChecked && IsValid(Each_Mesh) && !FindValidHull(Each_Mesh, LOD_Index))
+        {
+            Missing.Add(Each_Mesh);
+        }
+    }
+
+    TArray<TSharedPtr<FMeshHull>> Hulls;
+    Hulls.SetNum(Missing.Num());
+
+    ParallelFor(Missing.Num(), [&Missing, &Hulls, LOD_Index](int32 Index)
+        {
+            Hulls[Index] = BuildMeshHull(Missing[Index], LOD_Index);
+        }
+    );
+
+    for (int32 Index = 0; Index < Missing.Num(); Index++)
+    {
+        FCachedHull& NewEntry = GetHullCache().Add(FHullKey(Missing[Index], LOD_Index));
+        NewEntry.Hull = Hulls[Index];
+        NewEntry.RenderData = Missing[Index]->GetRenderData();
+    }
+}
+
+void FMeshOps_TightBounds::ResetCache()
+{
+    check(IsInGameThread());
+    MeshOps_TightBounds_Private::GetHullCache().Empty();
+}
+
+FBox FMeshOps_TightBounds::TransformHullBox(const FMeshHull& Hull, const FTransform& Transform)
+{
+    if (Hull.Points.IsEmpty())
+    {
+        return FBox(ForceInit);
+    }
+
+    // Hull points are in float precision. Translation is added in double at the end to stay precise in large worlds.
+    FTransform Relative = Transform;
+    Relative.SetLocation(FVector::ZeroVector);
+    const FMatrix44f Matrix(Relative.ToMatrixWithScale());
+
+    const VectorRegister4Float Row_X = VectorLoad(&Matrix.M[0][0]);
+    const VectorRegister4Float Row_Y = VectorLoad(&Matrix.M[1][0]);
+    const VectorRegister4Float Row_Z = VectorLoad(&Matrix.M[2][0]);
+
+    VectorRegister4Float MinValue = VectorSetFloat1(UE_BIG_NUMBER);
+    VectorRegister4Float MaxValue = VectorSetFloat1(-UE_BIG_NUMBER);
+
+    for (const FVector4f& Each_Point : Hull.Points)
+    {
+        const VectorRegister4Float Point = VectorLoad(&Each_Point.X);
+
+        VectorRegister4Float Result = VectorMultiply(VectorReplicate(Point, 0), Row_X);
+        Result = VectorMultiplyAdd(VectorReplicate(Point, 1), Row_Y, Result);
+        Result = VectorMultiplyAdd(VectorReplicate(Point, 2), Row_Z, Result);
+
+        MinValue = VectorMin(MinValue, Result);
+        MaxValue = VectorMax(MaxValue, Result);
+    }
+
+    alignas(16) float MinFloats[4];
+    alignas(16) float MaxFloats[4];
+    VectorStoreAligned(MinValue, MinFloats);
+    VectorStoreAligned(MaxValue, MaxFloats);
+
+    const FVector Location = Transform.GetLocation();
+    return FBox(Location + FVector(MinFloats[0], MinFloats[1], MinFloats[2]), Location + FVector(MaxFloats[0], MaxFloats[1], MaxFloats[2]));
+}
+
+void FMeshOps_TightBounds::TransformHullPoints(const FMeshHull& Hull, const FTransform& Transform, TArray<FVector>& Out_Points)
+{
+    Out_Points.SetNumUninitialized(Hull.Points.Num());
+
+    for (int32 Index = 0; Index < Hull.Points.Num(); Index++)
+    {
+        const FVector4f& Each_Point = Hull.Points[Index];
+        Out_Points[Index] = Transform.TransformPosition(FVector(Each_Point.X, Each_Point.Y, Each_Point.Z));
+    }
+}
+
+bool FMeshOps_TightBounds::ComputeOrientedBox(TArrayView<const FVector> Points, FOrientedBoxStruct& Out_Box)
+{
+    using namespace MeshOps_TightBounds_Private;
+
+    Out_Box = FOrientedBoxStruct();
+
+    if (Points.IsEmpty())
+    {
+        return false;
+    }
+
+    FVector Mean = FVector::ZeroVector;
+
+    for (const FVector& Each_Point : Points)
+    {
+        Mean += Each_Point;
+    }
+
+    Mean /= Points.Num();
+
+    double Covariance[3][3] = {};
+
+    for (const FVector& Each_Point : Points)
+    {
+        const FVector Delta = Each_Point - Mean;
+
+        for (int32 Row = 0; Row < 3; Row++)
+        {
+            for (int32 Column = Row; Column < 3; Column++)
+            {
+                Covariance[Row][Column] += Delta[Row] * Delta[Column];
+            }
+        }
+    }
+
+    Covariance[1][0] = Covariance[0][1];
+    Covariance[2][0] = Covariance[0][2];
+    Covariance[2][1] = Covariance[1][2];
+
+    FVector Candidates[6];
+    GetEigenVectors(Covariance, Candidates);
+    Candidates[3] = FVector::XAxisVector;
+    Candidates[4] = FVector::YAxisVector;
+    Candidates[5] = FVector::ZAxisVector;
+
+    double BestVolume = TNumericLimits<double>::Max();
+    double BestArea = TNumericLimits<double>::Max();
+
+    TArray<FVector2D> Projected;
+    TArray<FVector2D> Hull;
+    Projected.SetNumUninitialized(Points.Num());
+
+    for (const FVector& Up : Candidates)
+    {
+        if (Up.IsNearlyZero())
+        {
+            continue;
+        }
+
+        FVector Axis_U;
+        FVector Axis_V;
+        Up.FindBestAxisVectors(Axis_U, Axis_V);
+
+        double MinUp = TNumericLimits<double>::Max();
+        double MaxUp = TNumericLimits<double>::Lowest();
+
+        for (int32 Index = 0; Index < Points.Num(); Index++)
+        {
+            const FVector Delta = Points[Index] - Mean;
+            const double Height = Delta | Up;
+
+            Projected[Index] = FVector2D(Delta | Axis_U, Delta | Axis_V);
+            MinUp = FMath::Min(MinUp, Height);
+            MaxUp = FMath::Max(MaxUp, Height);
+        }
+
+        GetConvexHull2D(Projected, Hull);
+        const FRectangle2D Rectangle = GetMinAreaRectangle(Hull);
+
+        const double Area = 4.0 * Rectangle.HalfX * Rectangle.HalfY;
+        const double Volume = Area * (MaxUp - MinUp);
+
+        // Flat assemblies have zero volume for several candidates, area decides between them.
+        const bool bIsBetter = FMath::IsNearlyEqual(Volume, BestVolume, BestVolume * UE_KINDA_SMALL_NUMBER) ? Area < BestArea : Volume < BestVolume;
+
+        if (!bIsBetter)
+        {
+            continue;
+        }
+
+        BestVolume = Volume;
+        BestArea = Area;
+
+        const FVector Axis_X = (Axis_U * Rectangle.AxisX.X + Axis_V * Rectangle.AxisX.Y).GetSafeNormal();
+        FVector Axis_Y = (Axis_U * -Rectangle.AxisX.Y + Axis_V * Rectangle.AxisX.X).GetSafeNormal();
+
+        if (((Axis_X ^ Axis_Y) | Up) < 0)
+        {
+            Axis_Y = -Axis_Y;
+        }
+
+        Out_Box.Center = Mean + Axis_U * Rectangle.Center.X + Axis_V * Rectangle.Center.Y + Up * ((MinUp + MaxUp) * 0.5);
+        Out_Box.Rotation = FMatrix(Axis_X, Axis_Y, Up, FVector::ZeroVector).Rotator();
+        Out_Box.Extent = FVector(Rectangle.HalfX, Rectangle.HalfY, (MaxUp - MinUp) * 0.5);
+    }
+
+    return true;
+}
+
+bool FMeshOps_TightBounds::GetExactBounds(USceneComponent* Target, FBox& Out_Box)
+{
+    using namespace MeshOps_TightBounds_Private;
+
+    Out_Box = FBox(ForceInit);
+
+    if (!IsValid(Target))
+    {
+        return false;
+    }
+
+    TArray<FTightBoundsJob> Jobs;
+    CollectJobs(Target, Jobs);
+
+    TArray<FBox> Boxes;
+    Boxes.SetNumUninitialized(Jobs.Num());
+
+    ParallelFor(Jobs.Num(), [&Jobs, &Boxes](int32 Index)
+        {
+            const FTightBoundsJob& Job = Jobs[Index];
+            Boxes[Index] = Job.Hull.IsValid() ? FMeshOps_TightBounds::TransformHullBox(*Job.Hull, Job.Transform) : Job.FallbackBox;
+        }
+    );
+
+    for (const FBox& Each_Box : Boxes)
+    {
+        Out_Box += Each_Box;
+    }
+
+    return Out_Box.IsValid != 0;
+}
+
+bool FMeshOps_TightBounds::GetOrientedBounds(USceneComponent* Target, FOrientedBoxStruct& Out_Box)
+{
+    using namespace MeshOps_TightBounds_Private;
+
+    Out_Box = FOrientedBoxStruct();
+
+    if (!IsValid(Target))
+    {
+        return false;
+    }
+
+    TArray<FTightBoundsJob> Jobs;
+    CollectJobs(Target, Jobs);
+
+    // Each job writes its points to its own range, so they can be transformed in parallel.
+    TArray<int32> Offsets;
+    Offsets.SetNumUninitialized(Jobs.Num() + 1);
+    Offsets[0] = 0;
+
+    for (int32 Index = 0; Index < Jobs.Num(); Index++)
+    {
+        Offsets[Index + 1] = Offsets[Index] + (Jobs[Index].Hull.IsValid() ? Jobs[Index].Hull->Points.Num() : 8);
+    }
+
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(Offsets.Last());
+
+    ParallelFor(Jobs.Num(), [&Jobs, &Offsets, &Points](int32 Index)
+        {
+            const FTightBoundsJob& Job = Jobs[Index];
+            FVector* Destination = Points.GetData() + Offsets[Index];
+
+            if (!Job.Hull.IsValid())
+            {
+                Job.FallbackBox.GetVertices(Destination);
+                return;
+            }
+
+            for (const FVector4f& Each_Point : Job.Hull->Points)
+            {
+                *Destination++ = Job.Transform.TransformPosition(FVector(Each_Point.X, Each_Point.Y, Each_Point.Z));
+            }
+        }
+    );
+
+    return FMeshOps_TightBounds::ComputeOrientedBox(Points, Out_Box);
+}
@@ -0,0 +1,94 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#include "MeshOps_GLTFReader.h"
+#include "MeshOps_GLTFWriter.h"
+#include "MeshOps_MeshBuilder.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMeshOps_GLTFInstancingRoundTripTest, "MeshOperations.GLTF.InstancingRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+// Exports sibling parts with EXT_mesh_gpu_instancing and imports the file again. Every instance has to come back as a mesh node.
+bool FMeshOps_GLTFInstancingRoundTripTest::RunTest(const FString& Parameters)
+{
+    FMeshOps_MeshBuffers Buffers;
+    Buffers.Positions = { FVector3f(0, 0, 0), FVector3f(0, 100, 0), FVector3f(100, 0, 0) };
+    Buffers.Normals = { FVector3f::UpVector, FVector3f::UpVector, FVector3f::UpVector };
+    Buffers.UVs = { FVector2f(0, 0), FVector2f(0, 1), FVector2f(1, 0) };
+    Buffers.Indices = { 0, 1, 2 };
+    Buffers.AddSingleSection();
+
+    UStaticMesh* StaticMesh = FMeshOps_MeshBuilder::BuildStaticMesh(MakeUniqueObjectName(GetTransientPackage(), UStaticMesh::StaticClass(), TEXT("RoundTrip_Triangle")), MakeArrayView(&Buffers, 1), TArrayView<UMaterialInterface* const>(), FMeshOps_MeshBuilder::ECollisionType::None, false);
+
+    if (!TestNotNull(TEXT("Test mesh is built"), StaticMesh))
+    {
+        return false;
+    }
+
+    const int32 NumInstances = 4;
+
+    FMeshOps_ExportScene Scene;
+    Scene.Meshes.AddDefaulted_GetRef().StaticMesh = StaticMesh;
+    Scene.Meshes[0].Name = TEXT("Triangle");
+
+    FMeshOps_ExportScene::FNode& Root = Scene.Nodes.AddDefaulted_GetRef();
+    Root.Name = TEXT("Root");
+    Scene.RootNodes.Add(0);
+
+    for (int32 Index = 0; Index < NumInstances; Index++)
+    {
+        FMeshOps_ExportScene::FNode& Part = Scene.Nodes.AddDefaulted_GetRef();
+        Part.Name = FString::Printf(TEXT("Part_%d"), Index);
+        Part.Parent = 0;
+        Part.Mesh = 0;
+        Part.Transform = FTransform(FVector(Index * 200.0, 0, 0));
+        Scene.Nodes[0].Children.Add(Scene.Nodes.Num() - 1);
+    }
+
+    FGLTFExportOptionsStruct Options;
+    Options.bUseGPUInstancing = true;
+
+    const FString ExportPath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("MeshOps_InstancingRoundTrip.glb"));
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(ExportPath), true);
+
+    FGLTFExportStatsStruct Stats;
+    FString Error;
+
+    const bool bIsWritten = FMeshOps_GLTFWriter::Write(Scene, Options, ExportPath, [](float Progress) { return true; }, Stats, Error);
+
+    if (!TestTrue(FString::Printf(TEXT("Instanced file is written. %s"), *Error), bIsWritten))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Parts are written as one instance group"), Stats.Num_Instance_Groups, 1);
+
+    FMeshOps_ImportScene Imported;
+    const bool bIsRead = FMeshOps_GLTFReader::Read(ExportPath, 100.f, Imported, Error);
+
+    IFileManager::Get().Delete(*ExportPath, false, false, true);
+
+    if (!TestTrue(FString::Printf(TEXT("Instanced file is imported. %s"), *Error), bIsRead))
+    {
+        return false;
+    }
+
+    int32 NumMeshNodes = 0;
+
+    for (const FMeshOps_ImportScene::FNode& Each_Node : Imported.Nodes)
+    {
+        NumMeshNodes += Each_Node.Mesh != INDEX_NONE ? 1 : 0;
+    }
+
+    TestEqual(TEXT("Every instance is imported as a mesh node"), NumMeshNodes, NumInstances);
+    TestEqual(TEXT("Shared mesh is imported once"), Imported.Meshes.Num(), 1);
+
+    return true;
+}
+
+#endif
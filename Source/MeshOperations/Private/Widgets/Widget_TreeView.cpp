@@ -1,5 +1,14 @@
 #include "Widgets/Widget_TreeView.h"
 
+#include "Algo/StableSort.h"
+#include "Async/Async.h"
+#include "Components/PrimitiveComponent.h"
+#include "Misc/Paths.h"
+
+#include "Widgets/Widget_TreeView_Stats.h"
+
+#include "MeshOperationsBPLibrary.h"
+
 void UWidget_TreeView::NativePreConstruct()
 {
 	Super::NativePreConstruct();
@@ -20,25 +29,62 @@ void UWidget_TreeView::NativeConstruct()
 	if (this->Hierarchy)
 	{
 		this->DataCache.Empty();
-		this->MatchingComponents.Empty();
+		this->Search_Matches.Empty();
+		this->Match_Ancestors.Empty();
 
 		this->Hierarchy->SetOnGetItemChildren(this, &UWidget_TreeView::HandleGetChildren);
+		this->Hierarchy->OnItemExpansionChanged().AddUObject(this, &UWidget_TreeView::HandleExpansionChanged);
+		this->Hierarchy->OnItemSelectionChanged().AddUObject(this, &UWidget_TreeView::HandleSelectionChanged);
 
+		this->Search_Box->OnTextChanged.AddDynamic(this, &UWidget_TreeView::On_Search_Changed);
 		this->Search_Box->OnTextCommitted.AddDynamic(this, &UWidget_TreeView::On_Search_Committed);
 		this->Search_Next->OnClicked.AddDynamic(this, &UWidget_TreeView::On_Search_Next);
 		this->Search_Previous->OnClicked.AddDynamic(this, &UWidget_TreeView::On_Search_Previous);
 		this->Search_Type->OnSelectionChanged.AddDynamic(this, &UWidget_TreeView::On_Search_Type_Changed);
 	}
+
+	this->Hierarchy_Changed_Handle = UMeshOperationsBPLibrary::OnHierarchyChanged.AddUObject(this, &UWidget_TreeView::HandleHierarchyChanged);
 }
 
 void UWidget_TreeView::NativeDestruct()
 {
+	// Running search tasks stop at their next chunk.
+	++(*this->Search_Generation);
+	this->bIsSearchPending = false;
+	++this->Outline_Request;
+	++this->Stats_Request;
+	this->bIsStatsDirty = false;
+
+	UMeshOperationsBPLibrary::OnHierarchyChanged.Remove(this->Hierarchy_Changed_Handle);
+	this->Hierarchy_Changed_Handle.Reset();
+
+	// Components outlive the widget, so their custom depth state is restored.
+	this->Selected_Entry = INDEX_NONE;
+	this->ClearViewportHighlights();
+
 	Super::NativeDestruct();
 }
 
 void UWidget_TreeView::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (this->bIsSearchPending && FPlatformTime::Seconds() >= this->Pending_Search_Time)
+	{
+		this->StartSearch(this->Pending_Search);
+	}
+
+	// Hierarchy can change many times in one frame, so stats are gathered once afterwards.
+	if (this->bIsStatsDirty && this->bComputeStats)
+	{
+		this->StartStats();
+	}
+
+	// Tree view rebuilds its item lists on its next tick, so rows evicted a frame ago aren't referenced anymore.
+	if (!this->Evicted_Data.IsEmpty() && GFrameCounter > this->Evicted_Frame + 1)
+	{
+		this->Evicted_Data.Reset();
+	}
 }
 
 TSharedRef<SWidget> UWidget_TreeView::RebuildWidget()
@@ -77,43 +123,397 @@ FString UWidget_TreeView::GetEnumDisplayName(EHierarchyNames In_Enum)
 	return EnumPtr->GetNameStringByValue((int64)In_Enum);
 }
 
-UTreeView_Data* UWidget_TreeView::GetOrCreateData(USceneComponent* InComponent, int32 InDepth)
+UTreeView_Data* UWidget_TreeView::GetOrCreateData(int32 Entry_Id)
 {
-	if (!IsValid(InComponent))
+	if (!this->SearchIndex->IsValidId(Entry_Id))
 	{
 		return nullptr;
 	}
 
-	if (UTreeView_Data** FoundData = DataCache.Find(InComponent))
+	if (UTreeView_Data** FoundData = this->DataCache.Find(Entry_Id))
 	{
-		(*FoundData)->Padding_Depth = InDepth;
 		return *FoundData;
 	}
 
+	const FTreeView_Index::FEntry& Entry = this->SearchIndex->GetEntry(Entry_Id);
+	USceneComponent* Component = Entry.Component.Get();
+
+	if (!IsValid(Component) && Entry.Outline == INDEX_NONE && Entry.Instance_Record == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FTreeView_Node& Node = this->Nodes[Entry_Id];
+
 	UTreeView_Data* NewData = NewObject<UTreeView_Data>(this);
-	NewData->Target_Component = InComponent;
-	NewData->Padding_Depth = InDepth;
+	NewData->Target_Component = Component;
+	NewData->Entry_Id = Entry_Id;
+	NewData->Padding_Depth = Entry.Depth;
+	NewData->bHasChildren = this->SearchIndex->HasChildren(Entry_Id);
+	NewData->bIsHighlighted = Node.bIsHighlighted;
+	NewData->bIsCurrentHighlight = Node.bIsCurrentHighlight;
 	NewData->NameType = UWidget_TreeView::GetEnumValueByName(this->Search_Type->GetSelectedOption());
+	NewData->Title = this->SearchIndex->GetDisplayName(Entry_Id, NewData->NameType);
 
-	DataCache.Add(InComponent, NewData);
+	if (this->Stats.IsValid() && this->Stats->IsValidId(Entry_Id))
+	{
+		NewData->bHasStats = true;
+		NewData->Stats = this->Stats->Get(Entry_Id);
+	}
+
+	this->DataCache.Add(Entry_Id, NewData);
 	return NewData;
 }
 
+void UWidget_TreeView::SetNodeHighlight(int32 Entry_Id, bool bIsHighlighted, bool bIsCurrentHighlight)
+{
+	if (!this->Nodes.IsValidIndex(Entry_Id))
+	{
+		return;
+	}
+
+	FTreeView_Node& Node = this->Nodes[Entry_Id];
+	Node.bIsHighlighted = bIsHighlighted;
+	Node.bIsCurrentHighlight = bIsCurrentHighlight;
+
+	if (UTreeView_Data* FoundData = this->DataCache.FindRef(Entry_Id))
+	{
+		FoundData->bIsHighlighted = bIsHighlighted;
+		FoundData->bIsCurrentHighlight = bIsCurrentHighlight;
+	}
+}
+
+void UWidget_TreeView::EvictSubtree(int32 Entry_Id)
+{
+	if (!this->SearchIndex->IsValidId(Entry_Id))
+	{
+		return;
+	}
+
+	// Cache only holds listed rows, so it is much smaller than the subtree of a big assembly. Selected row stays, because tree view keeps it in its selection.
+	for (TMap<int32, UTreeView_Data*>::TIterator Each_Pair = this->DataCache.CreateIterator(); Each_Pair; ++Each_Pair)
+	{
+		if (Each_Pair.Key() != Entry_Id && Each_Pair.Key() != this->Selected_Entry && this->SearchIndex->IsInSubtree(Each_Pair.Key(), Entry_Id))
+		{
+			this->Evicted_Data.Add(Each_Pair.Value());
+			Each_Pair.RemoveCurrent();
+		}
+	}
+
+	this->Evicted_Frame = GFrameCounter;
+}
+
+void UWidget_TreeView::EvictAllData()
+{
+	for (const TPair<int32, UTreeView_Data*>& Each_Pair : this->DataCache)
+	{
+		this->Evicted_Data.Add(Each_Pair.Value);
+	}
+
+	this->DataCache.Reset();
+	this->Evicted_Frame = GFrameCounter;
+}
+
+void UWidget_TreeView::HandleExpansionChanged(UObject* Item, bool bIsExpanded)
+{
+	if (bIsExpanded)
+	{
+		return;
+	}
+
+	if (UTreeView_Data* Collapsed_Data = Cast<UTreeView_Data>(Item))
+	{
+		this->EvictSubtree(Collapsed_Data->Entry_Id);
+	}
+}
+
+void UWidget_TreeView::HandleHierarchyChanged(USceneComponent* Changed_Parent)
+{
+	const int32 Parent_Entry = this->SearchIndex->Find(Changed_Parent);
+
+	if (Parent_Entry == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Parent itself is removed if its component is destroyed. Roots are items of tree view, so their rows are removed from it too.
+	const int32 Grand_Parent = this->SearchIndex->GetEntry(Parent_Entry).Parent;
+	const bool bIsRoot = Grand_Parent == INDEX_NONE;
+
+	TArray<int32> Removed_Entries;
+	TArray<int32> Added_Entries;
+	this->GetMutableIndex().SyncChildren(Parent_Entry, Removed_Entries, Added_Entries);
+
+	if (Removed_Entries.IsEmpty() && Added_Entries.IsEmpty())
+	{
+		return;
+	}
+
+	this->Nodes.SetNum(this->SearchIndex->Num());
+	this->Match_Covered.SetNum(this->SearchIndex->Num(), false);
+
+	bool bWasSelected = false;
+
+	for (const int32 Each_Removed : Removed_Entries)
+	{
+		UTreeView_Data* Removed_Data = nullptr;
+
+		if (this->DataCache.RemoveAndCopyValue(Each_Removed, Removed_Data))
+		{
+			if (bIsRoot && Each_Removed == Parent_Entry)
+			{
+				this->Hierarchy->RemoveItem(Removed_Data);
+			}
+
+			this->Evicted_Data.Add(Removed_Data);
+			this->Evicted_Frame = GFrameCounter;
+		}
+
+		this->RestoreStencil(Each_Removed);
+		this->Nodes[Each_Removed] = FTreeView_Node();
+		bWasSelected |= Each_Removed == this->Selected_Entry;
+	}
+
+	if (bWasSelected)
+	{
+		this->Hierarchy->ClearSelection();
+		this->SelectEntry(INDEX_NONE);
+	}
+
+	// Added branches get stencil of a covering match or selection.
+	if (this->bHighlightInViewport && this->SearchIndex->IsValidId(Parent_Entry) && !this->SearchIndex->GetEntry(Parent_Entry).bIsRemoved)
+	{
+		const bool bIsCovered = this->Match_Covered[Parent_Entry];
+
+		for (const int32 Each_Added : Added_Entries)
+		{
+			if (this->SearchIndex->GetEntry(Each_Added).Parent != Parent_Entry)
+			{
+				continue;
+			}
+
+			for (int32 Each_Id = Each_Added; bIsCovered && Each_Id != INDEX_NONE; Each_Id = this->SearchIndex->GetNextInSubtree(Each_Id, Each_Added))
+			{
+				this->Match_Covered[Each_Id] = true;
+			}
+
+			this->UpdateViewportStencil(Each_Added);
+		}
+	}
+
+	// Rows of other branches stay as they are. Tree view only asks children again if changed branch is listed.
+	if (this->DataCache.Contains(Parent_Entry) || this->DataCache.Contains(Grand_Parent))
+	{
+		this->Hierarchy->RequestRefresh();
+	}
+
+	this->bIsStatsDirty = true;
+
+	// Matches of removed entries are dropped and new entries are searched on next tick, so many changes in one frame search once.
+	// Running search is cancelled, so it releases its snapshot and next change doesn't have to copy the index.
+	const FString Query = this->Search_Box->GetText().ToString();
+
+	if (!Query.IsEmpty())
+	{
+		++(*this->Search_Generation);
+
+		if (!this->bIsSearchPending)
+		{
+			this->Pending_Search = Query;
+			this->Pending_Search_Time = FPlatformTime::Seconds();
+			this->bIsSearchPending = true;
+		}
+	}
+}
+
+void UWidget_TreeView::HandleSelectionChanged(UObject* Item)
+{
+	const UTreeView_Data* Selected_Data = Cast<UTreeView_Data>(Item);
+	this->SelectEntry(IsValid(Selected_Data) ? Selected_Data->Entry_Id : INDEX_NONE);
+}
+
+void UWidget_TreeView::SelectEntry(int32 Entry_Id)
+{
+	if (Entry_Id == this->Selected_Entry)
+	{
+		return;
+	}
+
+	const int32 Previous_Entry = this->Selected_Entry;
+	this->Selected_Entry = this->SearchIndex->IsValidId(Entry_Id) ? Entry_Id : INDEX_NONE;
+
+	if (this->SearchIndex->IsValidId(Previous_Entry))
+	{
+		this->UpdateViewportStencil(Previous_Entry);
+	}
+
+	if (this->Selected_Entry != INDEX_NONE)
+	{
+		this->UpdateViewportStencil(this->Selected_Entry);
+	}
+
+	this->OnComponentSelected.Broadcast(this->GetSelectedComponent());
+}
+
+UTreeView_Data* UWidget_TreeView::RevealEntry(int32 Entry_Id)
+{
+	if (!this->SearchIndex->IsValidId(Entry_Id))
+	{
+		return nullptr;
+	}
+
+	TArray<int32> Ancestors;
+	this->SearchIndex->GetAncestors(Entry_Id, Ancestors);
+
+	// Parents are expanded from the root, so each one has a row when its child is expanded.
+	for (int32 Ancestor_Index = Ancestors.Num() - 1; Ancestor_Index >= 0; Ancestor_Index--)
+	{
+		if (UTreeView_Data* Parent_Data = this->GetOrCreateData(Ancestors[Ancestor_Index]))
+		{
+			this->Hierarchy->SetItemExpansion(Parent_Data, true);
+		}
+	}
+
+	UTreeView_Data* Revealed_Data = this->GetOrCreateData(Entry_Id);
+
+	if (Revealed_Data)
+	{
+		this->Hierarchy->RequestScrollItemIntoView(Revealed_Data);
+	}
+
+	return Revealed_Data;
+}
+
+void UWidget_TreeView::HighlightMatchInViewport(int32 Entry_Id)
+{
+	// A match inside an already covered subtree doesn't change anything.
+	if (!this->bHighlightInViewport || !this->Match_Covered.IsValidIndex(Entry_Id) || this->Match_Covered[Entry_Id])
+	{
+		return;
+	}
+
+	for (int32 Each_Id = Entry_Id; Each_Id != INDEX_NONE; Each_Id = this->SearchIndex->GetNextInSubtree(Each_Id, Entry_Id))
+	{
+		this->Match_Covered[Each_Id] = true;
+	}
+
+	this->UpdateViewportStencil(Entry_Id);
+}
+
+void UWidget_TreeView::UpdateViewportStencil(int32 Subtree_Root)
+{
+	for (int32 Each_Id = Subtree_Root; Each_Id != INDEX_NONE; Each_Id = this->SearchIndex->GetNextInSubtree(Each_Id, Subtree_Root))
+	{
+		UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(this->SearchIndex->GetEntry(Each_Id).Component.Get());
+
+		if (!IsValid(Primitive))
+		{
+			continue;
+		}
+
+		int32 Stencil = INDEX_NONE;
+
+		if (this->bHighlightInViewport && this->SearchIndex->IsInSubtree(Each_Id, this->Selected_Entry))
+		{
+			Stencil = this->Selected_Stencil;
+		}
+
+		else if (this->bHighlightInViewport && this->Match_Covered.IsValidIndex(Each_Id) && this->Match_Covered[Each_Id])
+		{
+			Stencil = this->Match_Stencil;
+		}
+
+		if (Stencil == INDEX_NONE)
+		{
+			FTreeView_Stencil Backup;
+
+			if (this->Stencil_Backup.RemoveAndCopyValue(Each_Id, Backup))
+			{
+				Primitive->SetRenderCustomDepth(Backup.bRenderCustomDepth);
+				Primitive->SetCustomDepthStencilValue(Backup.Stencil);
+			}
+
+			continue;
+		}
+
+		if (!this->Stencil_Backup.Contains(Each_Id))
+		{
+			FTreeView_Stencil& Backup = this->Stencil_Backup.Add(Each_Id);
+			Backup.Primitive = Primitive;
+			Backup.bRenderCustomDepth = Primitive->bRenderCustomDepth;
+			Backup.Stencil = Primitive->CustomDepthStencilValue;
+		}
+
+		Primitive->SetRenderCustomDepth(true);
+		Primitive->SetCustomDepthStencilValue(Stencil);
+	}
+}
+
+void UWidget_TreeView::RestoreStencil(int32 Entry_Id)
+{
+	FTreeView_Stencil Backup;
+
+	if (!this->Stencil_Backup.RemoveAndCopyValue(Entry_Id, Backup))
+	{
+		return;
+	}
+
+	if (UPrimitiveComponent* Primitive = Backup.Primitive.Get())
+	{
+		Primitive->SetRenderCustomDepth(Backup.bRenderCustomDepth);
+		Primitive->SetCustomDepthStencilValue(Backup.Stencil);
+	}
+}
+
+void UWidget_TreeView::ClearViewportHighlights()
+{
+	this->Match_Covered.Init(false, this->SearchIndex->Num());
+
+	// Only highlighted primitives are visited. Selection keeps its stencil.
+	TArray<int32> Highlighted_Entries;
+	this->Stencil_Backup.GenerateKeyArray(Highlighted_Entries);
+
+	for (const int32 Each_Entry : Highlighted_Entries)
+	{
+		if (!this->SearchIndex->IsInSubtree(Each_Entry, this->Selected_Entry))
+		{
+			this->RestoreStencil(Each_Entry);
+		}
+	}
+}
+
 void UWidget_TreeView::HandleGetChildren(UObject* Item, TArray<UObject*>& OutChildren)
 {
 	UTreeView_Data* ParentData = Cast<UTreeView_Data>(Item);
 
-	if (!IsValid(ParentData) || !IsValid(ParentData->Target_Component))
+	if (!IsValid(ParentData))
 	{
 		return;
 	}
 
-	TArray<USceneComponent*> Children;
-	ParentData->Target_Component->GetChildrenComponents(false, Children);
+	TArray<int32, TInlineAllocator<64>> Children;
 
-	for (USceneComponent* Child : Children)
+	for (int32 Child = this->SearchIndex->GetFirstChild(ParentData->Entry_Id); Child != INDEX_NONE; Child = this->SearchIndex->GetNextSibling(Child))
 	{
-		if (UTreeView_Data* ChildData = this->GetOrCreateData(Child, ParentData->Padding_Depth + 1))
+		Children.Add(Child);
+	}
+
+	// Heaviest children come first. Stable sort keeps hierarchy order of equal ones.
+	if (this->Stats_Sort != ETreeViewStatsSort::None && this->Stats.IsValid())
+	{
+		const FTreeView_Stats& Current_Stats = *this->Stats;
+		const ETreeViewStatsSort Sort = this->Stats_Sort;
+
+		Algo::StableSort(Children, [&Current_Stats, Sort](int32 A, int32 B)
+			{
+				return Current_Stats.GetSortValue(A, Sort) > Current_Stats.GetSortValue(B, Sort);
+			});
+	}
+
+	// Children come from the snapshot, so rows are only created here when tree view actually lists them.
+	for (const int32 Child : Children)
+	{
+		if (UTreeView_Data* ChildData = this->GetOrCreateData(Child))
 		{
 			OutChildren.Add(ChildData);
 		}
@@ -122,13 +522,9 @@ void UWidget_TreeView::HandleGetChildren(UObject* Item, TArray<UObject*>& OutChi
 
 void UWidget_TreeView::ClearHighlights()
 {
-	TArray<UTreeView_Data*> Data_Items;
-	this->DataCache.GenerateValueArray(Data_Items);
-
-	for (UTreeView_Data* Each_Data : Data_Items)
+	for (const FTreeView_Match& Each_Match : this->Search_Matches)
 	{
-		Each_Data->bIsHighlighted = false;
-		Each_Data->bIsCurrentHighlight = false;
+		this->SetNodeHighlight(Each_Match.Entry, false, false);
 	}
 
 	this->SwitchHiglights();
@@ -169,232 +565,308 @@ void UWidget_TreeView::RefreshDisplayedTitles()
 
 void UWidget_TreeView::ClearSearchResults()
 {
-	this->MatchingComponents.Empty();
+	++(*this->Search_Generation);
+	this->bIsSearchPending = false;
+
 	this->ClearHighlights();
+	this->ClearViewportHighlights();
+	this->Search_Matches.Reset();
+	this->Match_Ancestors.Reset();
 	this->Current_Index = 0;
 	this->Max_Index = 0;
 	this->Title_Index->SetText(FText::FromString(TEXT("0 of 0")));
 }
 
-void UWidget_TreeView::On_Search_Committed(const FText& SearchText, ETextCommit::Type CommitMethod)
+FTreeView_Index& UWidget_TreeView::GetMutableIndex()
 {
-	if (CommitMethod != ETextCommit::OnEnter)
+	if (!this->SearchIndex.IsUnique())
 	{
-		return;
+		this->SearchIndex = MakeShared<FTreeView_Index, ESPMode::ThreadSafe>(*this->SearchIndex);
 	}
 
+	return *this->SearchIndex;
+}
+
+void UWidget_TreeView::StartSearch(const FString& Query)
+{
 	this->ClearSearchResults();
 
-	if (this->AssemblyRoots.IsEmpty())
+	if (this->SearchIndex->Num() == 0 || Query.IsEmpty())
 	{
 		return;
 	}
 
-	if (SearchText.IsEmpty())
+	FTreeView_Query Search_Query;
+	Search_Query.Text = Query;
+	Search_Query.NameType = UWidget_TreeView::GetEnumValueByName(this->Search_Type->GetSelectedOption());
+	Search_Query.Mode = this->Search_Mode;
+	Search_Query.Sort = this->Search_Sort;
+	Search_Query.bAnyField = this->bSearchAnyField;
+
+	const uint32 Generation = this->Search_Generation->load();
+
+	TSharedRef<const FTreeView_Index, ESPMode::ThreadSafe> Snapshot = this->SearchIndex;
+	TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> Latest_Generation = this->Search_Generation;
+	TWeakObjectPtr<UWidget_TreeView> WeakThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [Snapshot, Latest_Generation, WeakThis, Generation, Search_Query]()
+		{
+			Snapshot->Search(Search_Query, TREEVIEW_SEARCH_CHUNK, [&](TArrayView<const int32> Chunk)
+				{
+					if (Latest_Generation->load() != Generation)
+					{
+						return false;
+					}
+
+					if (!Chunk.IsEmpty())
+					{
+						AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Matches = TArray<int32>(Chunk.GetData(), Chunk.Num())]()
+							{
+								if (UWidget_TreeView* Widget = WeakThis.Get())
+								{
+									Widget->ReceiveSearchResults(Generation, Matches);
+								}
+							});
+					}
+
+					return true;
+				});
+		});
+}
+
+void UWidget_TreeView::ReceiveSearchResults(uint32 Generation, const TArray<int32>& Matches)
+{
+	if (Generation != this->Search_Generation->load())
 	{
 		return;
 	}
 
-	for (USceneComponent* Each_Root : this->AssemblyRoots)
+	// Index can only grow while generation is same, so entry ids of the snapshot are still valid here.
+	const bool bIsFirstChunk = this->Search_Matches.IsEmpty();
+	TArray<int32> Ancestors;
+
+	for (const int32 Each_Match : Matches)
 	{
-		if (!IsValid(Each_Root))
+		// Outline nodes and instance records have no component of their own, so only removed entries are skipped.
+		if (!this->SearchIndex->IsValidId(Each_Match) || this->SearchIndex->GetEntry(Each_Match).bIsRemoved)
 		{
 			continue;
 		}
 
-		TArray<USceneComponent*> AllComponents;
-		Each_Root->GetChildrenComponents(true, AllComponents);
+		this->SearchIndex->GetAncestors(Each_Match, Ancestors);
+		Algo::Reverse(Ancestors);
 
-		if (AllComponents.IsEmpty())
-		{
-			return;
-		}
-
-		const EHierarchyNames CurrentState = UWidget_TreeView::GetEnumValueByName(this->Search_Type->GetSelectedOption());
-		FString SearchTarget;
+		FTreeView_Match& New_Match = this->Search_Matches.AddDefaulted_GetRef();
+		New_Match.Entry = Each_Match;
+		New_Match.Ancestors_Start = this->Match_Ancestors.Num();
+		New_Match.Ancestors_Num = Ancestors.Num();
+		this->Match_Ancestors.Append(Ancestors);
 
-		for (USceneComponent* Component : AllComponents)
+		for (int32 Parent_Index = 0; Parent_Index < Ancestors.Num(); Parent_Index++)
 		{
-			switch (CurrentState)
+			if (UTreeView_Data* Parent_Data = this->GetOrCreateData(Ancestors[Parent_Index]))
 			{
-			case EHierarchyNames::Object:
-			{
-				SearchTarget = UMeshOperationsBPLibrary::GetObjectNameForPackage(Component);
-				break;
+				this->Hierarchy->SetItemExpansion(Parent_Data, true);
 			}
+		}
 
-			case EHierarchyNames::Product:
-			{
-				if (Component->ComponentTags.Num() > 0)
-				{
-					SearchTarget = Component->ComponentTags[0].ToString();
-				}
-
-				else
-				{
-					continue;
-				}
+		// Row of the match is created only when tree view lists it.
+		this->SetNodeHighlight(Each_Match, true, false);
+		this->HighlightMatchInViewport(Each_Match);
+	}
 
-				break;
-			}
+	this->Max_Index = this->Search_Matches.Num() - 1;
 
-			case EHierarchyNames::Instance:
-			{
-				if (Component->ComponentTags.Num() >= 2)
-				{
-					SearchTarget = Component->ComponentTags[1].ToString();
-				}
+	if (bIsFirstChunk && !this->Search_Matches.IsEmpty())
+	{
+		this->FocusMatch(0);
+	}
 
-				else
-				{
-					continue;
-				}
+	this->Hierarchy->RequestRefresh();
+	this->SwitchHiglights();
+	this->UpdateMatchCounter();
+}
 
-				break;
-			}
+UTreeView_Data* UWidget_TreeView::GetMatchData(int32 Match_Index)
+{
+	if (!this->Search_Matches.IsValidIndex(Match_Index))
+	{
+		return nullptr;
+	}
 
-			default:
-			{
-				return;
-			}
-			}
+	return this->GetOrCreateData(this->Search_Matches[Match_Index].Entry);
+}
 
-			if (SearchTarget.Contains(SearchText.ToString()))
-			{
-				TArray<USceneComponent*> Temp_Parents;
-				Component->GetParentComponents(Temp_Parents);
+void UWidget_TreeView::FocusMatch(int32 Match_Index)
+{
+	if (!this->Search_Matches.IsValidIndex(Match_Index))
+	{
+		return;
+	}
 
-				const int32 RootIdx = Temp_Parents.IndexOfByKey(Each_Root);
+	if (this->Search_Matches.IsValidIndex(this->Current_Index))
+	{
+		const int32 Previous_Entry = this->Search_Matches[this->Current_Index].Entry;
+		this->SetNodeHighlight(Previous_Entry, true, false);
+		this->ApplyRowHighlight(this->DataCache.FindRef(Previous_Entry));
+	}
 
-				if (RootIdx != INDEX_NONE)
-				{
-					Temp_Parents.SetNum(RootIdx + 1);
-				}
+	this->Current_Index = Match_Index;
+	const FTreeView_Match& Match = this->Search_Matches[Match_Index];
 
-				this->MatchingComponents.Add(Component, Temp_Parents);
-			}
-		}
+	// Expand current items parents.
 
-		bool bIsFirstReceived = false;
+	for (int32 Parent_Index = 0; Parent_Index < Match.Ancestors_Num; Parent_Index++)
+	{
+		const int32 Ancestor = this->Match_Ancestors[Match.Ancestors_Start + Parent_Index];
 
-		for (TPair<USceneComponent*, TArray<USceneComponent*>> Pair : this->MatchingComponents)
+		if (UTreeView_Data* Parent_Data = this->GetOrCreateData(Ancestor))
 		{
-			Algo::Reverse(Pair.Value);
-
-			for (int32 Parent_Index = 0; Parent_Index < Pair.Value.Num(); Parent_Index++)
-			{
-				UTreeView_Data* Parent_Data = this->GetOrCreateData(Pair.Value[Parent_Index], Parent_Index);
-				this->Hierarchy->SetItemExpansion(Parent_Data, true);
-			}
+			this->Hierarchy->SetItemExpansion(Parent_Data, true);
+		}
+	}
 
-			UTreeView_Data* Each_Matched = this->GetOrCreateData(Pair.Key, Pair.Value.Num());
-			Each_Matched->bIsHighlighted = true;
+	// Scroll current item into view.
 
-			if (!bIsFirstReceived)
-			{
-				Each_Matched->bIsCurrentHighlight = true;
-				this->Hierarchy->RequestScrollItemIntoView(Each_Matched);
-				bIsFirstReceived = true;
-			}
-		}
+	this->SetNodeHighlight(Match.Entry, true, true);
 
-		this->Hierarchy->RequestRefresh();
-		const int32 FoundNum = this->MatchingComponents.Num();
-		this->Max_Index = FoundNum - 1;
-		this->Title_Index->SetText(FText::FromString(FString::Printf(TEXT("%d of %d"), 1, FoundNum)));
+	if (UTreeView_Data* Current_Data = this->GetMatchData(Match_Index))
+	{
+		this->ApplyRowHighlight(Current_Data);
+		this->Hierarchy->RequestScrollItemIntoView(Current_Data);
+		this->Hierarchy->SetSelectedItem(Current_Data);
 	}
+
+	this->UpdateMatchCounter();
 }
 
-void UWidget_TreeView::On_Search_Next()
+void UWidget_TreeView::ApplyRowHighlight(UTreeView_Data* Data)
 {
-	if (this->MatchingComponents.IsEmpty())
+	if (!IsValid(Data))
 	{
 		return;
 	}
 
-	if (this->Current_Index < 0 || this->Current_Index >= this->Max_Index)
+	// Rows out of view don't have widgets. They get their color when they are generated.
+	if (UWidget_TreeView_Item* Item = Cast<UWidget_TreeView_Item>(this->Hierarchy->GetEntryWidgetFromItem(Data)))
 	{
-		this->Current_Index = 0;
+		Item->ApplyHighlightColor();
 	}
+}
 
-	else
+void UWidget_TreeView::UpdateMatchCounter()
+{
+	const int32 FoundNum = this->Search_Matches.Num();
+	this->Title_Index->SetText(FText::FromString(FString::Printf(TEXT("%d of %d"), FoundNum > 0 ? this->Current_Index + 1 : 0, FoundNum)));
+}
+
+bool UWidget_TreeView::JumpToMatch(int32 Match_Index)
+{
+	if (!this->Search_Matches.IsValidIndex(Match_Index))
 	{
-		this->Current_Index++;
+		return false;
 	}
 
-	const FString Index_String = FString::Printf(TEXT("%d of %d"), this->Current_Index + 1, this->Max_Index + 1);
-	this->Title_Index->SetText(FText::FromString(Index_String));
-
-	// Expand current items parents.
+	this->FocusMatch(Match_Index);
+	return true;
+}
 
-	TPair<USceneComponent*, TArray<USceneComponent*>> Current_Pair = this->MatchingComponents.Array()[this->Current_Index];
-	Algo::Reverse(Current_Pair.Value);
+int32 UWidget_TreeView::GetNumMatches() const
+{
+	return this->Search_Matches.Num();
+}
 
-	for (int32 Parent_Index = 0; Parent_Index < Current_Pair.Value.Num(); Parent_Index++)
+bool UWidget_TreeView::SelectComponent(USceneComponent* InComponent)
+{
+	if (!IsValid(InComponent) || !IsValid(this->Hierarchy))
 	{
-		UTreeView_Data* Parent_Data = this->GetOrCreateData(Current_Pair.Value[Parent_Index], Parent_Index);
-		this->Hierarchy->SetItemExpansion(Parent_Data, true);
+		return false;
 	}
 
-	for (TPair<USceneComponent*, TArray<USceneComponent*>> Each_Pair : this->MatchingComponents)
+	const int32 Entry_Id = this->SearchIndex->Find(InComponent);
+
+	// Viewport may call this again from OnComponentSelected.
+	if (Entry_Id == this->Selected_Entry && Entry_Id != INDEX_NONE)
 	{
-		UTreeView_Data* Each_Data = this->DataCache.FindRef(Each_Pair.Key);
-		Each_Data->bIsCurrentHighlight = false;
+		return true;
 	}
 
-	// Scroll current item into view.
+	UTreeView_Data* Selected_Data = this->RevealEntry(Entry_Id);
 
-	UTreeView_Data* Current_Data = this->DataCache.FindRef(Current_Pair.Key);
-	Current_Data->bIsCurrentHighlight = true;
-	this->Hierarchy->RequestScrollItemIntoView(Current_Data);
-	this->Hierarchy->RequestRefresh();
-	this->SwitchHiglights();
+	if (!Selected_Data)
+	{
+		return false;
+	}
+
+	this->Hierarchy->SetSelectedItem(Selected_Data);
+	return true;
 }
 
-void UWidget_TreeView::On_Search_Previous()
+bool UWidget_TreeView::RevealComponent(USceneComponent* InComponent)
 {
-	if (this->MatchingComponents.IsEmpty())
+	if (!IsValid(InComponent) || !IsValid(this->Hierarchy))
 	{
-		return;
+		return false;
 	}
 
-	if (this->Current_Index <= 0 || this->Current_Index > this->Max_Index)
-	{
-		this->Current_Index = this->Max_Index;
-	}
+	return this->RevealEntry(this->SearchIndex->Find(InComponent)) != nullptr;
+}
 
-	else
+USceneComponent* UWidget_TreeView::GetSelectedComponent() const
+{
+	return this->SearchIndex->IsValidId(this->Selected_Entry) ? this->SearchIndex->GetEntry(this->Selected_Entry).Component.Get() : nullptr;
+}
+
+void UWidget_TreeView::SetSearchOptions(ETreeViewSearchMode In_Mode, ETreeViewSearchSort In_Sort, bool bIn_AnyField)
+{
+	this->Search_Mode = In_Mode;
+	this->Search_Sort = In_Sort;
+	this->bSearchAnyField = bIn_AnyField;
+
+	if (IsValid(this->Search_Box))
 	{
-		this->Current_Index--;
+		this->StartSearch(this->Search_Box->GetText().ToString());
 	}
+}
 
-	const FString Index_String = FString::Printf(TEXT("%d of %d"), this->Current_Index + 1, this->Max_Index + 1);
-	this->Title_Index->SetText(FText::FromString(Index_String));
-
-	// Expand current items parents.
+void UWidget_TreeView::On_Search_Changed(const FText& SearchText)
+{
+	// Task of previous text stops now, new one starts after typing pauses.
+	++(*this->Search_Generation);
 
-	TPair<USceneComponent*, TArray<USceneComponent*>> Current_Pair = this->MatchingComponents.Array()[this->Current_Index];
-	Algo::Reverse(Current_Pair.Value);
+	this->Pending_Search = SearchText.ToString();
+	this->Pending_Search_Time = FPlatformTime::Seconds() + this->Search_Delay;
+	this->bIsSearchPending = true;
+}
 
-	for (int32 Parent_Index = 0; Parent_Index < Current_Pair.Value.Num(); Parent_Index++)
+void UWidget_TreeView::On_Search_Committed(const FText& SearchText, ETextCommit::Type CommitMethod)
+{
+	if (CommitMethod != ETextCommit::OnEnter)
 	{
-		UTreeView_Data* Parent_Data = this->GetOrCreateData(Current_Pair.Value[Parent_Index], Parent_Index);
-		this->Hierarchy->SetItemExpansion(Parent_Data, true);
+		return;
 	}
 
-	for (TPair<USceneComponent*, TArray<USceneComponent*>> Each_Pair : this->MatchingComponents)
+	this->StartSearch(SearchText.ToString());
+}
+
+void UWidget_TreeView::On_Search_Next()
+{
+	if (this->Search_Matches.IsEmpty())
 	{
-		UTreeView_Data* Each_Data = this->DataCache.FindRef(Each_Pair.Key);
-		Each_Data->bIsCurrentHighlight = false;
+		return;
 	}
 
-	// Scroll current item into view.
+	this->FocusMatch(this->Current_Index < 0 || this->Current_Index >= this->Max_Index ? 0 : this->Current_Index + 1);
+}
 
-	UTreeView_Data* Current_Data = this->DataCache.FindRef(Current_Pair.Key);
-	Current_Data->bIsCurrentHighlight = true;
-	this->Hierarchy->RequestScrollItemIntoView(Current_Data);
-	this->Hierarchy->RequestRefresh();
-	this->SwitchHiglights();
+void UWidget_TreeView::On_Search_Previous()
+{
+	if (this->Search_Matches.IsEmpty())
+	{
+		return;
+	}
+
+	this->FocusMatch(this->Current_Index <= 0 || this->Current_Index > this->Max_Index ? this->Max_Index : this->Current_Index - 1);
 }
 
 void UWidget_TreeView::On_Search_Type_Changed(FString SelectedItem, ESelectInfo::Type SelectionType)
@@ -439,14 +911,12 @@ void UWidget_TreeView::On_Search_Type_Changed(FString SelectedItem, ESelectInfo:
 		}
 	}
 
-	TArray<UTreeView_Data*> AllData;
-	this->DataCache.GenerateValueArray(AllData);
-
-	for (UTreeView_Data* Each_Data : AllData)
+	for (const TPair<int32, UTreeView_Data*>& Each_Pair : this->DataCache)
 	{
-		if (IsValid(Each_Data))
+		if (IsValid(Each_Pair.Value))
 		{
-			Each_Data->NameType = SelectedState;
+			Each_Pair.Value->NameType = SelectedState;
+			Each_Pair.Value->Title = this->SearchIndex->GetDisplayName(Each_Pair.Key, SelectedState);
 		}
 	}
 
@@ -477,12 +947,16 @@ bool UWidget_TreeView::AddItemToHierarchy(USceneComponent* InComponent)
 	else
 	{
 		this->AssemblyRoots.Add(InComponent);
+		const int32 RootId = this->GetMutableIndex().AddRoot(InComponent);
+		this->Nodes.SetNum(this->SearchIndex->Num());
+		this->Match_Covered.SetNum(this->SearchIndex->Num(), false);
 
-		if (UTreeView_Data* NewData = this->GetOrCreateData(InComponent, 0))
+		if (UTreeView_Data* NewData = this->GetOrCreateData(RootId))
 		{
 			this->Hierarchy->AddItem(NewData);
 		}
 
+		this->bIsStatsDirty = true;
 		this->Hierarchy->RequestRefresh();
 		return true;
 	}
@@ -500,8 +974,7 @@ bool UWidget_TreeView::Hierarchy_Generator(TArray<USceneComponent*> InComponents
 		return false;
 	}
 
-	this->Hierarchy->ClearListItems();
-
+	this->ResetSnapshot(MakeShared<FTreeView_Index, ESPMode::ThreadSafe>());
 	this->AssemblyRoots = InComponents;
 
 	for (USceneComponent* Each_Root : this->AssemblyRoots)
@@ -511,14 +984,221 @@ bool UWidget_TreeView::Hierarchy_Generator(TArray<USceneComponent*> InComponents
 			continue;
 		}
 
-		UTreeView_Data* EachRoot_Data = this->GetOrCreateData(Each_Root, 0);
-		this->Hierarchy->AddItem(EachRoot_Data);
+		const int32 RootId = this->SearchIndex->AddRoot(Each_Root);
+		this->Nodes.SetNum(this->SearchIndex->Num());
+		this->Match_Covered.SetNum(this->SearchIndex->Num(), false);
+
+		if (UTreeView_Data* EachRoot_Data = this->GetOrCreateData(RootId))
+		{
+			this->Hierarchy->AddItem(EachRoot_Data);
+		}
+	}
+
+	return true;
+}
+
+void UWidget_TreeView::ResetSnapshot(TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> New_Index)
+{
+	// Outline which is still loading would replace this snapshot.
+	++this->Outline_Request;
+
+	// Selection and highlights use entry ids of current snapshot, so they are cleared before it is replaced.
+	this->Hierarchy->ClearSelection();
+	this->SelectEntry(INDEX_NONE);
+	this->Hierarchy->ClearListItems();
+
+	this->ClearSearchResults();
+	this->AssemblyRoots.Reset();
+
+	// Old entry ids don't mean anything for the new hierarchy, so running tasks keep their own index.
+	this->SearchIndex = New_Index;
+	this->Stats.Reset();
+	++this->Stats_Request;
+	this->bIsStatsDirty = true;
+	this->Nodes.Reset();
+	this->Nodes.SetNum(this->SearchIndex->Num());
+	this->Match_Covered.Init(false, this->SearchIndex->Num());
+	this->EvictAllData();
+}
+
+bool UWidget_TreeView::OpenHierarchyOutline(const FString& File_Path)
+{
+	if (!IsValid(this->Hierarchy) || !FPaths::FileExists(File_Path))
+	{
+		return false;
+	}
+
+	const uint32 Request = ++this->Outline_Request;
+	TWeakObjectPtr<UWidget_TreeView> WeakThis(this);
+
+	// File is read and indexed on a worker, so game thread only swaps the snapshot. Rows are still created when tree view asks for them.
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Request, File_Path]()
+		{
+			TSharedRef<FMeshOps_HierarchyOutline, ESPMode::ThreadSafe> Outline = MakeShared<FMeshOps_HierarchyOutline, ESPMode::ThreadSafe>();
+
+			if (!Outline->Load(File_Path))
+			{
+				return;
+			}
+
+			TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> New_Index = MakeShared<FTreeView_Index, ESPMode::ThreadSafe>();
+			TArray<int32> Roots;
+			New_Index->AddOutline(Outline, Roots);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Request, New_Index, Roots = MoveTemp(Roots)]()
+				{
+					if (UWidget_TreeView* Widget = WeakThis.Get())
+					{
+						Widget->ReceiveOutline(Request, New_Index, Roots);
+					}
+				});
+		});
+
+	return true;
+}
+
+void UWidget_TreeView::ReceiveOutline(uint32 Request, TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> New_Index, const TArray<int32>& Roots)
+{
+	if (Request != this->Outline_Request || !IsValid(this->Hierarchy))
+	{
+		return;
+	}
+
+	this->ResetSnapshot(New_Index);
+
+	for (const int32 Each_Root : Roots)
+	{
+		if (UTreeView_Data* EachRoot_Data = this->GetOrCreateData(Each_Root))
+		{
+			this->Hierarchy->AddItem(EachRoot_Data);
+		}
+	}
+}
+
+bool UWidget_TreeView::GetSelectedOutlineNode(FString& Out_Name, TArray<FName>& Out_Tags, FBox& Out_Bounds, TSoftObjectPtr<UStaticMesh>& Out_Mesh) const
+{
+	const FMeshOps_HierarchyOutline::FNode* Node = this->SearchIndex->GetOutlineNode(this->Selected_Entry);
+
+	if (!Node)
+	{
+		return false;
+	}
+
+	const FMeshOps_HierarchyOutline* Outline = this->SearchIndex->GetOutline(this->Selected_Entry);
+
+	Out_Name = Node->Name;
+	Out_Tags = Node->Tags;
+	Out_Bounds = Node->Bounds;
+	Out_Mesh = Node->Mesh == INDEX_NONE ? TSoftObjectPtr<UStaticMesh>() : TSoftObjectPtr<UStaticMesh>(Outline->Meshes[Node->Mesh]);
+	return true;
+}
+
+void UWidget_TreeView::StartStats()
+{
+	this->bIsStatsDirty = false;
+
+	if (this->SearchIndex->Num() == 0)
+	{
+		return;
+	}
+
+	const uint32 Request = ++this->Stats_Request;
+
+	// Mesh costs need UObjects, so they are read here. Totals only need the snapshot.
+	TSharedRef<FTreeView_Stats, ESPMode::ThreadSafe> New_Stats = MakeShared<FTreeView_Stats, ESPMode::ThreadSafe>();
+	New_Stats->Gather(*this->SearchIndex);
+
+	TSharedRef<const FTreeView_Index, ESPMode::ThreadSafe> Snapshot = this->SearchIndex;
+	TWeakObjectPtr<UWidget_TreeView> WeakThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Request, New_Stats, Snapshot]()
+		{
+			New_Stats->Compute(*Snapshot);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Request, New_Stats]()
+				{
+					if (UWidget_TreeView* Widget = WeakThis.Get())
+					{
+						Widget->ReceiveStats(Request, New_Stats);
+					}
+				});
+		});
+}
+
+void UWidget_TreeView::ReceiveStats(uint32 Request, TSharedRef<FTreeView_Stats, ESPMode::ThreadSafe> New_Stats)
+{
+	if (Request != this->Stats_Request || !IsValid(this->Hierarchy))
+	{
+		return;
+	}
+
+	this->Stats = New_Stats;
+
+	for (const TPair<int32, UTreeView_Data*>& Each_Pair : this->DataCache)
+	{
+		if (IsValid(Each_Pair.Value) && New_Stats->IsValidId(Each_Pair.Key))
+		{
+			Each_Pair.Value->bHasStats = true;
+			Each_Pair.Value->Stats = New_Stats->Get(Each_Pair.Key);
+		}
+	}
+
+	for (UUserWidget* EntryWidget : this->Hierarchy->GetDisplayedEntryWidgets())
+	{
+		if (UWidget_TreeView_Item* Item = Cast<UWidget_TreeView_Item>(EntryWidget))
+		{
+			Item->UpdateStats();
+		}
+	}
+
+	if (this->Stats_Sort != ETreeViewStatsSort::None)
+	{
+		this->Hierarchy->RequestRefresh();
+	}
+}
+
+void UWidget_TreeView::SetStatsSort(ETreeViewStatsSort In_Sort)
+{
+	if (In_Sort == this->Stats_Sort)
+	{
+		return;
+	}
+
+	this->Stats_Sort = In_Sort;
+
+	if (IsValid(this->Hierarchy))
+	{
+		this->Hierarchy->RequestRefresh();
+	}
+}
+
+bool UWidget_TreeView::GetSubtreeStats(USceneComponent* InComponent, FTreeViewStatsStruct& Out_Stats) const
+{
+	const int32 Entry_Id = this->SearchIndex->Find(InComponent);
+
+	if (!this->Stats.IsValid() || !this->Stats->IsValidId(Entry_Id))
+	{
+		Out_Stats = FTreeViewStatsStruct();
+		return false;
+	}
+
+	Out_Stats = this->Stats->Get(Entry_Id);
+	return true;
+}
+
+bool UWidget_TreeView::GetSelectedStats(FTreeViewStatsStruct& Out_Stats) const
+{
+	if (!this->Stats.IsValid() || !this->Stats->IsValidId(this->Selected_Entry))
+	{
+		Out_Stats = FTreeViewStatsStruct();
+		return false;
 	}
 
+	Out_Stats = this->Stats->Get(this->Selected_Entry);
 	return true;
 }
 
 bool UWidget_TreeView::IsHierarchyEmpty() const
 {
-	return this->AssemblyRoots.IsEmpty();
+	return this->SearchIndex->Num() == 0;
 }
\ No newline at end of file
@@ -0,0 +1,844 @@
+#include "Widgets/Widget_TreeView_Index.h"
+
+#include "Algo/StableSort.h"
+#include "Internationalization/Regex.h"
+
+#include "MeshOperationsBPLibrary.h"
+#include "MeshOps_InstancedMeshComponent.h"
+
+namespace TreeView_Index_Private
+{
+	// 21 bits are enough for every code point, so three characters fit to one key on every platform.
+	static uint64 MakeTrigram(const TCHAR* Characters)
+	{
+		return ((uint64)(Characters[0] & 0x1FFFFF) << 42) | ((uint64)(Characters[1] & 0x1FFFFF) << 21) | (uint64)(Characters[2] & 0x1FFFFF);
+	}
+
+	// Both arrays are sorted. Result is written to the first one.
+	static void Intersect(TArray<int32>& InOut_Ids, const TArray<int32>& Other)
+	{
+		int32 Write = 0;
+		int32 Other_Index = 0;
+
+		for (int32 Read = 0; Read < InOut_Ids.Num() && Other_Index < Other.Num(); Read++)
+		{
+			while (Other_Index < Other.Num() && Other[Other_Index] < InOut_Ids[Read])
+			{
+				Other_Index++;
+			}
+
+			if (Other_Index < Other.Num() && Other[Other_Index] == InOut_Ids[Read])
+			{
+				InOut_Ids[Write++] = InOut_Ids[Read];
+			}
+		}
+
+		InOut_Ids.SetNum(Write);
+	}
+
+	static bool IsWordChar(TCHAR Character)
+	{
+		return FChar::IsAlnum(Character);
+	}
+
+	// Longer coverage of the name and matches at the beginning rank higher. Exact names get the highest rank.
+	static int32 RankSpan(const FString& Name, int32 Position, int32 Length)
+	{
+		return 1 + (Length * 100) / FMath::Max(Name.Len(), 1) + (Position == 0 ? 50 : 0);
+	}
+
+	static int32 MatchWholeWord(const FString& Name, const FString& Needle)
+	{
+		for (int32 Position = Name.Find(Needle, ESearchCase::CaseSensitive); Position != INDEX_NONE; Position = Name.Find(Needle, ESearchCase::CaseSensitive, ESearchDir::FromStart, Position + 1))
+		{
+			const int32 End = Position + Needle.Len();
+			const bool bIsWordStart = Position == 0 || !IsWordChar(Name[Position - 1]);
+			const bool bIsWordEnd = End == Name.Len() || !IsWordChar(Name[End]);
+
+			if (bIsWordStart && bIsWordEnd)
+			{
+				return RankSpan(Name, Position, Needle.Len());
+			}
+		}
+
+		return 0;
+	}
+
+	// Every character of needle has to appear in order. Consecutive characters and word starts are rewarded, gaps and long names are penalized.
+	static int32 MatchFuzzy(const FString& Name, const FString& Needle)
+	{
+		int32 Score = 0;
+		int32 NameIndex = 0;
+		int32 Previous = INDEX_NONE;
+
+		for (const TCHAR Each_Char : Needle)
+		{
+			while (NameIndex < Name.Len() && Name[NameIndex] != Each_Char)
+			{
+				NameIndex++;
+			}
+
+			if (NameIndex == Name.Len())
+			{
+				return 0;
+			}
+
+			Score += 10;
+
+			if (Previous != INDEX_NONE)
+			{
+				Score += NameIndex == Previous + 1 ? 15 : -FMath::Min(NameIndex - Previous - 1, 10);
+			}
+
+			if (NameIndex == 0 || !IsWordChar(Name[NameIndex - 1]))
+			{
+				Score += 10;
+			}
+
+			Previous = NameIndex;
+			NameIndex++;
+		}
+
+		return FMath::Max(Score - (Name.Len() - Needle.Len()) / 4, 1);
+	}
+
+	// Returns rank of the name or 0 if it doesn't match. Names are lower case. Needle is lower case for every mode except regex, which is case insensitive itself.
+	static int32 MatchName(const FString& Name, const FString& Needle, ETreeViewSearchMode Mode, const FRegexPattern* Pattern, int32 LiteralLength)
+	{
+		switch (Mode)
+		{
+			case ETreeViewSearchMode::WholeWord:
+			{
+				return MatchWholeWord(Name, Needle);
+			}
+
+			case ETreeViewSearchMode::Wildcard:
+			{
+				return Name.MatchesWildcard(Needle, ESearchCase::CaseSensitive) ? RankSpan(Name, Needle[0] == TEXT('*') ? INDEX_NONE : 0, LiteralLength) : 0;
+			}
+
+			case ETreeViewSearchMode::Regex:
+			{
+				FRegexMatcher Matcher(*Pattern, Name);
+				return Matcher.FindNext() ? RankSpan(Name, Matcher.GetMatchBeginning(), Matcher.GetMatchEnding() - Matcher.GetMatchBeginning()) : 0;
+			}
+
+			case ETreeViewSearchMode::Fuzzy:
+			{
+				return MatchFuzzy(Name, Needle);
+			}
+
+			default:
+			{
+				const int32 Position = Name.Find(Needle, ESearchCase::CaseSensitive);
+				return Position == INDEX_NONE ? 0 : RankSpan(Name, Position, Needle.Len());
+			}
+		}
+	}
+
+	static FString GetName(USceneComponent* Component, int32 TypeIndex)
+	{
+		switch (TypeIndex)
+		{
+			case 0:
+			{
+				return UMeshOperationsBPLibrary::GetObjectNameForPackage(Component);
+			}
+
+			case 1:
+			{
+				return Component->ComponentTags.Num() > 0 ? Component->ComponentTags[0].ToString() : FString();
+			}
+
+			default:
+			{
+				return Component->ComponentTags.Num() > 1 ? Component->ComponentTags[1].ToString() : FString();
+			}
+		}
+	}
+
+	// Tags without field name are shown with unnamed titles like tree view items did. All unnamed entries share one text.
+	static FText MakeDisplayName(const FString& Name, int32 TypeIndex)
+	{
+		static const FText Unnamed_Product = FText::FromString(UNNAMED_PRODUCT);
+		static const FText Unnamed_Instance = FText::FromString(UNNAMED_INSTANCE);
+
+		switch (TypeIndex)
+		{
+			case 0:
+			{
+				return FText::FromString(Name);
+			}
+
+			case 1:
+			{
+				return Name.Contains(FIELD_PRODUCT) ? FText::FromString(Name) : Unnamed_Product;
+			}
+
+			default:
+			{
+				return Name.Contains(FIELD_INSTANCE) ? FText::FromString(Name) : Unnamed_Instance;
+			}
+		}
+	}
+}
+
+const FText& FTreeView_Index::GetDisplayName(int32 EntryId, EHierarchyNames NameType) const
+{
+	const int32 TypeIndex = FTreeView_Index::GetTypeIndex(NameType);
+	return this->DisplayNames[TypeIndex == INDEX_NONE ? 0 : TypeIndex][EntryId];
+}
+
+int32 FTreeView_Index::GetTypeIndex(EHierarchyNames NameType)
+{
+	switch (NameType)
+	{
+		case EHierarchyNames::Object:
+			return 0;
+
+		case EHierarchyNames::Product:
+			return 1;
+
+		case EHierarchyNames::Instance:
+			return 2;
+
+		default:
+			return INDEX_NONE;
+	}
+}
+
+void FTreeView_Index::Reset()
+{
+	this->Entries.Reset();
+	this->ComponentToEntry.Reset();
+	this->Outlines.Reset();
+
+	for (int32 TypeIndex = 0; TypeIndex < TREEVIEW_NUM_NAME_TYPES; TypeIndex++)
+	{
+		this->Names[TypeIndex].Reset();
+		this->DisplayNames[TypeIndex].Reset();
+		this->Trigrams[TypeIndex].Reset();
+	}
+}
+
+int32 FTreeView_Index::AddEntry(USceneComponent* Component, int32 Parent, int32 Depth)
+{
+	using namespace TreeView_Index_Private;
+
+	const int32 EntryId = this->Entries.Num();
+
+	FEntry& NewEntry = this->Entries.AddDefaulted_GetRef();
+	NewEntry.Component = Component;
+	NewEntry.Parent = Parent;
+	NewEntry.Depth = Depth;
+
+	if (Parent != INDEX_NONE)
+	{
+		FEntry& ParentEntry = this->Entries[Parent];
+
+		if (ParentEntry.LastChild == INDEX_NONE)
+		{
+			ParentEntry.FirstChild = EntryId;
+		}
+
+		else
+		{
+			this->Entries[ParentEntry.LastChild].NextSibling = EntryId;
+		}
+
+		ParentEntry.LastChild = EntryId;
+	}
+
+	if (Component)
+	{
+		this->ComponentToEntry.Add(Component, EntryId);
+
+		for (int32 TypeIndex = 0; TypeIndex < TREEVIEW_NUM_NAME_TYPES; TypeIndex++)
+		{
+			this->AddName(EntryId, TypeIndex, GetName(Component, TypeIndex));
+		}
+	}
+
+	return EntryId;
+}
+
+void FTreeView_Index::AddName(int32 EntryId, int32 TypeIndex, FString Raw_Name)
+{
+	using namespace TreeView_Index_Private;
+
+	this->DisplayNames[TypeIndex].Add(MakeDisplayName(Raw_Name, TypeIndex));
+
+	Raw_Name.ToLowerInline();
+	FString& Name = this->Names[TypeIndex].Add_GetRef(MoveTemp(Raw_Name));
+
+	for (int32 CharIndex = 0; CharIndex + 3 <= Name.Len(); CharIndex++)
+	{
+		TArray<int32>& Posting = this->Trigrams[TypeIndex].FindOrAdd(MakeTrigram(*Name + CharIndex));
+
+		// Same trigram can repeat in one name. Ids only grow, so checking the last one is enough.
+		if (Posting.IsEmpty() || Posting.Last() != EntryId)
+		{
+			Posting.Add(EntryId);
+		}
+	}
+}
+
+void FTreeView_Index::AddOutline(const TSharedRef<const FMeshOps_HierarchyOutline, ESPMode::ThreadSafe>& Outline, TArray<int32>& Out_Roots)
+{
+	const int32 OutlineIndex = this->Outlines.Add(Outline);
+	const int32 FirstId = this->Entries.Num();
+
+	// Outline nodes are already in depth first order with parents first, so node index only needs an offset.
+	for (int32 NodeIndex = 0; NodeIndex < Outline->Nodes.Num(); NodeIndex++)
+	{
+		const FMeshOps_HierarchyOutline::FNode& Node = Outline->Nodes[NodeIndex];
+		const int32 Parent = Node.Parent == INDEX_NONE ? INDEX_NONE : FirstId + Node.Parent;
+		const int32 Depth = Parent == INDEX_NONE ? 0 : this->Entries[Parent].Depth + 1;
+
+		const int32 EntryId = this->AddEntry(nullptr, Parent, Depth);
+		this->Entries[EntryId].Outline = OutlineIndex;
+		this->Entries[EntryId].Outline_Node = NodeIndex;
+
+		this->AddName(EntryId, 0, Node.Name);
+		this->AddName(EntryId, 1, Node.Tags.Num() > 0 ? Node.Tags[0].ToString() : FString());
+		this->AddName(EntryId, 2, Node.Tags.Num() > 1 ? Node.Tags[1].ToString() : FString());
+
+		if (Parent == INDEX_NONE)
+		{
+			Out_Roots.Add(EntryId);
+		}
+	}
+}
+
+void FTreeView_Index::AddInstanceRecords(int32 EntryId, const UMeshOps_InstancedMeshComponent* Instanced)
+{
+	const int32 Depth = this->Entries[EntryId].Depth + 1;
+
+	for (int32 RecordIndex = 0; RecordIndex < Instanced->Instance_Records.Num(); RecordIndex++)
+	{
+		const FMeshInstanceRecordStruct& Record = Instanced->Instance_Records[RecordIndex];
+
+		const int32 RecordId = this->AddEntry(nullptr, EntryId, Depth);
+		this->Entries[RecordId].Instance_Record = RecordIndex;
+
+		this->AddName(RecordId, 0, Record.Source_Name);
+		this->AddName(RecordId, 1, Record.Tags.Num() > 0 ? Record.Tags[0].ToString() : FString());
+		this->AddName(RecordId, 2, Record.Tags.Num() > 1 ? Record.Tags[1].ToString() : FString());
+	}
+}
+
+const FMeshOps_HierarchyOutline::FNode* FTreeView_Index::GetOutlineNode(int32 EntryId) const
+{
+	if (!this->Entries.IsValidIndex(EntryId) || this->Entries[EntryId].Outline == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FEntry& Entry = this->Entries[EntryId];
+	return &this->Outlines[Entry.Outline]->Nodes[Entry.Outline_Node];
+}
+
+const FMeshOps_HierarchyOutline* FTreeView_Index::GetOutline(int32 EntryId) const
+{
+	if (!this->Entries.IsValidIndex(EntryId) || this->Entries[EntryId].Outline == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &this->Outlines[this->Entries[EntryId].Outline].Get();
+}
+
+int32 FTreeView_Index::AddRoot(USceneComponent* Root)
+{
+	if (!IsValid(Root))
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* Found = this->ComponentToEntry.Find(Root))
+	{
+		return *Found;
+	}
+
+	return this->AddSubtree(Root, INDEX_NONE);
+}
+
+int32 FTreeView_Index::AddSubtree(USceneComponent* Component, int32 Parent)
+{
+	const int32 SubtreeId = this->Entries.Num();
+
+	// Component and its parent id. Children are pushed in reverse, so they are popped in attachment order and ids follow pre-order.
+	TArray<TPair<USceneComponent*, int32>> Stack;
+	TArray<USceneComponent*> Children;
+
+	Stack.Add(TPair<USceneComponent*, int32>(Component, Parent));
+
+	while (!Stack.IsEmpty())
+	{
+		const TPair<USceneComponent*, int32> Current = Stack.Pop();
+
+		if (this->ComponentToEntry.Contains(Current.Key))
+		{
+			continue;
+		}
+
+		const int32 Depth = Current.Value == INDEX_NONE ? 0 : this->Entries[Current.Value].Depth + 1;
+		const int32 EntryId = this->AddEntry(Current.Key, Current.Value, Depth);
+
+		// Records are added before attached children, so ids still follow pre-order.
+		if (const UMeshOps_InstancedMeshComponent* Instanced = Cast<UMeshOps_InstancedMeshComponent>(Current.Key))
+		{
+			this->AddInstanceRecords(EntryId, Instanced);
+		}
+
+		Children.Reset();
+		Current.Key->GetChildrenComponents(false, Children);
+
+		for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; ChildIndex--)
+		{
+			if (IsValid(Children[ChildIndex]))
+			{
+				Stack.Add(TPair<USceneComponent*, int32>(Children[ChildIndex], EntryId));
+			}
+		}
+	}
+
+	return SubtreeId;
+}
+
+void FTreeView_Index::SyncChildren(int32 EntryId, TArray<int32>& Out_Removed, TArray<int32>& Out_Added)
+{
+	if (!this->Entries.IsValidIndex(EntryId) || this->Entries[EntryId].bIsRemoved)
+	{
+		return;
+	}
+
+	const USceneComponent* Parent_Component = this->Entries[EntryId].Component.Get();
+
+	if (!IsValid(Parent_Component))
+	{
+		this->RemoveSubtree(EntryId, Out_Removed);
+		return;
+	}
+
+	// Records of instanced components are rebuilt if their count changed, because records follow instance indices.
+	const UMeshOps_InstancedMeshComponent* Instanced = Cast<UMeshOps_InstancedMeshComponent>(Parent_Component);
+	int32 NumIndexedRecords = 0;
+
+	for (int32 Child = this->Entries[EntryId].FirstChild; Child != INDEX_NONE; Child = this->Entries[Child].NextSibling)
+	{
+		NumIndexedRecords += this->Entries[Child].Instance_Record != INDEX_NONE ? 1 : 0;
+	}
+
+	const bool bRecordsChanged = NumIndexedRecords != (Instanced ? Instanced->Instance_Records.Num() : 0);
+
+	// Children which are destroyed or attached to another parent.
+	TArray<int32> Stale_Children;
+
+	for (int32 Child = this->Entries[EntryId].FirstChild; Child != INDEX_NONE; Child = this->Entries[Child].NextSibling)
+	{
+		if (this->Entries[Child].Instance_Record != INDEX_NONE)
+		{
+			if (bRecordsChanged)
+			{
+				Stale_Children.Add(Child);
+			}
+
+			continue;
+		}
+
+		const USceneComponent* Child_Component = this->Entries[Child].Component.Get();
+
+		if (!IsValid(Child_Component) || Child_Component->GetAttachParent() != Parent_Component)
+		{
+			Stale_Children.Add(Child);
+		}
+	}
+
+	for (const int32 Each_Stale : Stale_Children)
+	{
+		this->RemoveSubtree(Each_Stale, Out_Removed);
+	}
+
+	if (bRecordsChanged && Instanced)
+	{
+		const int32 First_Added = this->Entries.Num();
+		this->AddInstanceRecords(EntryId, Instanced);
+
+		for (int32 Added_Id = First_Added; Added_Id < this->Entries.Num(); Added_Id++)
+		{
+			Out_Added.Add(Added_Id);
+		}
+	}
+
+	for (USceneComponent* Each_Child : Parent_Component->GetAttachChildren())
+	{
+		if (!IsValid(Each_Child))
+		{
+			continue;
+		}
+
+		const int32 Existing = this->Find(Each_Child);
+
+		if (Existing != INDEX_NONE && this->Entries[Existing].Parent == EntryId)
+		{
+			continue;
+		}
+
+		// Branch is moved from another parent. Old entries are removed, so a component never has two entries.
+		if (Existing != INDEX_NONE)
+		{
+			this->RemoveSubtree(Existing, Out_Removed);
+		}
+
+		const int32 First_Added = this->Entries.Num();
+		this->AddSubtree(Each_Child, EntryId);
+
+		for (int32 Added_Id = First_Added; Added_Id < this->Entries.Num(); Added_Id++)
+		{
+			Out_Added.Add(Added_Id);
+		}
+	}
+}
+
+void FTreeView_Index::RemoveSubtree(int32 EntryId, TArray<int32>& Out_Removed)
+{
+	if (!this->Entries.IsValidIndex(EntryId) || this->Entries[EntryId].bIsRemoved)
+	{
+		return;
+	}
+
+	const int32 First_Removed = Out_Removed.Num();
+
+	for (int32 Each_Id = EntryId; Each_Id != INDEX_NONE; Each_Id = this->GetNextInSubtree(Each_Id, EntryId))
+	{
+		Out_Removed.Add(Each_Id);
+	}
+
+	const int32 Parent = this->Entries[EntryId].Parent;
+
+	if (Parent != INDEX_NONE)
+	{
+		int32 Previous = INDEX_NONE;
+
+		for (int32 Child = this->Entries[Parent].FirstChild; Child != EntryId; Child = this->Entries[Child].NextSibling)
+		{
+			Previous = Child;
+		}
+
+		const int32 Next = this->Entries[EntryId].NextSibling;
+		FEntry& ParentEntry = this->Entries[Parent];
+
+		if (Previous == INDEX_NONE)
+		{
+			ParentEntry.FirstChild = Next;
+		}
+
+		else
+		{
+			this->Entries[Previous].NextSibling = Next;
+		}
+
+		if (ParentEntry.LastChild == EntryId)
+		{
+			ParentEntry.LastChild = Previous;
+		}
+	}
+
+	// Posting lists keep removed ids. Search skips them and their names are released.
+	for (int32 RemovedIndex = First_Removed; RemovedIndex < Out_Removed.Num(); RemovedIndex++)
+	{
+		const int32 Removed_Id = Out_Removed[RemovedIndex];
+		FEntry& Entry = this->Entries[Removed_Id];
+
+		const int32* Mapped = this->ComponentToEntry.Find(Entry.Component);
+
+		if (Mapped && *Mapped == Removed_Id)
+		{
+			this->ComponentToEntry.Remove(Entry.Component);
+		}
+
+		for (int32 TypeIndex = 0; TypeIndex < TREEVIEW_NUM_NAME_TYPES; TypeIndex++)
+		{
+			this->Names[TypeIndex][Removed_Id].Empty();
+			this->DisplayNames[TypeIndex][Removed_Id] = FText::GetEmpty();
+		}
+
+		Entry.Component.Reset();
+		Entry.Parent = INDEX_NONE;
+		Entry.FirstChild = INDEX_NONE;
+		Entry.LastChild = INDEX_NONE;
+		Entry.NextSibling = INDEX_NONE;
+		Entry.bIsRemoved = true;
+	}
+}
+
+bool FTreeView_Index::GatherCandidates(int32 TypeIndex, const TArray<FString>& Literals, TArray<int32>& Out_Candidates) const
+{
+	using namespace TreeView_Index_Private;
+
+	Out_Candidates.Reset();
+	TArray<const TArray<int32>*> Postings;
+
+	for (const FString& Each_Literal : Literals)
+	{
+		for (int32 CharIndex = 0; CharIndex + 3 <= Each_Literal.Len(); CharIndex++)
+		{
+			const TArray<int32>* Posting = this->Trigrams[TypeIndex].Find(MakeTrigram(*Each_Literal + CharIndex));
+
+			// Nothing can match, so candidate list stays empty.
+			if (!Posting)
+			{
+				return true;
+			}
+
+			Postings.AddUnique(Posting);
+		}
+	}
+
+	// Short literals have no trigram. Scanning plain strings is still much cheaper than walking components.
+	if (Postings.IsEmpty())
+	{
+		return false;
+	}
+
+	// Starting from the shortest list keeps intersections small.
+	Postings.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+
+	Out_Candidates = *Postings[0];
+
+	for (int32 PostingIndex = 1; PostingIndex < Postings.Num() && !Out_Candidates.IsEmpty(); PostingIndex++)
+	{
+		Intersect(Out_Candidates, *Postings[PostingIndex]);
+	}
+
+	return true;
+}
+
+void FTreeView_Index::Search(const FTreeView_Query& Query, TArray<int32>& Out_Matches) const
+{
+	Out_Matches.Reset();
+
+	this->Search(Query, MAX_int32, [&Out_Matches](TArrayView<const int32> Chunk)
+		{
+			Out_Matches.Append(Chunk.GetData(), Chunk.Num());
+			return true;
+		});
+}
+
+void FTreeView_Index::Search(const FTreeView_Query& Query, int32 ChunkSize, TFunctionRef<bool(TArrayView<const int32>)> OnChunk) const
+{
+	using namespace TreeView_Index_Private;
+
+	const ETreeViewSearchMode Mode = Query.Mode;
+	const FString Needle = Mode == ETreeViewSearchMode::Regex ? Query.Text : Query.Text.ToLower();
+	const int32 QueryTypeIndex = FTreeView_Index::GetTypeIndex(Query.NameType);
+
+	if (Needle.IsEmpty() || (!Query.bAnyField && QueryTypeIndex == INDEX_NONE))
+	{
+		return;
+	}
+
+	// Trigrams can only filter literal parts of the query. Regex and fuzzy matches can skip characters, so they scan every name.
+	TArray<FString> Literals;
+	int32 LiteralLength = 0;
+
+	switch (Mode)
+	{
+		case ETreeViewSearchMode::Contains:
+		case ETreeViewSearchMode::WholeWord:
+		{
+			Literals.Add(Needle);
+			break;
+		}
+
+		case ETreeViewSearchMode::Wildcard:
+		{
+			Needle.Replace(TEXT("?"), TEXT("*")).ParseIntoArray(Literals, TEXT("*"));
+
+			for (const FString& Each_Literal : Literals)
+			{
+				LiteralLength += Each_Literal.Len();
+			}
+
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+
+	TOptional<FRegexPattern> Pattern;
+
+	if (Mode == ETreeViewSearchMode::Regex)
+	{
+		Pattern.Emplace(Needle, ERegexPatternFlags::CaseInsensitive);
+	}
+
+	// Ranks of every entry are only needed when results are merged or sorted.
+	const bool bIsStreamed = !Query.bAnyField && Query.Sort == ETreeViewSearchSort::Hierarchy;
+	TArray<int32> Ranks;
+
+	if (!bIsStreamed)
+	{
+		Ranks.SetNumZeroed(this->Entries.Num());
+	}
+
+	ChunkSize = FMath::Max(ChunkSize, 1);
+
+	TArray<int32> Chunk;
+	TArray<int32> Candidates;
+	int32 NumVerified = 0;
+
+	for (int32 TypeIndex = 0; TypeIndex < TREEVIEW_NUM_NAME_TYPES; TypeIndex++)
+	{
+		if (!Query.bAnyField && TypeIndex != QueryTypeIndex)
+		{
+			continue;
+		}
+
+		const TArray<FString>& TypeNames = this->Names[TypeIndex];
+		const bool bUseCandidates = this->GatherCandidates(TypeIndex, Literals, Candidates);
+		const int32 NumCandidates = bUseCandidates ? Candidates.Num() : TypeNames.Num();
+
+		for (int32 CandidateIndex = 0; CandidateIndex < NumCandidates; CandidateIndex++)
+		{
+			const int32 EntryId = bUseCandidates ? Candidates[CandidateIndex] : CandidateIndex;
+			const int32 Rank = this->Entries[EntryId].bIsRemoved ? 0 : MatchName(TypeNames[EntryId], Needle, Mode, Pattern.GetPtrOrNull(), LiteralLength);
+
+			if (Rank > 0)
+			{
+				if (bIsStreamed)
+				{
+					Chunk.Add(EntryId);
+				}
+
+				else
+				{
+					Ranks[EntryId] = FMath::Max(Ranks[EntryId], Rank);
+				}
+			}
+
+			// Sorted searches send empty chunks here, so they can still be cancelled.
+			if (++NumVerified == ChunkSize)
+			{
+				NumVerified = 0;
+
+				if (!OnChunk(Chunk))
+				{
+					return;
+				}
+
+				Chunk.Reset();
+			}
+		}
+	}
+
+	if (bIsStreamed)
+	{
+		if (!Chunk.IsEmpty())
+		{
+			OnChunk(Chunk);
+		}
+
+		return;
+	}
+
+	TArray<int32> Results;
+
+	for (int32 EntryId = 0; EntryId < Ranks.Num(); EntryId++)
+	{
+		if (Ranks[EntryId] > 0)
+		{
+			Results.Add(EntryId);
+		}
+	}
+
+	// Stable sort keeps hierarchy order between equal keys.
+	if (Query.Sort == ETreeViewSearchSort::Rank)
+	{
+		Algo::StableSortBy(Results, [&Ranks](int32 EntryId) { return -Ranks[EntryId]; });
+	}
+
+	else if (Query.Sort == ETreeViewSearchSort::Depth)
+	{
+		Algo::StableSortBy(Results, [this](int32 EntryId) { return this->Entries[EntryId].Depth; });
+	}
+
+	for (int32 ChunkStart = 0; ChunkStart < Results.Num(); ChunkStart += ChunkSize)
+	{
+		if (!OnChunk(TArrayView<const int32>(Results.GetData() + ChunkStart, FMath::Min(ChunkSize, Results.Num() - ChunkStart))))
+		{
+			return;
+		}
+	}
+}
+
+void FTreeView_Index::GetAncestors(int32 EntryId, TArray<int32>& Out_Ancestors) const
+{
+	Out_Ancestors.Reset();
+
+	if (!this->Entries.IsValidIndex(EntryId))
+	{
+		return;
+	}
+
+	for (int32 Parent = this->Entries[EntryId].Parent; Parent != INDEX_NONE; Parent = this->Entries[Parent].Parent)
+	{
+		Out_Ancestors.Add(Parent);
+	}
+}
+
+int32 FTreeView_Index::Find(const USceneComponent* Component) const
+{
+	const int32* Found = this->ComponentToEntry.Find(Component);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FTreeView_Index::GetFirstChild(int32 EntryId) const
+{
+	return this->Entries.IsValidIndex(EntryId) ? this->Entries[EntryId].FirstChild : INDEX_NONE;
+}
+
+int32 FTreeView_Index::GetNextSibling(int32 EntryId) const
+{
+	return this->Entries.IsValidIndex(EntryId) ? this->Entries[EntryId].NextSibling : INDEX_NONE;
+}
+
+int32 FTreeView_Index::GetNextInSubtree(int32 EntryId, int32 SubtreeRoot) const
+{
+	if (this->Entries[EntryId].FirstChild != INDEX_NONE)
+	{
+		return this->Entries[EntryId].FirstChild;
+	}
+
+	for (int32 Current = EntryId; Current != SubtreeRoot && Current != INDEX_NONE; Current = this->Entries[Current].Parent)
+	{
+		if (this->Entries[Current].NextSibling != INDEX_NONE)
+		{
+			return this->Entries[Current].NextSibling;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool FTreeView_Index::IsInSubtree(int32 EntryId, int32 SubtreeRoot) const
+{
+	if (!this->Entries.IsValidIndex(EntryId) || !this->Entries.IsValidIndex(SubtreeRoot))
+	{
+		return false;
+	}
+
+	for (int32 Current = EntryId; Current != INDEX_NONE; Current = this->Entries[Current].Parent)
+	{
+		if (Current == SubtreeRoot)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -11,6 +11,7 @@ void UWidget_TreeView_Item::NativeConstruct()
 	Super::NativeConstruct();
 
 	this->Button_Expand->OnClicked.AddDynamic(this, &UWidget_TreeView_Item::On_Expand_Children);
+	this->Button_Select->OnClicked.AddDynamic(this, &UWidget_TreeView_Item::On_Select_Item);
 }
 
 void UWidget_TreeView_Item::NativeDestruct()
@@ -63,67 +64,43 @@ void UWidget_TreeView_Item::ApplyHighlightColor_Internal(UTreeView_Data* TreeVie
 
 void UWidget_TreeView_Item::UpdateTitle_Internal(UTreeView_Data* TreeView_Data)
 {
-	if (!IsValid(TreeView_Data) || !IsValid(TreeView_Data->Target_Component) || !IsValid(this->Title))
+	if (!IsValid(TreeView_Data) || !IsValid(this->Title))
 	{
 		return;
 	}
 
-	switch (TreeView_Data->NameType)
+	// Titles are prepared by hierarchy snapshot for every name type, so refreshing rows doesn't build any string.
+	this->Title->SetText(TreeView_Data->Title);
+}
+
+void UWidget_TreeView_Item::UpdateStats_Internal(UTreeView_Data* TreeView_Data)
+{
+	if (!IsValid(TreeView_Data) || !IsValid(this->Stats_Text))
 	{
-		case EHierarchyNames::Object:
-		{
-			const FString Object_Name = UMeshOperationsBPLibrary::GetObjectNameForPackage(TreeView_Data->Target_Component);
-			this->Title->SetText(FText::FromString(Object_Name));
-			break;
-		}
-
-		case EHierarchyNames::Product:
-		{
-			if (TreeView_Data->Target_Component->ComponentTags.IsEmpty())
-			{
-				this->Title->SetText(FText::FromString(UNNAMED_PRODUCT));
-				break;
-			}
-
-			const FString FirstTag = TreeView_Data->Target_Component->ComponentTags[0].ToString();
-
-			if (!FirstTag.Contains(FIELD_PRODUCT))
-			{
-				this->Title->SetText(FText::FromString(UNNAMED_PRODUCT));
-				break;
-			}
-
-			this->Title->SetText(FText::FromString(FirstTag));
-			break;
-		}
-
-		case EHierarchyNames::Instance:
-		{
-			if (TreeView_Data->Target_Component->ComponentTags.Num() < 2)
-			{
-				this->Title->SetText(FText::FromString(UNNAMED_INSTANCE));
-				break;
-			}
-
-			const FString SecondTag = TreeView_Data->Target_Component->ComponentTags[1].ToString();
-
-			if (!SecondTag.Contains(FIELD_INSTANCE))
-			{
-				this->Title->SetText(FText::FromString(UNNAMED_INSTANCE));
-				break;
-			}
-
-			this->Title->SetText(FText::FromString(SecondTag));
-			break;
-		}
-
-		default:
-		{
-			const FString Object_Name = UMeshOperationsBPLibrary::GetObjectNameForPackage(TreeView_Data->Target_Component);
-			this->Title->SetText(FText::FromString(Object_Name));
-			break;
-		}
+		return;
 	}
+
+	if (!TreeView_Data->bHasStats)
+	{
+		this->Stats_Text->SetText(FText::GetEmpty());
+		return;
+	}
+
+	const FTreeViewStatsStruct& Stats = TreeView_Data->Stats;
+
+	FFormatOrderedArguments Arguments;
+	Arguments.Add(FText::AsNumber(Stats.Components));
+	Arguments.Add(FText::AsNumber(Stats.Triangles));
+	Arguments.Add(FText::AsNumber(Stats.Unique_Meshes));
+	Arguments.Add(FText::AsNumber(Stats.Draw_Calls));
+	Arguments.Add(FText::AsMemory(Stats.Memory));
+
+	this->Stats_Text->SetText(FText::Format(FText::FromString(TEXT("{0} parts | {1} tris | {2} meshes | {3} draws | {4}")), Arguments));
+}
+
+void UWidget_TreeView_Item::UpdateStats()
+{
+	this->UpdateStats_Internal(Cast<UTreeView_Data>(this->GetListItem()));
 }
 
 void UWidget_TreeView_Item::ApplyHighlightColor()
@@ -155,19 +132,36 @@ void UWidget_TreeView_Item::On_Expand_Children()
 	OwningTreeView->SetItemExpansion(TreeView_Data, !IsListItemExpanded());
 }
 
+void UWidget_TreeView_Item::On_Select_Item()
+{
+	UTreeView* OwningTreeView = Cast<UTreeView>(GetOwningListView());
+
+	if (!IsValid(OwningTreeView))
+	{
+		return;
+	}
+
+	if (UTreeView_Data* TreeView_Data = Cast<UTreeView_Data>(this->GetListItem()))
+	{
+		OwningTreeView->SetSelectedItem(TreeView_Data);
+	}
+}
+
 void UWidget_TreeView_Item::NativeOnListItemObjectSet(UObject* ListItemObject)
 {
 	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
 
 	UTreeView_Data* TreeView_Data = Cast<UTreeView_Data>(ListItemObject);
 
-	if (!IsValid(TreeView_Data) || !IsValid(TreeView_Data->Target_Component))
+	if (!IsValid(TreeView_Data))
 	{
 		return;
 	}
 
 	this->UpdateTitle_Internal(TreeView_Data);
 
+	this->UpdateStats_Internal(TreeView_Data);
+
 	this->ApplyHighlightColor_Internal(TreeView_Data);
 
 	if (!IsValid(this->Button_Expand))
@@ -187,8 +181,7 @@ void UWidget_TreeView_Item::NativeOnListItemObjectSet(UObject* ListItemObject)
 
 	// We hide expand button after padding else, padding won't work. Also, we need to hide it instead collapse because we need its layout.
 
-	const bool bHasChildren = TreeView_Data->Target_Component->GetNumChildrenComponents() > 0;
-	const ESlateVisibility NewVisibility = bHasChildren ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
+	const ESlateVisibility NewVisibility = TreeView_Data->bHasChildren ? ESlateVisibility::Visible : ESlateVisibility::Hidden;
 	this->Button_Expand->SetVisibility(NewVisibility);
 }
 
@@ -0,0 +1,237 @@
+#include "Widgets/Widget_TreeView_Stats.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+// Small levels are cheaper on one thread than scheduling tasks for them.
+#define TREEVIEW_STATS_PARALLEL_THRESHOLD 512
+
+void FTreeView_Stats::Gather(const FTreeView_Index& Index)
+{
+	this->Meshes.Reset();
+	this->Entry_Meshes.Init(INDEX_NONE, Index.Num());
+	this->Entry_Instances.Init(0, Index.Num());
+	this->Totals.Reset();
+
+	TMap<const UStaticMesh*, int32> MeshIds;
+	TMap<FSoftObjectPath, int32> OutlineMeshIds;
+
+	auto GetMeshId = [this, &MeshIds](const UStaticMesh* StaticMesh) -> int32
+		{
+			if (const int32* Found = MeshIds.Find(StaticMesh))
+			{
+				return *Found;
+			}
+
+			FMeshCost& Cost = this->Meshes.AddDefaulted_GetRef();
+			const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+
+			if (RenderData && !RenderData->LODResources.IsEmpty())
+			{
+				Cost.Triangles = RenderData->LODResources[0].GetNumTriangles();
+				Cost.Sections = RenderData->LODResources[0].Sections.Num();
+			}
+
+			Cost.Memory = StaticMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+			return MeshIds.Add(StaticMesh, this->Meshes.Num() - 1);
+		};
+
+	for (int32 EntryId = 0; EntryId < Index.Num(); EntryId++)
+	{
+		const FTreeView_Index::FEntry& Entry = Index.GetEntry(EntryId);
+
+		if (Entry.bIsRemoved)
+		{
+			continue;
+		}
+
+		// Outlines only keep mesh paths. Meshes which are in memory anyway give their costs and others are counted as unique meshes only.
+		if (const FMeshOps_HierarchyOutline::FNode* Node = Index.GetOutlineNode(EntryId))
+		{
+			if (Node->Mesh == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FSoftObjectPath& MeshPath = Index.GetOutline(EntryId)->Meshes[Node->Mesh];
+
+			if (const int32* Found = OutlineMeshIds.Find(MeshPath))
+			{
+				this->Entry_Meshes[EntryId] = *Found;
+			}
+
+			else if (const UStaticMesh* LoadedMesh = Cast<UStaticMesh>(MeshPath.ResolveObject()))
+			{
+				this->Entry_Meshes[EntryId] = OutlineMeshIds.Add(MeshPath, GetMeshId(LoadedMesh));
+			}
+
+			else
+			{
+				this->Meshes.AddDefaulted();
+				this->Entry_Meshes[EntryId] = OutlineMeshIds.Add(MeshPath, this->Meshes.Num() - 1);
+			}
+
+			this->Entry_Instances[EntryId] = 1;
+			continue;
+		}
+
+		const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Entry.Component.Get());
+
+		if (!IsValid(MeshComponent) || !MeshComponent->GetStaticMesh())
+		{
+			continue;
+		}
+
+		const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+
+		this->Entry_Meshes[EntryId] = GetMeshId(MeshComponent->GetStaticMesh());
+		this->Entry_Instances[EntryId] = InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+	}
+}
+
+void FTreeView_Stats::Compute(const FTreeView_Index& Index)
+{
+	const int32 NumEntries = Index.Num();
+
+	this->Totals.SetNum(NumEntries);
+
+	// Entries of each depth level. Removed entries don't have totals.
+	TArray<TArray<int32>> Levels;
+
+	for (int32 EntryId = 0; EntryId < NumEntries; EntryId++)
+	{
+		const FTreeView_Index::FEntry& Entry = Index.GetEntry(EntryId);
+
+		this->Totals[EntryId] = FTreeViewStatsStruct();
+
+		if (Entry.bIsRemoved)
+		{
+			continue;
+		}
+
+		if (Levels.Num() <= Entry.Depth)
+		{
+			Levels.SetNum(Entry.Depth + 1);
+		}
+
+		Levels[Entry.Depth].Add(EntryId);
+	}
+
+	// Mesh ids of each subtree. Children sets are emptied when their parent takes them.
+	TArray<TSet<int32>> MeshSets;
+	MeshSets.SetNum(NumEntries);
+
+	// Deepest level first, so children are always done when their parent is processed. Every entry only writes itself and its own children.
+	for (int32 LevelIndex = Levels.Num() - 1; LevelIndex >= 0; LevelIndex--)
+	{
+		const TArray<int32>& Level = Levels[LevelIndex];
+		const EParallelForFlags Flags = Level.Num() < TREEVIEW_STATS_PARALLEL_THRESHOLD ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+		ParallelFor(Level.Num(), [this, &Index, &Level, &MeshSets](int32 Level_Index)
+			{
+				const int32 EntryId = Level[Level_Index];
+				FTreeViewStatsStruct& Total = this->Totals[EntryId];
+				TSet<int32>& MeshSet = MeshSets[EntryId];
+
+				// Largest child set becomes the base, so only smaller sets are merged.
+				int32 Largest_Child = INDEX_NONE;
+
+				for (int32 Child = Index.GetFirstChild(EntryId); Child != INDEX_NONE; Child = Index.GetNextSibling(Child))
+				{
+					const FTreeViewStatsStruct& Child_Total = this->Totals[Child];
+					Total.Components += Child_Total.Components;
+					Total.Triangles += Child_Total.Triangles;
+					Total.Draw_Calls += Child_Total.Draw_Calls;
+
+					if (Largest_Child == INDEX_NONE || MeshSets[Child].Num() > MeshSets[Largest_Child].Num())
+					{
+						Largest_Child = Child;
+					}
+				}
+
+				if (Largest_Child != INDEX_NONE)
+				{
+					MeshSet = MoveTemp(MeshSets[Largest_Child]);
+					Total.Memory = this->Totals[Largest_Child].Memory;
+				}
+
+				auto AddMesh = [this, &MeshSet, &Total](int32 MeshId)
+					{
+						bool bIsAlreadyInSet = false;
+						MeshSet.Add(MeshId, &bIsAlreadyInSet);
+
+						if (!bIsAlreadyInSet)
+						{
+							Total.Memory += this->Meshes[MeshId].Memory;
+						}
+					};
+
+				for (int32 Child = Index.GetFirstChild(EntryId); Child != INDEX_NONE; Child = Index.GetNextSibling(Child))
+				{
+					if (Child == Largest_Child)
+					{
+						continue;
+					}
+
+					for (const int32 Each_Mesh : MeshSets[Child])
+					{
+						AddMesh(Each_Mesh);
+					}
+
+					MeshSets[Child].Empty();
+				}
+
+				Total.Components++;
+
+				const int32 MeshId = this->Entry_Meshes[EntryId];
+				const int32 Instances = this->Entry_Instances[EntryId];
+
+				if (MeshId != INDEX_NONE)
+				{
+					AddMesh(MeshId);
+
+					if (Instances > 0)
+					{
+						Total.Triangles += this->Meshes[MeshId].Triangles * Instances;
+						Total.Draw_Calls += this->Meshes[MeshId].Sections;
+					}
+				}
+
+				Total.Unique_Meshes = MeshSet.Num();
+			}, Flags);
+	}
+}
+
+int64 FTreeView_Stats::GetSortValue(int32 EntryId, ETreeViewStatsSort Sort) const
+{
+	if (!this->Totals.IsValidIndex(EntryId))
+	{
+		return 0;
+	}
+
+	const FTreeViewStatsStruct& Total = this->Totals[EntryId];
+
+	switch (Sort)
+	{
+		case ETreeViewStatsSort::Components:
+			return Total.Components;
+
+		case ETreeViewStatsSort::Triangles:
+			return Total.Triangles;
+
+		case ETreeViewStatsSort::Unique_Meshes:
+			return Total.Unique_Meshes;
+
+		case ETreeViewStatsSort::Draw_Calls:
+			return Total.Draw_Calls;
+
+		case ETreeViewStatsSort::Memory:
+			return Total.Memory;
+
+		default:
+			return 0;
+	}
+}
@@ -9,6 +9,14 @@
 
 #include "MeshOperationsBPLibrary.generated.h"
 
+class UMeshOps_SpatialIndex;
+class UMeshOps_ExportTask;
+class UMeshOps_ImportTask;
+class UMeshOps_InstancedMeshComponent;
+
+// Parameter is the component whose direct children were attached, detached or destroyed.
+DECLARE_MULTICAST_DELEGATE_OneParam(FDelegateMeshOpsHierarchyChanged, USceneComponent*);
+
 UCLASS()
 class MESHOPERATIONS_API UMeshOperationsBPLibrary : public UBlueprintFunctionLibrary
 {
@@ -41,11 +49,27 @@ class MESHOPERATIONS_API UMeshOperationsBPLibrary : public UBlueprintFunctionLib
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Generate Wave", Keywords = "generate, mesh, wave"), Category = "Frozen Forest|Mesh Operations")
     static bool GenerateWave(bool bIsSin, double Amplitude, double RestHeight, double WaveLenght, TArray<FVector2D>& Out_Vertices, int32& EdgeTriangles);
 
+    /*
+    * If cache is used, mesh is loaded from a cache file when the same inputs were built before. Otherwise it is built and written to cache.
+    * Cache files are in Saved/MeshOperations/MeshCache and they are rebuilt automatically when their format changes.
+    * Cache is off by default. Files are written on worker threads and least recently used ones are deleted when the directory grows over 512 MB.
+    */
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Generate Static Mesh (Description)", Keywords = "generate, static, mesh"), Category = "Frozen Forest|Mesh Operations")
-    static UStaticMesh* GSM_Description(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<int32>& TriangleMaterialSlots, int32 NumMaterialSlots, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing);
+    static UStaticMesh* GSM_Description(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<int32>& TriangleMaterialSlots, int32 NumMaterialSlots, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing, bool bUseCache = false);
     
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Generate Static Mesh (Render Data)", Keywords = "generate, static, mesh"), Category = "Frozen Forest|Mesh Operations")
-    static UStaticMesh* GSM_RenderData(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing = false);
+    static UStaticMesh* GSM_RenderData(FName Mesh_Name, const TArray<FVector>& Vertices, const TArray<int32>& Indices, const TArray<FVector>& Normals, const TArray<FVector>& Tangents, const TArray<FVector2D>& UVs, bool bSupportRayTracing = false, bool bUseCache = false);
+
+    // Deletes cache files of generated static meshes. Meshes which are already loaded aren't affected.
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Generated Mesh Cache", Keywords = "reset, clear, generated, static, mesh, cache"), Category = "Frozen Forest|Mesh Operations")
+    static void ResetGeneratedMeshCache();
+
+    /*
+    * Merges static meshes under asset root to one static mesh with one section per unique material. Asset root is included if it is a static mesh component.
+    * Meshes need CPU access in packaged builds. Optional levels of detail let distant assemblies render with one draw call per material.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Merge Static Meshes", Keywords = "merge, combine, bake, static, mesh, lod"), Category = "Frozen Forest|Mesh Operations")
+    static UStaticMesh* MergeStaticMeshes(TArray<UStaticMeshComponent*>& Out_Merged, USceneComponent* AssetRoot, FName Mesh_Name, FMeshMergeOptionsStruct Options);
 
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Delete Empty Roots", Keywords = "optimize,hierarchy,empty,root,roots"), Category = "Frozen Forest|Mesh Operations")
     static void DeleteEmptyRoots(USceneComponent* AssetRoot);
@@ -62,11 +86,25 @@ class MESHOPERATIONS_API UMeshOperationsBPLibrary : public UBlueprintFunctionLib
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Delete Empty Parents (Components at Runtime)", Keywords = "optimize, hierarchy, remove, empty, parent"), Category = "Frozen Forest|Mesh Operations")
     static void DEP_Components_Runtime(USceneComponent* AssetRoot);
 
+    // Writes names, tags, parent indices, subtree bounds and static mesh paths of the hierarchy to a compact binary file. Tree view opens it without spawning the assembly.
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Hierarchy Outline", Keywords = "export, save, hierarchy, outline, tree, structure"), Category = "Frozen Forest|Mesh Operations")
+    static bool ExportHierarchyOutline(USceneComponent* AssetRoot, const FString& File_Path);
+
+    // Hierarchy views like tree view listen to this and only update changed branches.
+    static FDelegateMeshOpsHierarchyChanged OnHierarchyChanged;
+
+    /*
+    * Tells hierarchy views that direct children of the parent are attached, detached or destroyed.
+    * Plugin functions which change hierarchies already call it. Call it after changing hierarchies in Blueprints.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Notify Hierarchy Changed", Keywords = "notify, hierarchy, changed, attach, detach, destroy, tree"), Category = "Frozen Forest|Mesh Operations")
+    static void NotifyHierarchyChanged(USceneComponent* Changed_Parent);
+
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "OptimizeCenter", Keywords = "optimize,move,components,center"), Category = "Frozen Forest|Mesh Operations")
-    static void OptimizeCenter(USceneComponent* AssetRoot);
+    static void OptimizeCenter(USceneComponent* AssetRoot, bool bUseTightBounds = false);
 
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "OptimizeHeight", Keywords = "optimize,height"), Category = "Frozen Forest|Mesh Operations")
-    static void OptimizeHeight(USceneComponent* AssetRoot, float Z_Offset);
+    static void OptimizeHeight(USceneComponent* AssetRoot, float Z_Offset, bool bUseTightBounds = false);
 
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "RecordTransforms", ToolTip = "It should be attached to a MAP. Because we used local variable.", Keywords = "record,transforms"), Category = "Frozen Forest|Mesh Operations")
     static void RecordTransforms(USceneComponent* AssetRoot, TMap<USceneComponent*, FTransform>& MapTransform, TArray<USceneComponent*>& AllComponents, TArray<USceneComponent*>& ChildComponents);
@@ -77,6 +115,28 @@ class MESHOPERATIONS_API UMeshOperationsBPLibrary : public UBlueprintFunctionLib
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLTF", ToolTip = "Description.", Keywords = "level, export, gltf, glb"), Category = "Frozen Forest|Mesh Operations")
     static bool ExportLevelGLTF(FGLTFExportMessages& OutMessages, FGLTFExportOptionsStruct Options, FString ExportPath, TSet<AActor*> TargetActors);
 
+    /*
+    * Exports static meshes with constant material factors on a worker thread. Actors aren't moved, export options are applied to the copied level.
+    * Returned task broadcasts progress and completion on game thread and it can be canceled.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLTF Async", Keywords = "level, export, gltf, glb, async"), Category = "Frozen Forest|Mesh Operations")
+    static UMeshOps_ExportTask* ExportLevelGLTF_Async(FGLTFExportOptionsStruct Options, FString ExportPath, TSet<AActor*> TargetActors);
+
+    /*
+    * Exports each job to its own file with one task. Converted meshes and material factors are shared between jobs and up to Max_Concurrent_Jobs files are written at the same time.
+    * Same scope as Export Level As GLTF Async. Options for textures, baking, lights, cameras and animations are ignored and logged.
+    * Timings and stats of each job are reported with OnJobCompleted and GetResults.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLTF Batch", Keywords = "level, export, gltf, glb, async, batch"), Category = "Frozen Forest|Mesh Operations")
+    static UMeshOps_ExportTask* ExportLevelGLTF_Batch(TArray<FGLTFExportJobStruct> Jobs, FGLTFExportOptionsStruct Options, int32 Max_Concurrent_Jobs = 2);
+
+    /*
+    * Reads a .gltf or .glb file on a worker thread and rebuilds its nodes as components of target actor. Meshes are built from render data, so it works in packaged builds.
+    * Only static geometry and constant material factors are imported. Returned task broadcasts completion on game thread.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Import GLTF Async", Keywords = "import, load, gltf, glb, async, runtime"), Category = "Frozen Forest|Mesh Operations")
+    static UMeshOps_ImportTask* ImportGLTF_Async(AActor* Target_Actor, FString ImportPath, FGLTFImportOptionsStruct Options);
+
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Vertices Transform", Keywords = "get, vertex, vertices, locations, positions"), Category = "Frozen Forest|Mesh Operations")
     static bool GetVerticesTransforms(TArray<FTransform>& Out_Transform, UStaticMeshComponent* In_SMC, int32 LOD_Index, bool bUseRelativeLocation);
 
@@ -92,9 +152,74 @@ class MESHOPERATIONS_API UMeshOperationsBPLibrary : public UBlueprintFunctionLib
     UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Scene Component Bounds", Keywords = "get, scene, component, bounds"), Category = "Frozen Forest|Mesh Operations")
     static void GetSceneComponentBounds(FVector& Out_Origin, FVector& Out_Extent, USceneComponent* SceneComponent);
 
+    /*
+    * Exact AABB of transformed vertices. Convex hulls of meshes are cached, so each component only transforms its hull.
+    * Meshes need CPU access in packaged builds. Otherwise their local bounding boxes are used.
+    */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Scene Component Tight Bounds", Keywords = "get, scene, component, bounds, tight, exact, vertex"), Category = "Frozen Forest|Mesh Operations")
+    static void GetSceneComponentTightBounds(FVector& Out_Origin, FVector& Out_Extent, USceneComponent* SceneComponent);
+
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Scene Component Oriented Bounds", Keywords = "get, scene, component, bounds, oriented, obb, minimum"), Category = "Frozen Forest|Mesh Operations")
+    static bool GetSceneComponentOrientedBounds(FOrientedBoxStruct& Out_Box, USceneComponent* SceneComponent);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Mesh Hull Cache", Keywords = "reset, clear, mesh, hull, cache, bounds"), Category = "Frozen Forest|Mesh Operations")
+    static void ResetMeshHullCache();
+
+    /*
+    * Bounds of assemblies are cached. Moving components updates the cache automatically.
+    * Caches collect their hierarchy again after OnHierarchyChanged, which plugin functions broadcast. Attaching or detaching components in Blueprints has to call Notify Hierarchy Changed.
+    * Reset is only needed to free memory of assemblies which aren't queried anymore.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Bounds Cache", Keywords = "reset, clear, bounds, cache"), Category = "Frozen Forest|Mesh Operations")
+    static void ResetBoundsCache(USceneComponent* AssetRoot, bool bResetAll = false);
+
     UFUNCTION(BlueprintPure, meta = (DisplayName = "IsInBounds", Keywords = "is, vector, in, bounds, box, component"), Category = "Frozen Forest|Mesh Operations")
     static bool IsInBounds(USceneComponent* Target_Comp, FVector In_Origin, FVector In_Extent);
 
+    /*
+    * Tests all points against one bounds in a vectorized loop. Outputs are indices of input points.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bulk Is In Bounds", Keywords = "bulk, batch, is, vector, point, in, bounds, box"), Category = "Frozen Forest|Mesh Operations")
+    static void BulkIsInBounds(const TArray<FVector>& Points, FVector In_Origin, FVector In_Extent, TArray<int32>& Out_Inside, TArray<int32>& Out_Outside);
+
+    /*
+    * For each point, index of the first bounds which contains it. -1 if none of them contains it.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bulk Is In Any Bounds", Keywords = "bulk, batch, is, vector, point, in, bounds, box, zones"), Category = "Frozen Forest|Mesh Operations")
+    static void BulkIsInAnyBounds(const TArray<FVector>& Points, const TArray<FBox>& Bounds, TArray<int32>& Out_BoundsIndices);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bulk Boxes In Bounds", Keywords = "bulk, batch, box, boxes, in, bounds, overlap, intersect"), Category = "Frozen Forest|Mesh Operations")
+    static void BulkBoxesInBounds(const TArray<FBox>& Boxes, FVector In_Origin, FVector In_Extent, bool bFullyInside, TArray<int32>& Out_Matching);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bulk Components In Bounds", Keywords = "bulk, batch, is, component, components, in, bounds"), Category = "Frozen Forest|Mesh Operations")
+    static void BulkComponentsInBounds(const TArray<USceneComponent*>& Components, FVector In_Origin, FVector In_Extent, TArray<USceneComponent*>& Out_Inside, TArray<USceneComponent*>& Out_Outside);
+
+    /*
+    * Builds a bounding volume hierarchy over primitive descendants of asset root for repeated overlap, nearest and ray queries.
+    * If bAutoRefit is true, moved components are refitted before the next query. Rebuild it after attaching or detaching components.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Build Spatial Index", Keywords = "build, spatial, index, bvh, query, raycast, nearest, overlap"), Category = "Frozen Forest|Mesh Operations")
+    static UMeshOps_SpatialIndex* BuildSpatialIndex(USceneComponent* AssetRoot, bool bOnlyStaticMeshes = true, bool bAutoRefit = true);
+
+    /*
+    * Replaces static mesh components which share the same geometry and materials with one instanced component per group under asset root.
+    * If bMatchGeometry is false, only components with the same mesh asset are grouped. Names and tags of replaced components are kept as instance records.
+    * Components with children aren't converted. Parents which become empty aren't deleted, use Delete Empty Roots for them.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Convert to Instances", Keywords = "convert, instance, instances, instancing, duplicate, draw, call"), Category = "Frozen Forest|Mesh Operations")
+    static int32 ConvertToInstances(TArray<UMeshOps_InstancedMeshComponent*>& Out_Instanced, USceneComponent* AssetRoot, int32 MinInstances = 2, bool bMatchGeometry = true);
+
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Geometry Hash Cache", Keywords = "reset, clear, geometry, hash, cache"), Category = "Frozen Forest|Mesh Operations")
+    static void ResetGeometryHashCache();
+
+    /*
+    * Runs enabled validators in parallel and returns one issue per problem. Issues are also logged and marked on the assembly.
+    * Default options check bounds, scales, meshes, duplicates and single child chains. Tag check is optional because not every assembly is imported with tags.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Check Assembly Report", Keywords = "check, assembly, validate, report"), Category = "Frozen Forest|Mesh Operations")
+    static void Check_Assembly_Report(TArray<FAssemblyCheckIssueStruct>& Out_Issues, USceneComponent* Target_Root, FAssemblyCheckOptionsStruct Options, bool bSpawnBillboardForOnlyProblems = false);
+
+    // Runs Check Assembly Report with default options and only logs and marks issues.
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Check Assembly", Keywords = "check, assembly"), Category = "Frozen Forest|Mesh Operations")
     static void Check_Assembly(USceneComponent* Target_Root, bool bSpawnBillboardForOnlyProblems = false);
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+#include "MeshOps_Structs.h"
+
+class UStaticMesh;
+
+/*
+* Validators for imported assemblies.
+* Hierarchy is copied to a flat snapshot on game thread. Enabled validators run in parallel on that snapshot and each of them writes its own issue list, so results are deterministic and ordered by validator and hierarchy order.
+*/
+class MESHOPERATIONS_API FMeshOps_AssemblyCheck
+{
+
+public:
+
+    struct FNode
+    {
+        USceneComponent* Component = nullptr;
+        const UStaticMesh* StaticMesh = nullptr;
+        FTransform Transform;
+
+        int32 Parent = INDEX_NONE;
+        int32 NumChildren = 0;
+
+        // Valid only if the node has exactly one child.
+        int32 OnlyChild = INDEX_NONE;
+
+        bool bIsStaticMeshComponent = false;
+
+        FName Product_Tag;
+        FName Instance_Tag;
+    };
+
+    struct FSnapshot
+    {
+        // Breadth first order. Parents always come before their children.
+        TArray<FNode> Nodes;
+        FBox Bounds = FBox(ForceInit);
+    };
+
+    // Ignored components and their descendants aren't added to the snapshot and don't contribute to its bounds.
+    static void MakeSnapshot(USceneComponent* Target_Root, TArrayView<USceneComponent* const> Ignored, FSnapshot& Out_Snapshot);
+
+    static void Run(const FSnapshot& Snapshot, const FAssemblyCheckOptionsStruct& Options, TArray<FAssemblyCheckIssueStruct>& Out_Issues);
+
+    static FString GetCheckName(EAssemblyCheckType Type);
+
+};
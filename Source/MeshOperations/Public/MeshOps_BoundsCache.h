@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+/*
+* Bounds cache of one assembly.
+* Nodes are stored in breadth first order, so children of a node and every depth level are contiguous ranges. Boxes are computed bottom-up one level at a time and each level is processed in parallel.
+* Every cached component's TransformUpdated event marks itself and its ancestors dirty, so queries on an unchanged assembly are O(1) and a moved part only recomputes its own branch.
+* Caches listen to UMeshOperationsBPLibrary::OnHierarchyChanged. When one of their components gets new or fewer children, the hierarchy is collected again on the next query.
+*/
+class MESHOPERATIONS_API FMeshOps_BoundsCache : public TSharedFromThis<FMeshOps_BoundsCache>
+{
+
+public:
+
+    ~FMeshOps_BoundsCache();
+
+    // Returns the cache which contains target component. If there is no cache, target becomes a new assembly root.
+    static TSharedRef<FMeshOps_BoundsCache> Get(USceneComponent* Target);
+
+    // Removes the cache of the assembly which contains target component.
+    static void Reset(USceneComponent* Target);
+
+    static void ResetAll();
+
+    // Marks target dirty in the cache which contains it, if there is one. Use it when geometry changes without a transform update, like swapping meshes.
+    static void InvalidateContaining(USceneComponent* Target);
+
+    // Union of primitive bounds of all descendants. Target itself is not included, same as GetSceneComponentBounds.
+    bool GetDescendantsBounds(USceneComponent* Target, FBox& Out_Box);
+
+    // Union of primitive bounds of target and all of its descendants.
+    bool GetSubtreeBounds(USceneComponent* Target, FBox& Out_Box);
+
+    // Marks target and its ancestors dirty. Next query recomputes only dirty nodes.
+    void Invalidate(USceneComponent* Target);
+
+    // Hierarchy is collected again on the next query. Plugin functions and NotifyHierarchyChanged already trigger it after attaching or detaching components.
+    void Rebuild();
+
+    // Marks hierarchy changed if changed parent is one of the cached components. Doesn't collect, so many notifications in a row stay cheap.
+    void MarkHierarchyChanged(const USceneComponent* Changed_Parent);
+
+    bool Contains(const USceneComponent* Target);
+
+    USceneComponent* GetRoot() const;
+
+private:
+
+    struct FBoundsNode
+    {
+        TWeakObjectPtr<USceneComponent> Component;
+        FDelegateHandle TransformHandle;
+        FBox OwnBox = FBox(ForceInit);
+        FBox DescendantsBox = FBox(ForceInit);
+        int32 Parent = INDEX_NONE;
+        int32 FirstChild = 0;
+        int32 NumChildren = 0;
+        bool bIsDirty = true;
+    };
+
+    TWeakObjectPtr<USceneComponent> AssetRoot;
+    TArray<FBoundsNode> Nodes;
+
+    // Start index of each depth level. Last element is Nodes.Num().
+    TArray<int32> LevelStarts;
+
+    TMap<const USceneComponent*, int32> NodeIndices;
+
+    bool bAnyDirty = true;
+    bool bIsHierarchyChanged = false;
+
+    void CollectIfChanged();
+    void Collect();
+    void Unbind();
+    void Refresh();
+    void MarkDirty(int32 NodeIndex);
+    void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MeshOps_Enums.generated.h"
+
+UENUM(BlueprintType)
+enum class EAssemblyCheckType : uint8
+{
+	OutOfBounds = 0			UMETA(DisplayName = "Out of Bounds"),
+	ZeroScale = 1			UMETA(DisplayName = "Zero Scale"),
+	EmptyMesh = 2			UMETA(DisplayName = "Empty Mesh"),
+	DegenerateMesh = 3		UMETA(DisplayName = "Degenerate Mesh"),
+	DuplicateInstance = 4	UMETA(DisplayName = "Duplicate Instance"),
+	MissingTags = 5			UMETA(DisplayName = "Missing Tags"),
+	SingleChildChain = 6	UMETA(DisplayName = "Single Child Chain"),
+};
+
+UENUM(BlueprintType)
+enum class EAssemblyCheckSeverity : uint8
+{
+	Info = 0		UMETA(DisplayName = "Info"),
+	Warning = 1		UMETA(DisplayName = "Warning"),
+	Error = 2		UMETA(DisplayName = "Error"),
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "MeshOps_GLTFWriter.h"
+
+#include "MeshOps_ExportTask.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDelegateMeshOpsExportProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FDelegateMeshOpsExportCompleted, bool, bIsSuccessful, const FString&, Message);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDelegateMeshOpsExportJobCompleted, const FGLTFExportJobResultStruct&, Result);
+
+/*
+* Runs native glTF exports on worker threads.
+* Level is copied on game thread when task starts, so actors are never moved and they can change while export runs.
+* A task can run several jobs. They share converted meshes and material factors and up to Max_Concurrent_Jobs of them are written at the same time.
+* Textures, baked materials, lights, cameras and animations aren't exported. Start logs the requested options which are ignored.
+* Delegates are always broadcast on game thread.
+*/
+UCLASS(BlueprintType)
+class MESHOPERATIONS_API UMeshOps_ExportTask : public UObject
+{
+	GENERATED_BODY()
+
+private:
+
+    struct FJob
+    {
+        FString ExportPath;
+        FMeshOps_ExportScene Scene;
+        double Snapshot_Time = 0;
+        std::atomic<float> Progress = 0.f;
+    };
+
+    TArray<TUniquePtr<FJob>> Jobs;
+    TArray<FGLTFExportJobResultStruct> Results;
+    TUniquePtr<FMeshOps_GLTFCache> Cache;
+    FGLTFExportOptionsStruct Options;
+
+    // Keeps static meshes of the snapshots alive while workers read them.
+    UPROPERTY()
+    TArray<TObjectPtr<UStaticMesh>> Used_Meshes;
+
+    std::atomic<int32> Next_Job = 0;
+    std::atomic<int32> Running_Workers = 0;
+    std::atomic<bool> bIsCancelRequested = false;
+    std::atomic<bool> bIsRunning = false;
+    std::atomic<float> Posted_Progress = 0.f;
+
+    void RunJobs();
+    bool ReportProgress(int32 JobIndex, float In_Progress);
+    void Finish();
+
+public:
+
+    UPROPERTY(BlueprintAssignable, Category = "Frozen Forest|Mesh Operations|Export")
+    FDelegateMeshOpsExportProgress OnProgress;
+
+    UPROPERTY(BlueprintAssignable, Category = "Frozen Forest|Mesh Operations|Export")
+    FDelegateMeshOpsExportJobCompleted OnJobCompleted;
+
+    // Successful only if every job is successful.
+    UPROPERTY(BlueprintAssignable, Category = "Frozen Forest|Mesh Operations|Export")
+    FDelegateMeshOpsExportCompleted OnCompleted;
+
+    // Takes the snapshots and starts workers. Game thread only.
+    bool Start(TArrayView<const FGLTFExportJobStruct> In_Jobs, const FGLTFExportOptionsStruct& In_Options, int32 Max_Concurrent_Jobs = 1);
+
+    // Workers stop at the next batch of meshes and remaining jobs are skipped.
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Export")
+    void Cancel();
+
+    // Average progress of all jobs.
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Export")
+    float GetProgress() const;
+
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Export")
+    bool IsRunning() const;
+
+    // Valid after completed delegate is broadcast. Stats of the first job.
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Export")
+    FGLTFExportStatsStruct GetStats() const;
+
+    // Result of each job in the order they were given.
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Export")
+    TArray<FGLTFExportJobResultStruct> GetResults() const;
+
+};
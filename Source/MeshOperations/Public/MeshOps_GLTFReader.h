@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MeshOps_MeshBuilder.h"
+
+/*
+* Content of a glTF file converted to Unreal axes and units.
+* It only holds plain data, so it can be filled on any thread and turned into components on game thread.
+*/
+struct MESHOPERATIONS_API FMeshOps_ImportScene
+{
+    struct FNode
+    {
+        FString Name;
+        int32 Parent = INDEX_NONE;
+        TArray<int32> Children;
+
+        // Relative to parent node.
+        FTransform Transform;
+
+        int32 Mesh = INDEX_NONE;
+    };
+
+    struct FMaterial
+    {
+        FString Name;
+        FLinearColor BaseColor = FLinearColor::White;
+        FLinearColor Emissive = FLinearColor::Black;
+        float Metallic = 1.f;
+        float Roughness = 1.f;
+        bool bIsTwoSided = false;
+        bool bIsTranslucent = false;
+        bool bIsMasked = false;
+    };
+
+    struct FMesh
+    {
+        FString Name;
+
+        // Each primitive is one section. Section material index is the slot index.
+        FMeshOps_MeshBuffers Buffers;
+
+        // Scene material of each slot. INDEX_NONE means primitive has no material.
+        TArray<int32> Materials;
+    };
+
+    TArray<FNode> Nodes;
+    TArray<int32> RootNodes;
+    TArray<FMesh> Meshes;
+    TArray<FMaterial> Materials;
+};
+
+/*
+* Native glTF 2.0 reader for static mesh hierarchies.
+* Reads .glb and .gltf files with external or embedded buffers. Files are memory mapped and accessors are decoded straight into mesh buffers.
+* Only triangle primitives and constant material factors are read. Files which require an unsupported extension are rejected.
+*/
+class MESHOPERATIONS_API FMeshOps_GLTFReader
+{
+
+public:
+
+    // Can be called on any thread. Positions and translations are multiplied with UniformScale.
+    static bool Read(const FString& ImportPath, float UniformScale, FMeshOps_ImportScene& Out_Scene, FString& Out_Error);
+
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MeshOps_Structs.h"
+
+class AActor;
+class UStaticMesh;
+
+/*
+* Everything exporter needs from the level, copied on game thread.
+* Workers only read this snapshot and CPU copies of static mesh buffers, so level can change while export runs.
+*/
+struct MESHOPERATIONS_API FMeshOps_ExportScene
+{
+    struct FNode
+    {
+        FString Name;
+        int32 Parent = INDEX_NONE;
+        TArray<int32> Children;
+
+        // Relative to parent node. Root nodes have world transform with export overrides applied.
+        FTransform Transform;
+
+        int32 Mesh = INDEX_NONE;
+    };
+
+    struct FMaterial
+    {
+        FString Name;
+        FLinearColor BaseColor = FLinearColor::White;
+        FLinearColor Emissive = FLinearColor::Black;
+        float Metallic = 0.f;
+        float Roughness = 0.5f;
+        bool bIsTwoSided = false;
+        bool bIsTranslucent = false;
+        bool bIsMasked = false;
+    };
+
+    struct FMesh
+    {
+        FString Name;
+        const UStaticMesh* StaticMesh = nullptr;
+        int32 LOD_Index = 0;
+
+        // Scene material of each material slot. Same static mesh with different override materials is a different mesh.
+        TArray<int32> Materials;
+    };
+
+    TArray<FNode> Nodes;
+    TArray<int32> RootNodes;
+    TArray<FMesh> Meshes;
+    TArray<FMaterial> Materials;
+};
+
+/*
+* Converted meshes and material factors shared between exports of one batch, so parts used by several products are read and encoded once.
+* Meshes are cached by asset, so static meshes have to stay alive and unchanged while the cache is used.
+*/
+class MESHOPERATIONS_API FMeshOps_GLTFCache
+{
+
+public:
+
+    // Converted meshes are kept until their total size reaches the budget. Later meshes are converted by each export again.
+    explicit FMeshOps_GLTFCache(int64 In_Budget = 512ll * 1024 * 1024);
+    ~FMeshOps_GLTFCache();
+
+private:
+
+    friend class FMeshOps_GLTFWriter;
+
+    struct FImpl;
+    TUniquePtr<FImpl> Impl;
+
+};
+
+/*
+* Native glTF 2.0 writer for static mesh hierarchies.
+* Writes .glb if path ends with .glb, otherwise .gltf with a .bin file next to it.
+* Buffers are streamed to disk while meshes are converted, so peak memory depends on the biggest meshes, not on the scene.
+* If max buffer size is set, binary data continues in Name_1.bin, Name_2.bin ... next to the main file.
+* Mesh compression reorders triangles and vertices of each mesh and encodes them with EXT_meshopt_compression. The extension is only listed as used, because compressed views point to a fallback buffer.
+* Only static meshes and constant material factors are exported. Texture and material baking needs render thread, so they stay in the engine exporter.
+*/
+class MESHOPERATIONS_API FMeshOps_GLTFWriter
+{
+
+public:
+
+    // Game thread only. Cache is optional. Actors attached under another given actor are exported once, as part of its hierarchy.
+    static void MakeSnapshot(TArrayView<AActor* const> Actors, const FGLTFExportOptionsStruct& Options, FMeshOps_ExportScene& Out_Scene, FMeshOps_GLTFCache* Cache = nullptr);
+
+    // Names of requested options which only the engine exporter supports, like textures, baking, lights, cameras and animations. Writer ignores them.
+    static void GetIgnoredOptions(const FGLTFExportOptionsStruct& Options, TArray<FString>& Out_Names);
+
+    /*
+    * Can run on any thread. ReportProgress receives values between 0 and 1 and returns false to cancel export.
+    * Static meshes of the scene have to be kept alive by caller until it returns.
+    * Several writes can share one cache concurrently.
+    */
+    static bool Write(const FMeshOps_ExportScene& Scene, const FGLTFExportOptionsStruct& Options, const FString& ExportPath, TFunctionRef<bool(float Progress)> ReportProgress, FGLTFExportStatsStruct& Out_Stats, FString& Out_Error, FMeshOps_GLTFCache* Cache = nullptr);
+
+    /*
+    * Removes translation and/or scale of scene root nodes in an already written .gltf or .glb file.
+    * Only JSON is rewritten. Binary chunk is stream copied, so big files don't have to fit into memory.
+    */
+    static bool OverrideRootTransforms(const FString& ExportPath, bool bResetLocation, bool bResetScale, FString& Out_Error);
+
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USceneComponent;
+
+/*
+* Compact outline of a component hierarchy, so structure of large assemblies can be browsed without loading or spawning them.
+* Nodes are in depth first order and parents always come before their children. Bounds are world space subtree bounds at the time of export.
+* File keeps names, tags and mesh paths in a string table, so repeated product names and meshes are written once.
+*/
+class MESHOPERATIONS_API FMeshOps_HierarchyOutline
+{
+
+public:
+
+    struct FNode
+    {
+        FString Name;
+        TArray<FName> Tags;
+        int32 Parent = INDEX_NONE;
+        // Index of Meshes or INDEX_NONE if component doesn't reference a static mesh.
+        int32 Mesh = INDEX_NONE;
+        FBox Bounds = FBox(ForceInit);
+    };
+
+    TArray<FNode> Nodes;
+    TArray<FSoftObjectPath> Meshes;
+
+    // Game thread only. Root and all of its descendants are added.
+    static bool Build(USceneComponent* AssetRoot, FMeshOps_HierarchyOutline& Out_Outline);
+
+    bool Save(const FString& File_Path) const;
+
+    // Reads and validates the file. It doesn't touch any UObject, so it can run on any thread.
+    bool Load(const FString& File_Path);
+
+};
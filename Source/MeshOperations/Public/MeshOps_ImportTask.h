@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Containers/Ticker.h"
+
+#include "MeshOps_Structs.h"
+#include "MeshOps_GLTFReader.h"
+
+#include "MeshOps_ImportTask.generated.h"
+
+class AActor;
+class USceneComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FDelegateMeshOpsImportCompleted, bool, bIsSuccessful, const FString&, Message);
+
+/*
+* Reads a glTF file on a worker thread and rebuilds its node hierarchy under target actor on game thread.
+* Nodes with meshes become static mesh components and other nodes become scene components. All of them are attached under one import root component.
+* Meshes and components are created over several frames within a per frame time budget, so large files don't stall game thread.
+* Completed delegate is always broadcast on game thread.
+*/
+UCLASS(BlueprintType)
+class MESHOPERATIONS_API UMeshOps_ImportTask : public UObject
+{
+	GENERATED_BODY()
+
+private:
+
+    FString ImportPath;
+    FMeshOps_ImportScene Scene;
+    TWeakObjectPtr<AActor> Target_Actor;
+
+    UPROPERTY()
+    FGLTFImportOptionsStruct Options;
+
+    UPROPERTY()
+    TObjectPtr<USceneComponent> Import_Root;
+
+    UPROPERTY()
+    TArray<TObjectPtr<UStaticMesh>> Meshes;
+
+    UPROPERTY()
+    TArray<TObjectPtr<UMaterialInterface>> Materials;
+
+    // Created component of each scene node. Nodes which aren't created yet are null.
+    UPROPERTY()
+    TArray<TObjectPtr<USceneComponent>> Node_Components;
+
+    // Build progress between ticks.
+    int32 Next_Mesh = 0;
+    TArray<int32> Node_Stack;
+    FTSTicker::FDelegateHandle Ticker_Handle;
+
+    double Read_Time = 0;
+    double Build_Start_Time = 0;
+
+    std::atomic<bool> bIsRunning = false;
+
+    void CreateMaterials();
+    bool TickBuild(float DeltaTime);
+
+    // Builds the next mesh or component. Returns false when task is finished.
+    bool BuildNext();
+
+    void Finish(bool bIsSuccessful, const FString& Message);
+
+public:
+
+    UPROPERTY(BlueprintAssignable, Category = "Frozen Forest|Mesh Operations|Import")
+    FDelegateMeshOpsImportCompleted OnCompleted;
+
+    // Starts reading the file. Game thread only.
+    bool Start(AActor* In_Target_Actor, const FString& In_ImportPath, const FGLTFImportOptionsStruct& In_Options);
+
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Import")
+    bool IsRunning() const;
+
+    // Scene component which holds the imported hierarchy. Valid after successful completion.
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Import")
+    USceneComponent* GetImportRoot() const;
+
+    // Static meshes built for each glTF mesh. Nodes which use the same mesh share it.
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Import")
+    TArray<UStaticMesh*> GetMeshes() const;
+
+};
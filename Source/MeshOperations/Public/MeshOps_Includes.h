@@ -11,6 +11,7 @@
 #include "Components/SceneComponent.h"
 #include "Components/ActorComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/BillboardComponent.h"
 #include "Components/BoxComponent.h"
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+#include "MeshOps_Structs.h"
+
+#include "MeshOps_InstancedMeshComponent.generated.h"
+
+/*
+* Instanced static mesh component which keeps a record for each instance, so names and tags of replaced components are still available.
+* Records follow instance indices. Removing an instance removes its record too.
+*/
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class MESHOPERATIONS_API UMeshOps_InstancedMeshComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Frozen Forest|Mesh Operations|Instances")
+	TArray<FMeshInstanceRecordStruct> Instance_Records;
+
+	virtual bool RemoveInstance(int32 InstanceIndex) override;
+	virtual bool RemoveInstances(const TArray<int32>& InstancesToRemove) override;
+	virtual bool RemoveInstances(const TArray<int32>& InstancesToRemove, bool bInstanceArrayAlreadySortedInReverseOrder) override;
+	virtual void ClearInstances() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Instances")
+	int32 AddInstanceWithRecord(const FTransform& InstanceTransform, const FMeshInstanceRecordStruct& Record, bool bWorldSpace = true);
+
+	UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Instances")
+	bool GetInstanceRecord(int32 InstanceIndex, FMeshInstanceRecordStruct& Out_Record) const;
+
+	// Returns INDEX_NONE if none of the records has given tag.
+	UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Instances")
+	int32 FindInstanceByTag(FName Tag) const;
+
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+class UMeshOps_InstancedMeshComponent;
+
+/*
+* Converts repeated parts of assemblies to instances.
+* Meshes are compared by a hash of every LOD 0 vertex stream, indices and section layout, so separately imported copies of the same part are grouped too. Hashes are cached per mesh.
+* A hash only finds candidates. Meshes with equal hashes are compared byte by byte before they are treated as the same geometry.
+*/
+class MESHOPERATIONS_API FMeshOps_Instancing
+{
+
+public:
+
+    // Falls back to hash of mesh object if CPU mesh data isn't available. Then only components with the same mesh asset are grouped.
+    static uint64 GetGeometryHash(const UStaticMesh* StaticMesh);
+
+    // Compares positions, tangents, UVs, colors, indices and sections of LOD 0. Meshes without CPU data are only same with themselves.
+    static bool HasSameGeometry(const UStaticMesh* A, const UStaticMesh* B);
+
+    // Computes hashes of all meshes which aren't cached yet in parallel.
+    static void PrecacheGeometryHashes(TArrayView<const UStaticMesh* const> StaticMeshes);
+
+    static void ResetCache();
+
+    // Groups components by geometry and materials. Groups smaller than MinInstances aren't returned.
+    static void GroupComponents(TArrayView<UStaticMeshComponent* const> Components, bool bMatchGeometry, int32 MinInstances, TArray<TArray<UStaticMeshComponent*>>& Out_Groups);
+
+    /*
+    * Replaces each group with one instanced component attached to asset root and destroys grouped components. Names and tags of them are kept as instance records.
+    * Components with children are skipped. Returns number of replaced components.
+    */
+    static int32 ConvertToInstances(USceneComponent* AssetRoot, bool bMatchGeometry, int32 MinInstances, TArray<UMeshOps_InstancedMeshComponent*>& Out_Instanced);
+
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+
+/*
+* Plain mesh buffers which can be filled on any thread.
+* Triangles of each section are contiguous in Indices.
+*/
+struct MESHOPERATIONS_API FMeshOps_MeshBuffers
+{
+    struct FSection
+    {
+        int32 MaterialIndex = 0;
+        uint32 FirstIndex = 0;
+        uint32 NumTriangles = 0;
+        uint32 MinVertexIndex = 0;
+        uint32 MaxVertexIndex = 0;
+    };
+
+    TArray<FVector3f> Positions;
+    TArray<FVector3f> Normals;
+    TArray<FVector3f> Tangents;
+    // Binormal is cross(normal, tangent) times sign. Empty means every sign is 1.
+    TArray<float> TangentSigns;
+    TArray<FVector2f> UVs;
+    TArray<uint32> Indices;
+    TArray<FSection> Sections;
+
+    int32 GetNumVertices() const { return this->Positions.Num(); }
+
+    // Attributes have to match positions and each section has to be inside of the index buffer.
+    bool IsValid() const;
+
+    void Reset();
+
+    // Adds one section covering all indices.
+    void AddSingleSection(int32 MaterialIndex = 0);
+};
+
+/*
+* Builds static meshes directly from render data without mesh descriptions, so it works in packaged builds and it is much faster than building from descriptions.
+*/
+class MESHOPERATIONS_API FMeshOps_MeshBuilder
+{
+
+public:
+
+    enum class ECollisionType : uint8
+    {
+        None,
+        Box,
+        BoxAndConvex,
+        ComplexAsSimple,
+    };
+
+    /*
+    * Each element of LODs is one level of detail. LOD 0 is the base mesh.
+    * Screen sizes are optional. Missing ones are halved for each level.
+    * Creates UObjects, so it has to be called on game thread.
+    */
+    static UStaticMesh* BuildStaticMesh(FName Mesh_Name, TArrayView<const FMeshOps_MeshBuffers> LODs, TArrayView<UMaterialInterface* const> Materials, ECollisionType CollisionType, bool bSupportRayTracing, TArrayView<const float> ScreenSizes = TArrayView<const float>());
+
+    /*
+    * Building blocks of BuildStaticMesh for other sources of render data, like mesh cache files.
+    * CreateStaticMesh allocates empty LOD resources. They have to be filled before FinalizeStaticMesh initializes resources and collision.
+    */
+    static UStaticMesh* CreateStaticMesh(FName Mesh_Name, int32 NumLODs, int32 NumMaterials, TArrayView<UMaterialInterface* const> Materials, bool bSupportRayTracing);
+    static void FinalizeStaticMesh(UStaticMesh* StaticMesh, const FBox& BoundingBox, ECollisionType CollisionType, TArrayView<const FVector3f> ConvexPoints);
+
+    // Every generated mesh names its slots with this, so a mesh loaded from cache has the same slots as a freshly built one.
+    static FName GetMaterialSlotName(int32 MaterialIndex);
+
+    // Reads render data of given LOD. Returns false if CPU copies of mesh buffers aren't available.
+    static bool ReadStaticMesh(const UStaticMesh* StaticMesh, int32 LOD_Index, FMeshOps_MeshBuffers& Out_Buffers);
+
+    /*
+    * Vertex clustering simplification. Vertices in the same grid cell which face the same main axis are merged and collapsed triangles are removed.
+    * Sections are kept, so materials don't change between levels.
+    */
+    static void SimplifyByClustering(const FMeshOps_MeshBuffers& Source, double CellSize, FMeshOps_MeshBuffers& Out_Simplified);
+
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MeshOps_MeshBuilder.h"
+
+class UStaticMesh;
+
+/*
+* Binary cache of generated static meshes, so same meshes aren't rebuilt in every session.
+* Each file holds LOD 0 render data of one mesh. Vertex and index streams are aligned and they have the same layout with FStaticMeshLODResources, so files are memory mapped and copied straight into render buffers.
+* Files are keyed by a hash of generator inputs. A file written by another cache version or for another key is ignored and rebuilt.
+* Files are written on worker threads and least recently used files are deleted when the directory grows over its size limit.
+*/
+class MESHOPERATIONS_API FMeshOps_MeshCache
+{
+
+public:
+
+    // Generator name is a part of the key, so different generators never share a file with same inputs.
+    static uint64 MakeKey(const TCHAR* Generator, std::initializer_list<TArrayView<const uint8>> Inputs);
+
+    template<typename T>
+    static TArrayView<const uint8> AsBytes(const TArray<T>& Array)
+    {
+        return TArrayView<const uint8>((const uint8*)Array.GetData(), Array.Num() * sizeof(T));
+    }
+
+    static FString GetCacheDirectory();
+
+    // Returns nullptr if there is no valid file for the key. Game thread only.
+    static UStaticMesh* Load(FName Mesh_Name, uint64 Key, bool bSupportRayTracing);
+
+    // Copies LOD 0 of the mesh on game thread and writes it on a worker thread. Returns false if mesh can't be cached. Mesh needs CPU copies of its buffers, which meshes of generators always have.
+    static bool Save(const UStaticMesh* StaticMesh, uint64 Key, FMeshOps_MeshBuilder::ECollisionType CollisionType);
+
+    // Deletes every cache file.
+    static void Reset();
+
+};
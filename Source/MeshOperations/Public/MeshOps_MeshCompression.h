@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Vertex order optimization and EXT_meshopt_compression codecs.
+* Encoders write the same bitstreams with meshoptimizer (vertex codec version 0, index codec version 1), so any viewer which supports the extension can decode them.
+* All functions work on plain arrays and can run on any thread.
+*/
+class MESHOPERATIONS_API FMeshOps_MeshCompression
+{
+
+public:
+
+    // Tipsify. Reorders triangles of a triangle list for post transform vertex cache. Vertices aren't touched.
+    static void OptimizeVertexCache(TArrayView<uint32> Indices, int32 NumVertices, int32 CacheSize = 16);
+
+    /*
+    * Renumbers vertices in order of first use, so vertex fetch is linear and neighbouring vertices are similar for delta encoding.
+    * Unused vertices are dropped. Out_NewToOld maps each new vertex to the old one and it is used with RemapVertices.
+    */
+    static void OptimizeVertexFetch(TArrayView<uint32> Indices, int32 NumVertices, TArray<int32>& Out_NewToOld);
+
+    template<typename T>
+    static void RemapVertices(TArray<T>& Attributes, const TArray<int32>& NewToOld)
+    {
+        TArray<T> Remapped;
+        Remapped.SetNumUninitialized(NewToOld.Num());
+
+        for (int32 VertexIndex = 0; VertexIndex < NewToOld.Num(); VertexIndex++)
+        {
+            Remapped[VertexIndex] = Attributes[NewToOld[VertexIndex]];
+        }
+
+        Attributes = MoveTemp(Remapped);
+    }
+
+    // ATTRIBUTES mode. Vertex size has to be a multiple of 4 and at most 256 bytes.
+    static bool EncodeVertexBuffer(const void* Vertices, int32 NumVertices, int32 VertexSize, TArray<uint8>& Out_Encoded);
+
+    // TRIANGLES mode. Decoded index size is chosen by the byte stride of the buffer view, so the same stream works for 16 and 32 bit indices.
+    static bool EncodeIndexBuffer(TArrayView<const uint32> Indices, int32 NumVertices, TArray<uint8>& Out_Encoded);
+
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+#include "MeshOps_Structs.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/*
+* Bakes static meshes of a subtree to one static mesh with one section per unique material.
+* Source meshes are read once per unique mesh and all parts are transformed to preallocated buffers in parallel. Result is built on render data path, so it works in packaged builds.
+*/
+class MESHOPERATIONS_API FMeshOps_MeshMerge
+{
+
+public:
+
+    // Components whose meshes don't allow CPU access in packaged builds are skipped. Out_Merged only has merged ones.
+    static UStaticMesh* MergeSubtree(USceneComponent* AssetRoot, FName Mesh_Name, const FMeshMergeOptionsStruct& Options, TArray<UStaticMeshComponent*>& Out_Merged);
+
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "MeshOps_SpatialIndex.generated.h"
+
+/*
+* Bounding volume hierarchy over item boxes.
+* It is built with binned SAH and stored as a flat node array. Nodes are created depth first, so children always come after their parent.
+* Moving items only refits their leaf to root path. Quality of the tree drops if items move far, rebuild it after big changes.
+*/
+class MESHOPERATIONS_API FMeshOps_BVH
+{
+
+public:
+
+    struct FNode
+    {
+        FBox Box = FBox(ForceInit);
+        int32 Parent = INDEX_NONE;
+
+        // Inner nodes.
+        int32 Left = INDEX_NONE;
+        int32 Right = INDEX_NONE;
+
+        // Leaves: range in ItemOrder.
+        int32 FirstItem = 0;
+        int32 NumItems = 0;
+
+        bool IsLeaf() const { return NumItems > 0; }
+    };
+
+    void Build(TArrayView<const FBox> Boxes);
+
+    // Changes box of an item and refits the path from its leaf to the root.
+    void UpdateItem(int32 ItemIndex, const FBox& NewBox);
+
+    void QueryOverlap(const FBox& Box, TArray<int32>& Out_Items) const;
+
+    // Items sorted by squared distance from point to their boxes.
+    void QueryNearest(const FVector& Point, int32 Count, TArray<int32>& Out_Items, TArray<double>& Out_DistancesSquared) const;
+
+    /*
+    * Front to back traversal. Callback receives an item whose box is hit closer than the current best hit and returns exact hit distance or a negative value to reject it.
+    * Returns item of the closest accepted hit or INDEX_NONE.
+    */
+    int32 Raycast(const FVector& Start, const FVector& End, TFunctionRef<double(int32 ItemIndex, double BoxDistance)> HitCallback, double& Out_Distance) const;
+
+    int32 GetNumItems() const { return this->ItemBoxes.Num(); }
+
+    const FBox& GetItemBox(int32 ItemIndex) const { return this->ItemBoxes[ItemIndex]; }
+
+    bool IsEmpty() const { return this->Nodes.IsEmpty(); }
+
+private:
+
+    TArray<FNode> Nodes;
+    TArray<FBox> ItemBoxes;
+    TArray<int32> ItemOrder;
+    TArray<int32> ItemLeaves;
+
+    int32 BuildRecursive(int32 Parent, int32 First, int32 Count, TArray<FVector>& Centers);
+    void RefitLeaf(int32 NodeIndex);
+
+};
+
+UCLASS(BlueprintType)
+class MESHOPERATIONS_API UMeshOps_SpatialIndex : public UObject
+{
+	GENERATED_BODY()
+
+private:
+
+    FMeshOps_BVH BVH;
+
+    TWeakObjectPtr<USceneComponent> Root;
+    bool bIsOnlyStaticMeshes = true;
+    bool bIsAutoRefit = true;
+
+    TArray<TWeakObjectPtr<UPrimitiveComponent>> Items;
+    TArray<FDelegateHandle> TransformHandles;
+    TMap<const USceneComponent*, int32> ItemIndices;
+    TSet<int32> DirtyItems;
+
+    // Collects primitive descendants of root again and binds their transform events.
+    void Gather();
+    void UnbindItems();
+    void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+    void GetResults(const TArray<int32>& Results, TArray<UPrimitiveComponent*>& Out_Components) const;
+
+public:
+
+    virtual void BeginDestroy() override;
+
+    // Collects primitive descendants of asset root and builds the tree from their bounds.
+    bool Initialize(USceneComponent* AssetRoot, bool bOnlyStaticMeshes, bool bAutoRefit);
+
+    // Collects components from the root again and builds a new tree. Use it after attaching or detaching components or after big moves.
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    void Rebuild();
+
+    // Applies moved components to the tree. Queries call it automatically.
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    void Refit();
+
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    void QueryOverlap(FVector In_Origin, FVector In_Extent, TArray<UPrimitiveComponent*>& Out_Components);
+
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    void QueryNearest(FVector Location, int32 Count, TArray<UPrimitiveComponent*>& Out_Components, TArray<double>& Out_Distances);
+
+    /*
+    * If bTraceComplex is false, hit is tested against component bounds. Otherwise candidates are traced with their collision in front to back order.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    bool Raycast(FVector Start, FVector End, bool bTraceComplex, UPrimitiveComponent*& Out_Component, FVector& Out_Location, double& Out_Distance);
+
+    UFUNCTION(BlueprintPure, Category = "Frozen Forest|Mesh Operations|Spatial Index")
+    int32 GetNumItems() const;
+
+    const FMeshOps_BVH& GetBVH() const { return this->BVH; }
+
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Batched containment tests.
+* Inputs are converted to float structure of arrays relative to the bounds center, so four points are compared per vector instruction without losing precision in large worlds.
+* Results are bitsets. Chunks are multiples of 32 elements, so each worker writes its own words of the bitset.
+* Inside means strictly inside, same as FBox::IsInside and IsInBounds.
+*/
+class MESHOPERATIONS_API FMeshOps_SpatialQueries
+{
+
+public:
+
+    static void PointsInBox(TArrayView<const FVector> Points, const FBox& Bounds, TBitArray<>& Out_Inside);
+
+    // Index of the first bounds which contains each point. INDEX_NONE if none of them contains it.
+    static void PointsInBoxes(TArrayView<const FVector> Points, TArrayView<const FBox> Bounds, TArray<int32>& Out_BoundsIndices);
+
+    // If bFullyInside is false, intersecting boxes are accepted too.
+    static void BoxesInBox(TArrayView<const FBox> Boxes, const FBox& Bounds, bool bFullyInside, TBitArray<>& Out_Result);
+
+    static void BitsToIndices(const TBitArray<>& Bits, bool bValue, TArray<int32>& Out_Indices);
+
+};
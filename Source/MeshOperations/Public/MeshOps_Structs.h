@@ -1,8 +1,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+#include "MeshOps_Enums.h"
+
 #include "MeshOps_Structs.generated.h"
 
+class AActor;
+class USceneComponent;
+class UMaterialInterface;
+
 USTRUCT(BlueprintType)
 struct MESHOPERATIONS_API FGLTFExportOptionsStruct
 {
@@ -157,4 +164,284 @@ public:
 	/** Mode determining if and how to export material variants that change the materials property on a static or skeletal mesh component. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "VariantSetsMode != EGLTFVariantSetsMode::None"))
 	EGLTFMaterialVariantMode ExportMaterialVariants;
-};
\ No newline at end of file
+
+	/** Async export only. Binary data is split into another buffer file when current one exceeds this size. 0 writes a single buffer. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0", Units = "Megabytes"))
+	int32 Max_Buffer_Size = 0;
+
+	/** Async export only. Reorders and compresses geometry with EXT_meshopt_compression. Compressed geometry is only shown by viewers which support the extension. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bUseMeshCompression = false;
+
+	/** Async export only. Meshes with identical geometry and materials with identical factors are written once, even if they are different assets. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDeduplicateMeshes = true;
+
+	/** Async export only. Sibling leaf nodes with the same mesh are written as one node with EXT_mesh_gpu_instancing. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bUseGPUInstancing = false;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FGLTFExportStatsStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Meshes without CPU data aren't counted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Num_Meshes = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Num_Nodes = 0;
+
+	/** Nodes written with EXT_mesh_gpu_instancing. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Num_Instance_Groups = 0;
+
+	/** Meshes taken from batch cache instead of being converted again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Num_Reused_Meshes = 0;
+
+	/** Size of geometry buffers before compression in bytes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 Raw_Size = 0;
+
+	/** Size of written buffers in bytes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 Buffer_Size = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double Compression_Ratio = 1.0;
+
+	/** Seconds spent in reordering and encoding, summed over worker threads. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double Encode_Time = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double Total_Time = 0.0;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FGLTFExportJobStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<AActor*> Target_Actors;
+
+	/** .glb writes a single binary file. Other extensions write .gltf with a .bin file. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Export_Path;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FGLTFExportJobResultStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Export_Path;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bIsSuccessful = false;
+
+	/** Error message of failed jobs. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Message;
+
+	/** Seconds spent on game thread while copying the level. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	double Snapshot_Time = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGLTFExportStatsStruct Stats;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FGLTFImportOptionsStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Scale factor used for importing all assets (100 by default) for conversion from meters (glTF) to centimeters (Unreal default). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ImportUniformScale = 100.f;
+
+	/** Parent of dynamic material instances created for glTF materials. Material factors are written to parameters below. If it is empty, meshes use default material. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	UMaterialInterface* Base_Material = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName BaseColor_Parameter = TEXT("BaseColor");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Metallic_Parameter = TEXT("Metallic");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Roughness_Parameter = TEXT("Roughness");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Emissive_Parameter = TEXT("Emissive");
+
+	/** Adds box and convex collision to each imported mesh. It is off by default, because building convex hulls dominates import time of large assemblies. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCreateCollision = false;
+
+	/** Game thread time in milliseconds which is spent on creating meshes and components per frame. At least one mesh or component is created each frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Build_Budget_Ms = 5.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSupportRayTracing = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TEnumAsByte<EComponentMobility::Type> Mobility = EComponentMobility::Movable;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FOrientedBoxStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Center = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Half size along local axes of the box. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Extent = FVector::ZeroVector;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FAssemblyCheckOptionsStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Component locations outside of the assembly bounds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckOutOfBounds = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckZeroScale = true;
+
+	/** Static mesh components without mesh, render data or triangles and meshes which are flat in two axes or mostly made of zero area triangles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckMeshes = true;
+
+	/** Static mesh components which use the same mesh with the same world transform as another component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckDuplicates = true;
+
+	/** First tag has to contain Product_Name and second tag has to contain Instance_Name. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckMissingTags = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckSingleChildChains = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0"))
+	double ZeroScaleTolerance = 0.0001;
+
+	/** Maximum location difference in centimeters. Rotation and scale have to be nearly equal. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0"))
+	double DuplicateTolerance = 0.1;
+
+	/** Ratio of zero area triangles to report a mesh as degenerate. Requires CPU access to mesh data in packaged builds. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0", ClampMax = "1"))
+	double DegenerateTriangleRatio = 0.5;
+
+	/** Chains of components with exactly one child which are longer than this are reported. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "1"))
+	int32 MaxSingleChildChain = 4;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FAssemblyCheckIssueStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAssemblyCheckType Type = EAssemblyCheckType::OutOfBounds;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAssemblyCheckSeverity Severity = EAssemblyCheckSeverity::Warning;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	USceneComponent* Component = nullptr;
+
+	/** Second component of the issue. For example, original of a duplicate instance or last component of a single child chain. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	USceneComponent* Related_Component = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Message;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FMeshInstanceRecordStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Name of the static mesh component which was replaced by this instance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Source_Name;
+
+	/** Component tags of the replaced component. First one is product name and second one is instance name. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> Tags;
+};
+
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FMeshMergeOptionsStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If disabled, vertices are baked relative to the merged root, so the merged mesh can be placed at the root transform. World space loses precision far from origin. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWorldSpace = false;
+
+	/** Instances of instanced static mesh components are merged too. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bIncludeInstances = true;
+
+	/** Number of levels of detail including the base mesh. Extra levels are generated with vertex clustering. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "1", ClampMax = "8"))
+	int32 NumLODs = 1;
+
+	/** Cluster size of the first generated level relative to the largest side of merged bounds. It is doubled for each next level. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0.0001", ClampMax = "1", EditCondition = "NumLODs > 1"))
+	float LOD_Reduction = 0.01f;
+
+	/** Adds a box collision around merged mesh. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCreateCollision = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSupportRayTracing = false;
+
+	/** Merged components are hidden after merge. They aren't destroyed, so merge can be reverted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHideSourceComponents = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+#include "MeshOps_Structs.h"
+
+class UStaticMesh;
+
+/*
+* Vertex exact bounds.
+* Convex hull of each unique mesh is computed once and cached. Exact AABB of a mesh under an affine transform is the AABB of its transformed hull, so each instance only transforms a few hull points instead of the whole vertex buffer.
+*/
+class MESHOPERATIONS_API FMeshOps_TightBounds
+{
+
+public:
+
+    struct FMeshHull
+    {
+        // W is unused. Points are padded to 16 bytes for vector loads.
+        TArray<FVector4f> Points;
+
+        // False if CPU vertex data wasn't available and hull is made of local bounding box corners.
+        bool bIsExact = false;
+    };
+
+    // Returns cached hull of given mesh LOD. It is computed at first call and again after mesh is rebuilt. Hulls of destroyed meshes are purged.
+    static TSharedPtr<const FMeshHull> GetMeshHull(const UStaticMesh* StaticMesh, int32 LOD_Index = 0);
+
+    // Computes hulls of all meshes which aren't cached yet in parallel.
+    static void PrecacheMeshHulls(TArrayView<const UStaticMesh* const> StaticMeshes, int32 LOD_Index = 0);
+
+    static void ResetCache();
+
+    static FBox TransformHullBox(const FMeshHull& Hull, const FTransform& Transform);
+
+    static void TransformHullPoints(const FMeshHull& Hull, const FTransform& Transform, TArray<FVector>& Out_Points);
+
+    // Minimum volume box. PCA axes and world axes are used as candidate up vectors and each candidate is refined with rotating calipers on the projected 2D hull.
+    static bool ComputeOrientedBox(TArrayView<const FVector> Points, FOrientedBoxStruct& Out_Box);
+
+    // Same hierarchy semantics with GetSceneComponentBounds. Target itself is not included.
+    static bool GetExactBounds(USceneComponent* Target, FBox& Out_Box);
+
+    static bool GetOrientedBounds(USceneComponent* Target, FOrientedBoxStruct& Out_Box);
+
+};
@@ -5,9 +5,18 @@
 #include "Runtime/UMG/Public/UMG.h"
 
 #include "Widgets/Widget_TreeView_Item.h"
+#include "Widgets/Widget_TreeView_Index.h"
 
 #include "Widget_TreeView.generated.h"
 
+class UStaticMesh;
+class FTreeView_Stats;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDelegateTreeViewSelection, USceneComponent*, Selected_Component);
+
+// Matches are sent to game thread in batches, so highlights grow while search still runs.
+#define TREEVIEW_SEARCH_CHUNK 4096
+
 UCLASS()
 class MESHOPERATIONS_API UWidget_TreeView : public UUserWidget
 {
@@ -15,10 +24,74 @@ class MESHOPERATIONS_API UWidget_TreeView : public UUserWidget
 	
 private:
 
-	TMap<USceneComponent*, TArray<USceneComponent*>> MatchingComponents;
+	// Matches in hierarchy order.
+	TArray<FTreeView_Match> Search_Matches;
+	TArray<int32> Match_Ancestors;
+
+	// Search tasks keep a reference to the index they run on. Index is copied before changes if a task still uses it.
+	TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> SearchIndex = MakeShared<FTreeView_Index, ESPMode::ThreadSafe>();
+
+	// Shared with search tasks. Every new search or clear increments it, so stale tasks stop and their results are ignored.
+	TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> Search_Generation = MakeShared<std::atomic<uint32>, ESPMode::ThreadSafe>(0);
+
+	FString Pending_Search;
+	double Pending_Search_Time = 0;
+	bool bIsSearchPending = false;
+
+	FTreeView_Index& GetMutableIndex();
+
+	virtual void StartSearch(const FString& Query);
+
+	virtual void ReceiveSearchResults(uint32 Generation, const TArray<int32>& Matches);
+
+	UTreeView_Data* GetMatchData(int32 Match_Index);
 
+	// Moves current highlight from previous match to the given one. Only these two rows are updated.
+	virtual void FocusMatch(int32 Match_Index);
+
+	virtual void ApplyRowHighlight(UTreeView_Data* Data);
+
+	virtual void UpdateMatchCounter();
+
+	// Row objects by entry id. Rows of collapsed subtrees are evicted, so this only holds rows which tree view can show.
 	UPROPERTY()
-	TMap<USceneComponent*, UTreeView_Data*> DataCache;
+	TMap<int32, UTreeView_Data*> DataCache;
+
+	// Evicted rows are kept alive until tree view drops them from its own lists.
+	UPROPERTY()
+	TArray<UTreeView_Data*> Evicted_Data;
+
+	uint64 Evicted_Frame = 0;
+
+	FDelegateHandle Hierarchy_Changed_Handle;
+
+	// Every new snapshot increments it, so an outline which finishes loading later doesn't replace it.
+	uint32 Outline_Request = 0;
+
+	// Clears rows, selection and search of current snapshot and replaces it.
+	void ResetSnapshot(TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> New_Index);
+
+	// Results of the last finished stats task. Entries which are added after it don't have stats until the next one.
+	TSharedPtr<FTreeView_Stats, ESPMode::ThreadSafe> Stats;
+
+	uint32 Stats_Request = 0;
+	bool bIsStatsDirty = false;
+
+	void StartStats();
+
+	void ReceiveStats(uint32 Request, TSharedRef<FTreeView_Stats, ESPMode::ThreadSafe> New_Stats);
+
+	void ReceiveOutline(uint32 Request, TSharedRef<FTreeView_Index, ESPMode::ThreadSafe> New_Index, const TArray<int32>& Roots);
+
+	TArray<FTreeView_Node> Nodes;
+
+	// Original custom depth state of primitives which are highlighted in viewport, keyed by entry id.
+	TMap<int32, FTreeView_Stencil> Stencil_Backup;
+
+	// Entries which are in subtree of a search match.
+	TBitArray<> Match_Covered;
+
+	int32 Selected_Entry = INDEX_NONE;
 
 	UPROPERTY()
 	TArray<USceneComponent*> AssemblyRoots;
@@ -35,7 +108,34 @@ private:
 	static FString GetEnumDisplayName(EHierarchyNames In_Enum);
 
 	UFUNCTION()
-	UTreeView_Data* GetOrCreateData(USceneComponent* InComponent, int32 InDepth);
+	UTreeView_Data* GetOrCreateData(int32 Entry_Id);
+
+	void SetNodeHighlight(int32 Entry_Id, bool bIsHighlighted, bool bIsCurrentHighlight);
+
+	void EvictSubtree(int32 Entry_Id);
+
+	void EvictAllData();
+
+	void HandleExpansionChanged(UObject* Item, bool bIsExpanded);
+
+	void HandleSelectionChanged(UObject* Item);
+
+	// Only children of changed parent are compared with the index. Other branches, their rows and ids aren't touched.
+	void HandleHierarchyChanged(USceneComponent* Changed_Parent);
+
+	void SelectEntry(int32 Entry_Id);
+
+	// Expands ancestors by walking parent ids and scrolls to the row.
+	UTreeView_Data* RevealEntry(int32 Entry_Id);
+
+	void HighlightMatchInViewport(int32 Entry_Id);
+
+	// Selected subtree gets selection stencil, subtrees of matches get match stencil and others get their original state back.
+	void UpdateViewportStencil(int32 Subtree_Root);
+
+	void RestoreStencil(int32 Entry_Id);
+
+	void ClearViewportHighlights();
 
 	UFUNCTION()
 	virtual void HandleGetChildren(UObject* Item, TArray<UObject*>& OutChildren);
@@ -52,6 +152,9 @@ private:
 	UFUNCTION()
 	virtual void ClearSearchResults();
 
+	UFUNCTION()
+	virtual void On_Search_Changed(const FText& SearchText);
+
 	UFUNCTION()
 	virtual void On_Search_Committed(const FText& SearchText, ETextCommit::Type CommitMethod);
 
@@ -81,6 +184,82 @@ public:
 	UFUNCTION(BlueprintPure)
 	virtual bool IsHierarchyEmpty() const;
 
+	// Shows a file of Export Hierarchy Outline. It is loaded and indexed in background and nothing is spawned. Returns false if file doesn't exist.
+	UFUNCTION(BlueprintCallable)
+	virtual bool OpenHierarchyOutline(const FString& File_Path);
+
+	// Returns false if selected row isn't from an outline. Mesh isn't loaded.
+	UFUNCTION(BlueprintCallable)
+	virtual bool GetSelectedOutlineNode(FString& Out_Name, TArray<FName>& Out_Tags, FBox& Out_Bounds, TSoftObjectPtr<UStaticMesh>& Out_Mesh) const;
+
+	// Zero based index of search result to focus. Returns false if there is no such result.
+	UFUNCTION(BlueprintCallable)
+	virtual bool JumpToMatch(int32 Match_Index);
+
+	UFUNCTION(BlueprintPure)
+	virtual int32 GetNumMatches() const;
+
+	// Search starts after user stops typing for this long. Enter starts it immediately.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float Search_Delay = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ETreeViewSearchMode Search_Mode = ETreeViewSearchMode::Contains;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ETreeViewSearchSort Search_Sort = ETreeViewSearchSort::Hierarchy;
+
+	// Searches object, product and instance names together instead of the selected search type.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSearchAnyField = false;
+
+	// Selects component in tree view. Viewport selection calls this, so tree follows it. Returns false if component isn't in the hierarchy.
+	UFUNCTION(BlueprintCallable)
+	virtual bool SelectComponent(USceneComponent* InComponent);
+
+	// Expands parents of the component and scrolls to it without changing selection.
+	UFUNCTION(BlueprintCallable)
+	virtual bool RevealComponent(USceneComponent* InComponent);
+
+	UFUNCTION(BlueprintPure)
+	virtual USceneComponent* GetSelectedComponent() const;
+
+	// Called when selection changes from tree view or SelectComponent. Viewport selection binds to this.
+	UPROPERTY(BlueprintAssignable)
+	FDelegateTreeViewSelection OnComponentSelected;
+
+	// Primitives of matches and selection are drawn to custom depth with these stencil values, so a post process like MAT_Pixel_Depth can outline them.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bHighlightInViewport = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "255"))
+	int32 Match_Stencil = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "255"))
+	int32 Selected_Stencil = 2;
+
+	// Component count, triangles, unique meshes, draw calls and memory of every subtree are computed in background after hierarchy changes.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bComputeStats = true;
+
+	// Children are listed heaviest first by this stat. None keeps hierarchy order.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	ETreeViewStatsSort Stats_Sort = ETreeViewStatsSort::None;
+
+	UFUNCTION(BlueprintCallable)
+	virtual void SetStatsSort(ETreeViewStatsSort In_Sort);
+
+	// Returns false if component isn't in the hierarchy or its stats aren't ready yet.
+	UFUNCTION(BlueprintCallable)
+	virtual bool GetSubtreeStats(USceneComponent* InComponent, FTreeViewStatsStruct& Out_Stats) const;
+
+	UFUNCTION(BlueprintCallable)
+	virtual bool GetSelectedStats(FTreeViewStatsStruct& Out_Stats) const;
+
+	// Changes search options and runs current search text again.
+	UFUNCTION(BlueprintCallable)
+	virtual void SetSearchOptions(ETreeViewSearchMode In_Mode, ETreeViewSearchSort In_Sort, bool bIn_AnyField);
+
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	UCanvasPanel* Canvas_Panel = nullptr;
 
@@ -6,6 +6,31 @@
 
 #include "Widget_TreeView_Data.generated.h"
 
+// Totals of a component and all of its descendants. Draw calls are an estimate of one draw per mesh section, instanced components draw all of their instances at once.
+USTRUCT(BlueprintType)
+struct MESHOPERATIONS_API FTreeViewStatsStruct
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Components = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Triangles = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Unique_Meshes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Draw_Calls = 0;
+
+	// Estimated CPU and GPU memory of unique static meshes in bytes.
+	UPROPERTY(BlueprintReadOnly)
+	int64 Memory = 0;
+};
+
 UCLASS(BlueprintType)
 class MESHOPERATIONS_API UTreeView_Data : public UObject
 {
@@ -16,9 +41,17 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 	USceneComponent* Target_Component;
 
+	// Id of the component in hierarchy snapshot of owning tree view.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Entry_Id = INDEX_NONE;
+
 	UPROPERTY(BlueprintReadWrite)
 	int32 Padding_Depth = 0;
 
+	// Rows of hierarchy outlines don't have components, so expand button uses this instead of attached children.
+	UPROPERTY(BlueprintReadWrite)
+	bool bHasChildren = false;
+
 	UPROPERTY(BlueprintReadWrite)
 	bool bIsHighlighted = false;
 
@@ -28,4 +61,14 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 	EHierarchyNames NameType = EHierarchyNames::Product;
 
+	UPROPERTY(BlueprintReadOnly)
+	bool bHasStats = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	FTreeViewStatsStruct Stats;
+
+	// Display name of the component for current name type. It is copied from hierarchy snapshot.
+	UPROPERTY(BlueprintReadWrite)
+	FText Title;
+
 };
\ No newline at end of file
@@ -11,4 +11,33 @@ enum class EHierarchyNames : uint8
 	Product = 2		UMETA(DisplayName = "Product"),
 	Instance = 3	UMETA(DisplayName = "Instance"),
 };
-ENUM_CLASS_FLAGS(EHierarchyNames)
\ No newline at end of file
+ENUM_CLASS_FLAGS(EHierarchyNames)
+
+UENUM(BlueprintType)
+enum class ETreeViewSearchMode : uint8
+{
+	Contains = 0	UMETA(DisplayName = "Contains"),
+	WholeWord = 1	UMETA(DisplayName = "Whole Word"),
+	Wildcard = 2	UMETA(DisplayName = "Wildcard"),
+	Regex = 3		UMETA(DisplayName = "Regex"),
+	Fuzzy = 4		UMETA(DisplayName = "Fuzzy"),
+};
+
+UENUM(BlueprintType)
+enum class ETreeViewSearchSort : uint8
+{
+	Hierarchy = 0	UMETA(DisplayName = "Hierarchy"),
+	Rank = 1		UMETA(DisplayName = "Rank"),
+	Depth = 2		UMETA(DisplayName = "Depth"),
+};
+
+UENUM(BlueprintType)
+enum class ETreeViewStatsSort : uint8
+{
+	None = 0			UMETA(DisplayName = "None"),
+	Components = 1		UMETA(DisplayName = "Components"),
+	Triangles = 2		UMETA(DisplayName = "Triangles"),
+	Unique_Meshes = 3	UMETA(DisplayName = "Unique Meshes"),
+	Draw_Calls = 4		UMETA(DisplayName = "Draw Calls"),
+	Memory = 5			UMETA(DisplayName = "Memory"),
+};
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MeshOps_HierarchyOutline.h"
+#include "Widgets/Widget_TreeView_Enums.h"
+
+class USceneComponent;
+class UPrimitiveComponent;
+class UMeshOps_InstancedMeshComponent;
+
+// Object, Product and Instance names are indexed. None isn't searchable.
+#define TREEVIEW_NUM_NAME_TYPES 3
+
+// All modes are case insensitive. Any field searches object, product and instance names together and keeps the best rank of them.
+struct FTreeView_Query
+{
+	FString Text;
+	EHierarchyNames NameType = EHierarchyNames::Product;
+	ETreeViewSearchMode Mode = ETreeViewSearchMode::Contains;
+	ETreeViewSearchSort Sort = ETreeViewSearchSort::Hierarchy;
+	bool bAnyField = false;
+};
+
+// Search result of tree view. Ancestor entries are kept root first in a shared array, so focusing a match doesn't walk the hierarchy.
+struct FTreeView_Match
+{
+	int32 Entry = INDEX_NONE;
+	int32 Ancestors_Start = 0;
+	int32 Ancestors_Num = 0;
+};
+
+// Row state of every index entry. Row objects are only created for rows which tree view asks for and they copy this state.
+struct FTreeView_Node
+{
+	bool bIsHighlighted = false;
+	bool bIsCurrentHighlight = false;
+};
+
+// Custom depth state of a primitive before tree view highlighted it in viewport.
+struct FTreeView_Stencil
+{
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+	bool bRenderCustomDepth = false;
+	int32 Stencil = 0;
+};
+
+/*
+* Flat snapshot of the hierarchies shown in tree view with a trigram index for each name type.
+* Entries are added in depth first order and ids only grow, so posting lists stay sorted without extra work. Ids follow hierarchy order until branches are changed.
+* Children are linked lists of ids. Changed branches are removed and added again without touching other entries. Removed entries stay as tombstones, so ids are never reused.
+* Names are lower case, so searches are case insensitive like FString::Contains.
+* Hierarchy outlines are indexed like components, so exported assemblies are browsed and searched without being spawned.
+* Instance records of instanced components are indexed as their children, so parts which are converted to instances are still listed and searchable.
+*/
+class MESHOPERATIONS_API FTreeView_Index
+{
+
+public:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		int32 Parent = INDEX_NONE;
+		int32 Depth = 0;
+		int32 FirstChild = INDEX_NONE;
+		int32 LastChild = INDEX_NONE;
+		int32 NextSibling = INDEX_NONE;
+		// Entries of outlines don't have components. They point to their node in outline instead.
+		int32 Outline = INDEX_NONE;
+		int32 Outline_Node = INDEX_NONE;
+		// Instances of converted parts are children of their instanced component. They keep index of their record instead of a component.
+		int32 Instance_Record = INDEX_NONE;
+		bool bIsRemoved = false;
+	};
+
+	void Reset();
+
+	// Adds root and all of its children. Returns entry id of the root. Roots which are already indexed aren't added again.
+	int32 AddRoot(USceneComponent* Root);
+
+	// Adds every node of the outline without touching any UObject, so it can run on any thread with an index which isn't shared yet.
+	void AddOutline(const TSharedRef<const FMeshOps_HierarchyOutline, ESPMode::ThreadSafe>& Outline, TArray<int32>& Out_Roots);
+
+	// Returns nullptr for entries of components.
+	const FMeshOps_HierarchyOutline::FNode* GetOutlineNode(int32 EntryId) const;
+	const FMeshOps_HierarchyOutline* GetOutline(int32 EntryId) const;
+
+	// Compares indexed children of the entry with attached children of its component. Destroyed and detached branches are removed, new and moved ones are added.
+	void SyncChildren(int32 EntryId, TArray<int32>& Out_Removed, TArray<int32>& Out_Added);
+
+	// Entry and its descendants become tombstones.
+	void RemoveSubtree(int32 EntryId, TArray<int32>& Out_Removed);
+
+	// Entry ids of matching components in order of query.
+	void Search(const FTreeView_Query& Query, TArray<int32>& Out_Matches) const;
+
+	/*
+	* Passes matches to OnChunk in chunks. Chunks can be empty. Returning false from OnChunk stops the search.
+	* Single field searches in hierarchy order are streamed while candidates are verified. Others are sorted after every candidate is verified.
+	* It only reads names and trigrams, so it can run on any thread as long as the index isn't changed meanwhile.
+	*/
+	void Search(const FTreeView_Query& Query, int32 ChunkSize, TFunctionRef<bool(TArrayView<const int32>)> OnChunk) const;
+
+	// Parent entries of given entry, nearest first.
+	void GetAncestors(int32 EntryId, TArray<int32>& Out_Ancestors) const;
+
+	int32 Find(const USceneComponent* Component) const;
+
+	// Children are walked without any allocation. Both return INDEX_NONE when there is no more child.
+	int32 GetFirstChild(int32 EntryId) const;
+	int32 GetNextSibling(int32 EntryId) const;
+	bool HasChildren(int32 EntryId) const { return this->Entries[EntryId].FirstChild != INDEX_NONE; }
+
+	// Pre-order walk of a subtree. Start with subtree root itself and stop at INDEX_NONE.
+	int32 GetNextInSubtree(int32 EntryId, int32 SubtreeRoot) const;
+
+	// Walks parents, so it costs depth of the entry.
+	bool IsInSubtree(int32 EntryId, int32 SubtreeRoot) const;
+
+	int32 Num() const { return this->Entries.Num(); }
+	bool IsValidId(int32 EntryId) const { return this->Entries.IsValidIndex(EntryId); }
+	const FEntry& GetEntry(int32 EntryId) const { return this->Entries[EntryId]; }
+
+	// Titles of rows. They are created once per entry, so rows and name type changes only copy shared texts. None shows object names.
+	const FText& GetDisplayName(int32 EntryId, EHierarchyNames NameType) const;
+
+	static int32 GetTypeIndex(EHierarchyNames NameType);
+
+private:
+
+	TArray<FEntry> Entries;
+	// Weak keys stay unique after their component is destroyed, so tombstones can still be removed from the map.
+	TMap<TWeakObjectPtr<const USceneComponent>, int32> ComponentToEntry;
+
+	TArray<TSharedRef<const FMeshOps_HierarchyOutline, ESPMode::ThreadSafe>> Outlines;
+
+	TArray<FString> Names[TREEVIEW_NUM_NAME_TYPES];
+	TArray<FText> DisplayNames[TREEVIEW_NUM_NAME_TYPES];
+	TMap<uint64, TArray<int32>> Trigrams[TREEVIEW_NUM_NAME_TYPES];
+
+	// Names are added separately if component is nullptr.
+	int32 AddEntry(USceneComponent* Component, int32 Parent, int32 Depth);
+
+	void AddName(int32 EntryId, int32 TypeIndex, FString Raw_Name);
+
+	// One child entry for each instance record with its source name and tags.
+	void AddInstanceRecords(int32 EntryId, const UMeshOps_InstancedMeshComponent* Instanced);
+
+	// Adds component and its children under parent entry. Returns entry id of the component.
+	int32 AddSubtree(USceneComponent* Component, int32 Parent);
+
+	// Returns false if literals don't have any trigram, so every entry is a candidate.
+	bool GatherCandidates(int32 TypeIndex, const TArray<FString>& Literals, TArray<int32>& Out_Candidates) const;
+
+};
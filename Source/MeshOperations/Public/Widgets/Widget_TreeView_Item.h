@@ -28,9 +28,15 @@ private:
 	UFUNCTION()
 	virtual void UpdateTitle_Internal(UTreeView_Data* TreeView_Data);
 
+	UFUNCTION()
+	virtual void UpdateStats_Internal(UTreeView_Data* TreeView_Data);
+
 	UFUNCTION()
 	virtual void On_Expand_Children();
 
+	UFUNCTION()
+	virtual void On_Select_Item();
+
 	UFUNCTION()
 	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
 
@@ -50,6 +56,9 @@ public:
 	UFUNCTION()
 	virtual void UpdateTitle();
 
+	UFUNCTION()
+	virtual void UpdateStats();
+
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	UCanvasPanel* Main_Canvas = nullptr;
 
@@ -65,6 +74,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 	UTextBlock* Title = nullptr;
 
+	// Subtree stats column. Item blueprints without it only show titles.
+	UPROPERTY(BlueprintReadWrite, meta = (BindWidgetOptional))
+	UTextBlock* Stats_Text = nullptr;
+
 	UPROPERTY(BlueprintReadWrite)
 	double IndentationPerLevel = 32.0;
 
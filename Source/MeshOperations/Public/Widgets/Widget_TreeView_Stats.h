@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Widgets/Widget_TreeView_Data.h"
+#include "Widgets/Widget_TreeView_Index.h"
+
+/*
+* Subtree statistics of every entry of a tree view snapshot.
+* Mesh costs are read once per unique mesh on game thread. Totals are computed bottom-up one depth level at a time and each level is processed in parallel.
+* Unique mesh sets of children are merged into the largest one, so every mesh id is moved only a few times even in deep hierarchies.
+*/
+class MESHOPERATIONS_API FTreeView_Stats
+{
+
+public:
+
+	// Reads meshes of indexed components and meshes of outline nodes which are already loaded. Game thread only.
+	void Gather(const FTreeView_Index& Index);
+
+	// Only reads gathered data and the index, so it can run on any thread as long as the index isn't changed meanwhile.
+	void Compute(const FTreeView_Index& Index);
+
+	bool IsValidId(int32 EntryId) const { return this->Totals.IsValidIndex(EntryId); }
+	const FTreeViewStatsStruct& Get(int32 EntryId) const { return this->Totals[EntryId]; }
+
+	// Value which tree view sorts children by.
+	int64 GetSortValue(int32 EntryId, ETreeViewStatsSort Sort) const;
+
+private:
+
+	struct FMeshCost
+	{
+		int64 Triangles = 0;
+		int32 Sections = 0;
+		int64 Memory = 0;
+	};
+
+	TArray<FMeshCost> Meshes;
+
+	// Mesh id and instance count of every entry. Components without static mesh have INDEX_NONE.
+	TArray<int32> Entry_Meshes;
+	TArray<int32> Entry_Instances;
+
+	TArray<FTreeViewStatsStruct> Totals;
+
+};